@@ -105,6 +105,11 @@ class AHBMaster : public AHBDevice<BASE> {
     /// Generic AHB access function (blocking and non-blocking)
     virtual void ahbaccess(tlm::tlm_generic_payload * trans);
 
+    /// AHB access for temporally decoupled LT masters: delay holds the local time
+    /// of the initiator and is returned with the transfer time added instead of waiting.
+    /// Falls back to ahbaccess(trans) in AT.
+    virtual void ahbaccess(tlm::tlm_generic_payload * trans, sc_core::sc_time &delay);  // NOLINT(runtime/references)
+
     /// Generic AHB debug access function 
     virtual uint32_t ahbaccess_dbg(tlm::tlm_generic_payload * trans);
 
@@ -154,6 +159,9 @@ class AHBMaster : public AHBDevice<BASE> {
     /// Stores the number of Bytes written from the device
     sr_param<uint64_t> m_writes;  // NOLINT(runtime/int)
 
+    /// Stores the number of AHB transactions of the device
+    sr_param<uint64_t> m_transactions;  // NOLINT(runtime/int)
+
     // Indicates a TLM response error
     bool response_error;
 };
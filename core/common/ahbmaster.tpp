@@ -32,6 +32,7 @@ AHBMaster<BASE>::AHBMaster(
   m_ambaLayer(ambaLayer),
   m_reads("bytes_read", 0llu, this->m_counters),
   m_writes("bytes_written", 0llu, this->m_counters),
+  m_transactions("transactions_issued", 0llu, this->m_counters),
   response_error(false) {
   if (ambaLayer == amba::amba_AT) {
     // Register backward transport function
@@ -54,9 +55,9 @@ tlm::tlm_sync_enum AHBMaster<BASE>::nb_transport_bw(
     tlm::tlm_generic_payload &trans,  // NOLINT(runtime/references)
     tlm::tlm_phase &phase,            // NOLINT(runtime/references)
     sc_core::sc_time &delay) {        // NOLINT(runtime/references)
-  v::debug << this->name() << "nb_transport_bw received transaction " << hex << &trans << " with phase " << phase << v::endl;
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "nb_transport_bw received transaction " << hex << &trans << " with phase " << phase << v::endl;
 
-  v::debug << this->name() << "Acquire " << hex << &trans << " Ref-Count before acquire (nb_transport_bw) " << trans.get_ref_count() << v::endl;
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Acquire " << hex << &trans << " Ref-Count before acquire (nb_transport_bw) " << trans.get_ref_count() << v::endl;
   trans.acquire();
 
   if (phase == tlm::END_REQ) {
@@ -75,7 +76,7 @@ tlm::tlm_sync_enum AHBMaster<BASE>::nb_transport_bw(
     delay = data_phase_base * get_clock();
     
     // Increment reference counter
-    v::debug << this->name() << "Acquire " << hex << &trans << " Ref-Count before acquire (m_ResponsePEQ) " << trans.get_ref_count() << v::endl;
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Acquire " << hex << &trans << " Ref-Count before acquire (m_ResponsePEQ) " << trans.get_ref_count() << v::endl;
     trans.acquire();
     m_ResponsePEQ.notify(trans, delay);
     delay = SC_ZERO_TIME;
@@ -89,7 +90,7 @@ tlm::tlm_sync_enum AHBMaster<BASE>::nb_transport_bw(
   // Return arrow for msc
   msclogger::return_forward(this, &ahb, &trans, tlm::TLM_ACCEPTED, delay);
 
-  v::debug << this->name() << "Release " << hex << &trans << " Ref-Count before release (nb_transport_bw) " << trans.get_ref_count() << v::endl;
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Release " << hex << &trans << " Ref-Count before release (nb_transport_bw) " << trans.get_ref_count() << v::endl;
   trans.release();
 
   return tlm::TLM_ACCEPTED;
@@ -147,7 +148,7 @@ void AHBMaster<BASE>::ahbread(
   // Allocate new transactin (reference counter = 1)
   tlm::tlm_generic_payload *trans = ahb.get_transaction();
 
-  v::debug << this->name() << "Allocate new transaction: " << hex << trans << " Acquire / Ref-Count = " <<
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Allocate new transaction: " << hex << trans << " Acquire / Ref-Count = " <<
   trans->get_ref_count() << v::endl;
 
   // Initialize transaction
@@ -190,7 +191,7 @@ void AHBMaster<BASE>::ahbwrite(
   // Allocate new transactin (reference counter = 1)
   tlm::tlm_generic_payload *trans = ahb.get_transaction();
 
-  v::debug << this->name() << "Allocate new transaction " << hex << trans << "Acquire / Ref-Count = " <<
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Allocate new transaction " << hex << trans << "Acquire / Ref-Count = " <<
   trans->get_ref_count() << v::endl;
 
   // Initialize transaction
@@ -226,12 +227,15 @@ void AHBMaster<BASE>::ahbaccess(tlm::tlm_generic_payload *trans) {
   sc_core::sc_time delay;
 
   // Increment reference counter
-  v::debug << this->name() << "Acquire " << trans << " Ref-Count before acquire (ahbaccess) " << trans->get_ref_count() << v::endl;
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Acquire " << trans << " Ref-Count before acquire (ahbaccess) " << trans->get_ref_count() << v::endl;
   trans->acquire();
 
+  // Collect transport statistics
+  transport_statistics(*trans);
+
   if (m_ambaLayer == amba::amba_LT) {
 
-    v::debug << this->name() << "Transaction " << hex << trans << " call to b_transport" << v::endl;
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Transaction " << hex << trans << " call to b_transport" << v::endl;
     
     // Forward arrow for MSC
     msclogger::forward(this, &ahb, trans, tlm::BEGIN_REQ);
@@ -257,7 +261,7 @@ void AHBMaster<BASE>::ahbaccess(tlm::tlm_generic_payload *trans) {
     phase = tlm::BEGIN_REQ;
     // Forward arrow for MSC
     msclogger::forward(this, &ahb, trans, phase, delay);
-    v::debug << this->name() << "Transaction " << hex << trans << " call to nb_transport_fw with phase " << phase << v::endl;
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Transaction " << hex << trans << " call to nb_transport_fw with phase " << phase << v::endl;
 
     // Start non-blocking transaction
     status = ahb->nb_transport_fw(*trans, phase, delay);
@@ -280,7 +284,39 @@ void AHBMaster<BASE>::ahbaccess(tlm::tlm_generic_payload *trans) {
   }
 
   // Decrement reference counter
-  v::debug << this->name() << "Release " << trans << " Ref-Count before release (ahbaccess) " << trans->get_ref_count() << v::endl;
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Release " << trans << " Ref-Count before release (ahbaccess) " << trans->get_ref_count() << v::endl;
+  trans->release();
+}
+
+template<class BASE>
+void AHBMaster<BASE>::ahbaccess(tlm::tlm_generic_payload *trans, sc_core::sc_time &delay) {  // NOLINT(runtime/references)
+
+  if (m_ambaLayer != amba::amba_LT) {
+    ahbaccess(trans);
+    return;
+  }
+
+  // Increment reference counter
+  trans->acquire();
+
+  // Collect transport statistics
+  transport_statistics(*trans);
+
+  // Forward arrow for MSC
+  msclogger::forward(this, &ahb, trans, tlm::BEGIN_REQ);
+  // The bus annotates the transfer on top of the local time
+  ahb->b_transport(*trans, delay);
+
+  if (trans->get_response_status() != tlm::TLM_OK_RESPONSE) {
+      response_error = true;
+  }
+
+  // For read-data checking
+  if (trans->is_read()) {
+      response_callback(trans);
+  }
+
+  // Decrement reference counter
   trans->release();
 }
 
@@ -292,7 +328,7 @@ uint32_t AHBMaster<BASE>::ahbread_dbg(uint32_t addr, unsigned char *data, unsign
   // Allocate new transaction (reference counter = 1
   tlm::tlm_generic_payload *trans = ahb.get_transaction();
 
-  v::debug << this->name() << "Allocate new transaction " << hex << trans << v::endl;
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Allocate new transaction " << hex << trans << v::endl;
 
   // Initialize transaction
   trans->set_command(tlm::TLM_READ_COMMAND);
@@ -318,7 +354,7 @@ uint32_t AHBMaster<BASE>::ahbwrite_dbg(uint32_t addr, unsigned char *data, unsig
   // Allocate new transactin (reference counter = 1)
   tlm::tlm_generic_payload *trans = ahb.get_transaction();
 
-  v::debug << this->name() << "Allocate new transaction " << hex << trans << v::endl;
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "Allocate new transaction " << hex << trans << v::endl;
 
   // Initialize transaction
   trans->set_command(tlm::TLM_WRITE_COMMAND);
@@ -357,7 +393,7 @@ void AHBMaster<BASE>::ResponseThread() {
 
     // Get transaction from PEQ
     while ((trans = m_ResponsePEQ.get_next_transaction())) {
-      v::debug << name() << "Response Thread running for transaction: " << trans << v::endl;
+      V_LOG(this->m_verbosity, v::debug) << name() << "Response Thread running for transaction: " << trans << v::endl;
 
       if (trans->get_response_status() != tlm::TLM_OK_RESPONSE) {
         v::error << this->name() << "Error in Response for transaction: " << trans << v::endl;
@@ -374,7 +410,7 @@ void AHBMaster<BASE>::ResponseThread() {
       phase = tlm::END_RESP;
       delay = sc_core::SC_ZERO_TIME;
 
-      v::debug << this->name() << "Transaction " << hex << trans << " call to nb_transport_fw with phase " << phase
+      V_LOG(this->m_verbosity, v::debug) << this->name() << "Transaction " << hex << trans << " call to nb_transport_fw with phase " << phase
                << v::endl;
 
       // Forward arrow for msc
@@ -386,7 +422,7 @@ void AHBMaster<BASE>::ResponseThread() {
       // Return value must be TLM_COMPLETED or TLM_ACCEPTED
       assert((status == tlm::TLM_COMPLETED) || (status == tlm::TLM_ACCEPTED));
 
-      v::debug << name() << "Release " << trans << " Ref-Count before calling release (ResponseThread) " << trans->get_ref_count() << " Status: "
+      V_LOG(this->m_verbosity, v::debug) << name() << "Release " << trans << " Ref-Count before calling release (ResponseThread) " << trans->get_ref_count() << " Status: "
                << status << v::endl;
 
       // Decrement reference count
@@ -397,6 +433,7 @@ void AHBMaster<BASE>::ResponseThread() {
 
 template<class BASE>
 void AHBMaster<BASE>::transport_statistics(tlm::tlm_generic_payload &gp) throw() {  // NOLINT(runtime/references)
+  m_transactions++;
   if (gp.is_write()) {
     m_writes += gp.get_data_length();
   } else if (gp.is_read()) {
@@ -408,5 +445,6 @@ template<class BASE>
 void AHBMaster<BASE>::print_transport_statistics(const char *name) const throw() {
   v::report << name << " * Bytes read: " << m_reads << v::endl;
   v::report << name << " * Bytes written: " << m_writes << v::endl;
+  v::report << name << " * Transactions issued: " << m_transactions << v::endl;
 }
 /// @}
@@ -109,6 +109,9 @@ class AHBSlave : public AHBDevice<BASE> {
 
     /// Stores the number of Bytes written from the device
     sr_param<uint64_t> m_writes;  // NOLINT(runtime/int)
+
+    /// Stores the number of AHB transactions of the device
+    sr_param<uint64_t> m_transactions;  // NOLINT(runtime/int)
 };
 
 #include "core/common/ahbslave.tpp"
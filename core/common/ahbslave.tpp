@@ -42,7 +42,8 @@ AHBSlave<BASE>::AHBSlave(
   m_ResponsePEQ("ResponsePEQ"),
   busy(false),
   m_reads("bytes_read", 0llu, this->m_counters),
-  m_writes("bytes_written", 0llu, this->m_counters) {
+  m_writes("bytes_written", 0llu, this->m_counters),
+  m_transactions("transactions_served", 0llu, this->m_counters) {
   // Register transport functions to sockets
   ahb.register_b_transport(this, &AHBSlave::b_transport);
   ahb.register_transport_dbg(this, &AHBSlave::transport_dbg);
@@ -73,7 +74,7 @@ tlm::tlm_sync_enum AHBSlave<BASE>::nb_transport_fw(tlm::tlm_generic_payload &tra
   sc_core::sc_time request_delay;
   sc_core::sc_time response_delay;
 
-  v::debug << this->name() << "nb_transport_fw received transaction " << hex << &trans << " with phase: " << phase <<
+  V_LOG(this->m_verbosity, v::debug) << this->name() << "nb_transport_fw received transaction " << hex << &trans << " with phase: " << phase <<
   v::endl;
 
   if (phase == tlm::BEGIN_REQ) {
@@ -84,11 +85,11 @@ tlm::tlm_sync_enum AHBSlave<BASE>::nb_transport_fw(tlm::tlm_generic_payload &tra
       ahb.validate_extension<amba::amba_cacheable>(trans);
     }
 
-    v::debug << this->name() << "Acquire " << hex << &trans << " Ref-Count = " << trans.get_ref_count() << v::endl;
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Acquire " << hex << &trans << " Ref-Count = " << trans.get_ref_count() << v::endl;
 
     uint32_t address_cycle_base;
 
-    // v::debug << this->name() << "Delay before calling exec_func: " << delay << v::endl;
+    // V_LOG(this->m_verbosity, v::debug) << this->name() << "Delay before calling exec_func: " << delay << v::endl;
 
     // Call the functional part of the model
     // ! The functional part may not call wait !
@@ -110,12 +111,12 @@ tlm::tlm_sync_enum AHBSlave<BASE>::nb_transport_fw(tlm::tlm_generic_payload &tra
       delay = address_cycle_base * get_clock() + sc_core::sc_time(1, SC_PS);
     }
 
-    // v::debug << this->name() << "Total delay: " << delay << v::endl;
+    // V_LOG(this->m_verbosity, v::debug) << this->name() << "Total delay: " << delay << v::endl;
 
     // Calculating delay for sending END_REQ
     request_delay = delay - sc_core::sc_time(1, SC_PS);
 
-    v::debug << this->name() << "Request Delay: " << request_delay << v::endl;
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Request Delay: " << request_delay << v::endl;
 
     // Consume request_delay and forward to request thread
     m_RequestPEQ.notify(trans, request_delay);
@@ -123,7 +124,7 @@ tlm::tlm_sync_enum AHBSlave<BASE>::nb_transport_fw(tlm::tlm_generic_payload &tra
     // Calculating delay for sending BEGIN_REQ
     response_delay = (delay - (get_clock() * (address_cycle_base - 1)) - sc_core::sc_time(1, SC_PS));
 
-    v::debug << this->name() << "Response Delay: " << response_delay << v::endl;
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Response Delay: " << response_delay << v::endl;
 
     // Consume response_delay and forward to response thread
     m_ResponsePEQ.notify(trans, response_delay);
@@ -135,7 +136,7 @@ tlm::tlm_sync_enum AHBSlave<BASE>::nb_transport_fw(tlm::tlm_generic_payload &tra
     return tlm::TLM_ACCEPTED;
   } else if (phase == tlm::END_RESP) {
     msclogger::return_backward(this, &ahb, &trans, tlm::TLM_COMPLETED, delay);
-    v::debug << this->name() << "Release " << &trans << " Ref-Count before calling release " << trans.get_ref_count() <<
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Release " << &trans << " Ref-Count before calling release " << trans.get_ref_count() <<
     v::endl;
 
     // END_RESP corresponds to the end of the AHB data phase.
@@ -171,7 +172,7 @@ void AHBSlave<BASE>::requestThread() {
     phase = tlm::END_REQ;
     delay = SC_ZERO_TIME;
 
-    v::debug << this->name() << "Transaction " << hex << trans << " call to nb_transport_bw with phase " << phase <<
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Transaction " << hex << trans << " call to nb_transport_bw with phase " << phase <<
     v::endl;
 
     // Backward arrow for msc
@@ -204,7 +205,7 @@ void AHBSlave<BASE>::responseThread() {
     phase = tlm::BEGIN_RESP;
     delay = SC_ZERO_TIME;
 
-    v::debug << this->name() << "Transaction " << hex << trans << " call to nb_transport_bw with phase " << status << phase <<
+    V_LOG(this->m_verbosity, v::debug) << this->name() << "Transaction " << hex << trans << " call to nb_transport_bw with phase " << status << phase <<
     v::endl;
 
     // Backward arrow for msc
@@ -245,6 +246,7 @@ uint32_t AHBSlave<BASE>::transport_dbg(tlm::tlm_generic_payload &trans) {
 
 template<class BASE>
 void AHBSlave<BASE>::transport_statistics(tlm::tlm_generic_payload &gp) throw() {
+  m_transactions++;
   if (gp.is_write()) {
     m_writes += gp.get_data_length();
   } else if (gp.is_read()) {
@@ -256,6 +258,7 @@ template<class BASE>
 void AHBSlave<BASE>::print_transport_statistics(const char *name) const throw() {
   v::report << name << " * Bytes read: " << m_reads << v::endl;
   v::report << name << " * Bytes written: " << m_writes << v::endl;
+  v::report << name << " * Transactions served: " << m_transactions << v::endl;
 }
 
 /* vim: set expandtab noai ts=4 sw=4: */
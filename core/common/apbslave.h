@@ -49,6 +49,26 @@ class sr_register_amba_socket : public ::amba::amba_slave_socket<BUSWIDTH>, publ
       ADDR_TYPE length = gp.get_data_length();
       DATA_TYPE *data = reinterpret_cast<DATA_TYPE *>(gp.get_data_ptr());
 
+      if (length > sizeof(DATA_TYPE)) {
+        // Block of whole registers, forwarded by the APBCtrl as one transaction
+        for (ADDR_TYPE i = 0; i < length / sizeof(DATA_TYPE); i++) {
+          if (gp.is_write()) {
+            DATA_TYPE word = data[i];
+            #ifdef LITTLE_ENDIAN_BO
+            swap_Endianess(word);
+            #endif
+            m_register->bus_write(address + i * sizeof(DATA_TYPE), word);
+          } else {
+            m_register->bus_read(address + i * sizeof(DATA_TYPE), data[i]);
+            #ifdef LITTLE_ENDIAN_BO
+            swap_Endianess(data[i]);
+            #endif
+          }
+        }
+        gp.set_response_status(tlm::TLM_OK_RESPONSE);
+        return;
+      }
+
       if (gp.is_write()) {
         //*data = 0;
 
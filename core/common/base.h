@@ -14,6 +14,7 @@
 #include "core/common/systemc.h"
 #include "core/common/sr_report.h"
 #include "core/common/sr_registry.h"
+#include "core/common/verbose.h"
 
 typedef sc_core::sc_module_name ModuleName;
 typedef sc_core::sc_module DefaultBase;
@@ -46,7 +47,8 @@ class BaseModule : public BASE {
         BASE(mn),
         m_generics("generics"),
         m_counters("counters"),
-        m_power("power") {
+        m_power("power"),
+        m_verbosity(this->name()) {
       // m_api = gs::cnf::GCnf_Api::getApiInstance(self);
       DefaultBase *self = dynamic_cast<DefaultBase *>(this);
       if(self) {
@@ -79,6 +81,9 @@ class BaseModule : public BASE {
 
     /// Power counters container
     ParameterArray m_power;
+
+    /// Runtime log level of the module (see V_LOG)
+    v::Verbosity m_verbosity;
 };
 
 #endif  // COMMON_BASE_H_
@@ -0,0 +1,95 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file verbose_bench.cpp
+/// Microbenchmark of the per-access cost of disabled log statements.
+///
+/// Every loop iteration stands for one bus access of a model with a debug
+/// message. The time per iteration is reported relative to an empty loop.
+///
+///     $ build/core/common/bench/verbose_bench [iterations]
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <sys/time.h>
+#include <cstdlib>
+#include <iostream>  // NOLINT(readability/streams)
+#include <string>
+
+#include "core/common/systemc.h"
+#include "core/common/verbose.h"
+
+namespace {
+  double now() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+  }
+
+  /// Keeps the compiler from removing the loops
+  volatile uint32_t s_sink = 0;
+
+  class Model : public sc_core::sc_module {
+    public:
+      explicit Model(sc_core::sc_module_name mn) :
+        sc_core::sc_module(mn),
+        m_verbosity(name()) {
+      }
+
+      void access_plain(uint32_t addr) {
+        v::debug << name() << "Access at " << v::uint32 << addr << " time " << sc_core::sc_time_stamp() << v::endl;
+        s_sink = s_sink + addr;
+      }
+
+      void access_filtered(uint32_t addr) {
+        V_LOG(m_verbosity, v::debug) << name() << "Access at " << v::uint32 << addr << " time " <<
+          sc_core::sc_time_stamp() << v::endl;
+        s_sink = s_sink + addr;
+      }
+
+      void access_none(uint32_t addr) {
+        s_sink = s_sink + addr;
+      }
+
+      v::Verbosity m_verbosity;
+  };
+
+  template<class F>
+  double measure(Model &model, F access, uint64_t iterations) {  // NOLINT(runtime/references)
+    double start = now();
+    for (uint64_t i = 0; i < iterations; i++) {
+      (model.*access)(static_cast<uint32_t>(i));
+    }
+    return (now() - start) * 1e9 / iterations;
+  }
+}  // namespace
+
+int sc_main(int argc, char *argv[]) {
+  uint64_t iterations = argc > 1 ? strtoull(argv[1], NULL, 10) : 100000000ull;
+  Model model("model");
+  typedef void (Model::*access_t)(uint32_t);
+
+  // Debug is disabled at runtime, whatever VERBOSITY was configured
+  v::setVerbosity(4);
+  double none = measure<access_t>(model, &Model::access_none, iterations);
+  double plain = measure<access_t>(model, &Model::access_plain, iterations);
+  double filtered = measure<access_t>(model, &Model::access_filtered, iterations);
+
+  // Another module gets debug output, this one stays disabled
+  v::setVerbosity("other", 6);
+  double other = measure<access_t>(model, &Model::access_filtered, iterations);
+
+  std::cout << "Iterations:                          " << iterations << std::endl;
+  std::cout << "Empty access:                        " << none << " ns" << std::endl;
+  std::cout << "v::debug (VERBOSITY " << VERBOSITY << "):             +" << plain - none << " ns" << std::endl;
+  std::cout << "V_LOG, debug disabled:               +" << filtered - none << " ns" << std::endl;
+  std::cout << "V_LOG, debug enabled for other model: +" << other - none << " ns" << std::endl;
+  return 0;
+}
+/// @}
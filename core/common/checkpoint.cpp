@@ -0,0 +1,228 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file checkpoint.cpp
+/// Saving and restoring the state of a running simulation.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/common/checkpoint.h"
+#include "core/common/sr_report.h"
+
+namespace {
+  /// File magic and format version
+  const char s_magic[8] = {'S', 'R', 'C', 'K', 'P', 'T', '\0', '\0'};
+  const uint32_t s_version = 1;
+}  // namespace
+
+// -- CheckpointArchive -------------------------------------------------------
+
+void CheckpointArchive::put(const std::string &key, const void *data, uint32_t len) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  m_entries[m_section + "." + key].assign(bytes, bytes + len);
+}
+
+bool CheckpointArchive::get(const std::string &key, void *data, uint32_t len) const {
+  std::map<std::string, std::vector<uint8_t> >::const_iterator entry = m_entries.find(m_section + "." + key);
+  if (entry == m_entries.end() || entry->second.size() != len) {
+    return false;
+  }
+  if (len) {
+    memcpy(data, &entry->second[0], len);
+  }
+  return true;
+}
+
+bool CheckpointArchive::get(const std::string &key, std::vector<uint8_t> &data) const {
+  std::map<std::string, std::vector<uint8_t> >::const_iterator entry = m_entries.find(m_section + "." + key);
+  if (entry == m_entries.end()) {
+    return false;
+  }
+  data = entry->second;
+  return true;
+}
+
+bool CheckpointArchive::save(const std::string &filename) const {
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file) {
+    return false;
+  }
+  uint32_t count = m_entries.size();
+  file.write(s_magic, sizeof(s_magic));
+  file.write(reinterpret_cast<const char *>(&s_version), sizeof(s_version));
+  file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (std::map<std::string, std::vector<uint8_t> >::const_iterator entry = m_entries.begin();
+       entry != m_entries.end(); ++entry) {
+    uint32_t keylen = entry->first.size();
+    uint32_t len = entry->second.size();
+    file.write(reinterpret_cast<const char *>(&keylen), sizeof(keylen));
+    file.write(entry->first.data(), keylen);
+    file.write(reinterpret_cast<const char *>(&len), sizeof(len));
+    if (len) {
+      file.write(reinterpret_cast<const char *>(&entry->second[0]), len);
+    }
+  }
+  return file.good();
+}
+
+bool CheckpointArchive::load(const std::string &filename) {
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  char magic[sizeof(s_magic)];
+  uint32_t version = 0;
+  uint32_t count = 0;
+
+  m_entries.clear();
+  if (!file) {
+    return false;
+  }
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char *>(&version), sizeof(version));
+  file.read(reinterpret_cast<char *>(&count), sizeof(count));
+  if (!file || memcmp(magic, s_magic, sizeof(magic)) != 0 || version != s_version) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t keylen = 0;
+    uint32_t len = 0;
+    file.read(reinterpret_cast<char *>(&keylen), sizeof(keylen));
+    std::string key(keylen, '\0');
+    file.read(&key[0], keylen);
+    file.read(reinterpret_cast<char *>(&len), sizeof(len));
+    std::vector<uint8_t> &data = m_entries[key];
+    data.resize(len);
+    if (len) {
+      file.read(reinterpret_cast<char *>(&data[0]), len);
+    }
+    if (!file) {
+      m_entries.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+// -- Checkpointable ----------------------------------------------------------
+
+Checkpointable::Checkpointable() {
+  instances().push_back(this);
+}
+
+Checkpointable::~Checkpointable() {
+  std::vector<Checkpointable *> &list = instances();
+  list.erase(std::remove(list.begin(), list.end(), this), list.end());
+}
+
+std::string Checkpointable::checkpoint_name() const {
+  const sc_core::sc_object *obj = dynamic_cast<const sc_core::sc_object *>(this);
+  return obj ? obj->name() : "";
+}
+
+std::vector<Checkpointable *> &Checkpointable::instances() {
+  static std::vector<Checkpointable *> list;
+  return list;
+}
+
+// -- Checkpoint --------------------------------------------------------------
+
+sc_core::sc_time Checkpoint::s_time_offset = sc_core::SC_ZERO_TIME;
+
+Checkpoint::Checkpoint(sc_core::sc_module_name name) :
+  sc_core::sc_module(name),
+  g_save("save", ""),
+  g_save_at("save_at", 0),
+  g_restore("restore", "") {
+  SC_THREAD(save_trigger);
+}
+
+void Checkpoint::start_of_simulation() {
+  if (!g_restore.getValue().empty() && !restore(g_restore)) {
+    srError(name())
+      ("file", g_restore.getValue())
+      ("Could not restore checkpoint");
+  }
+}
+
+void Checkpoint::save_trigger() {
+  if (g_save.getValue().empty() || !g_save_at) {
+    return;
+  }
+  sc_core::sc_time at(static_cast<double>(g_save_at), sc_core::SC_NS);
+  if (at > s_time_offset) {
+    wait(at - s_time_offset);
+  }
+  if (!save(g_save)) {
+    srError(name())
+      ("file", g_save.getValue())
+      ("Could not write checkpoint");
+  }
+}
+
+void Checkpoint::end_of_simulation() {
+  if (!g_save.getValue().empty() && !g_save_at && !save(g_save)) {
+    srError(name())
+      ("file", g_save.getValue())
+      ("Could not write checkpoint");
+  }
+}
+
+bool Checkpoint::save(const std::string &filename) {
+  CheckpointArchive ar;
+  std::vector<Checkpointable *> &list = Checkpointable::instances();
+  uint64_t time_ps = static_cast<uint64_t>((sc_core::sc_time_stamp() + s_time_offset) / sc_core::sc_time(1, sc_core::SC_PS));
+
+  ar.set_section("simulation");
+  ar.put("time_ps", time_ps);
+  for (std::vector<Checkpointable *>::iterator obj = list.begin(); obj != list.end(); ++obj) {
+    ar.set_section((*obj)->checkpoint_name());
+    (*obj)->checkpoint_save(ar);
+  }
+  if (!ar.save(filename)) {
+    return false;
+  }
+  srInfo("checkpoint")
+    ("file", filename)
+    ("models", list.size())
+    ("time", (sc_core::sc_time_stamp() + s_time_offset).to_string())
+    ("Checkpoint written");
+  return true;
+}
+
+bool Checkpoint::restore(const std::string &filename) {
+  CheckpointArchive ar;
+  std::vector<Checkpointable *> &list = Checkpointable::instances();
+  uint64_t time_ps = 0;
+
+  if (!ar.load(filename)) {
+    return false;
+  }
+  ar.set_section("simulation");
+  ar.get("time_ps", time_ps);
+  s_time_offset = sc_core::sc_time(static_cast<double>(time_ps), sc_core::SC_PS);
+  for (std::vector<Checkpointable *>::iterator obj = list.begin(); obj != list.end(); ++obj) {
+    ar.set_section((*obj)->checkpoint_name());
+    (*obj)->checkpoint_restore(ar);
+  }
+  srInfo("checkpoint")
+    ("file", filename)
+    ("models", list.size())
+    ("time", s_time_offset.to_string())
+    ("Checkpoint restored");
+  return true;
+}
+
+sc_core::sc_time Checkpoint::time_offset() {
+  return s_time_offset;
+}
+/// @}
@@ -0,0 +1,147 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file checkpoint.h
+/// Saving and restoring the state of a running simulation.
+///
+/// Models derive from Checkpointable and put their architectural state
+/// into a CheckpointArchive. The Checkpoint module writes all registered
+/// models to a file at a given simulation time and restores them from a
+/// file before the first delta cycle of a new run.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef COMMON_CHECKPOINT_H_
+#define COMMON_CHECKPOINT_H_
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "core/common/sr_param.h"
+#include "core/common/systemc.h"
+
+/// Keyed binary blobs of a checkpoint.
+/// Keys are prefixed with the section (model name) set by the Checkpoint module,
+/// so models only use local names like "psr" or "tags".
+class CheckpointArchive {
+  public:
+    /// Select the section used to prefix all following keys
+    void set_section(const std::string &section) {
+      m_section = section;
+    }
+
+    /// Store len bytes under key
+    void put(const std::string &key, const void *data, uint32_t len);
+
+    /// Copy the blob stored under key to data.
+    /// Returns false if the key is missing or has a different length.
+    bool get(const std::string &key, void *data, uint32_t len) const;
+
+    /// Copy a blob of any length stored under key.
+    /// Returns false if the key is missing.
+    bool get(const std::string &key, std::vector<uint8_t> &data) const;  // NOLINT(runtime/references)
+
+    /// Store a plain value under key
+    template<class T>
+    void put(const std::string &key, const T &value) {
+      put(key, &value, sizeof(T));
+    }
+
+    /// Read a plain value stored under key, value is unchanged on a miss
+    template<class T>
+    bool get(const std::string &key, T &value) const {  // NOLINT(runtime/references)
+      return get(key, &value, sizeof(T));
+    }
+
+    /// Returns true if key exists in the current section
+    bool has(const std::string &key) const {
+      return m_entries.find(m_section + "." + key) != m_entries.end();
+    }
+
+    /// Write all entries to a file
+    bool save(const std::string &filename) const;
+
+    /// Replace all entries by the content of a file
+    bool load(const std::string &filename);
+
+  private:
+    std::map<std::string, std::vector<uint8_t> > m_entries;
+    std::string m_section;
+};
+
+/// Interface of models that take part in checkpoints.
+/// Instances register themselves on construction and are saved and restored
+/// in construction order. The section name defaults to the SystemC name.
+class Checkpointable {
+  public:
+    Checkpointable();
+    virtual ~Checkpointable();
+
+    /// Put the model state into the archive
+    virtual void checkpoint_save(CheckpointArchive &ar) = 0;  // NOLINT(runtime/references)
+
+    /// Take the model state from the archive.
+    /// Called at the start of simulation after all resets have been applied.
+    virtual void checkpoint_restore(const CheckpointArchive &ar) = 0;
+
+    /// Name of the archive section
+    virtual std::string checkpoint_name() const;
+
+    /// All registered models in construction order
+    static std::vector<Checkpointable *> &instances();
+};
+
+/// Drives saving and restoring checkpoints.
+///
+/// Must be instantiated after all models (and reset stimuli) of a platform,
+/// because it restores the state in its own start_of_simulation callback.
+class Checkpoint : public sc_core::sc_module {
+  public:
+    SC_HAS_PROCESS(Checkpoint);
+
+    Checkpoint(sc_core::sc_module_name name);
+
+    /// Restores from g_restore
+    void start_of_simulation();
+
+    /// Saves to g_save if no save time is given
+    void end_of_simulation();
+
+    /// Waits for the save time and writes the checkpoint
+    void save_trigger();
+
+    /// Save all registered models and the simulation time to a file
+    static bool save(const std::string &filename);
+
+    /// Restore all registered models from a file
+    static bool restore(const std::string &filename);
+
+    /// Simulation time at which the restored run was saved.
+    /// SystemC time cannot be set, so the restored run starts at zero and
+    /// the checkpointed run time is sc_time_stamp() + time_offset().
+    static sc_core::sc_time time_offset();
+
+    /// Checkpoint file to write, empty to disable saving
+    sr_param<std::string> g_save;
+
+    /// Run time (ns, including a restored offset) at which g_save is written.
+    /// Zero writes the checkpoint at the end of simulation.
+    sr_param<uint64_t> g_save_at;
+
+    /// Checkpoint file to restore at start of simulation, empty to disable
+    sr_param<std::string> g_restore;
+
+  private:
+    static sc_core::sc_time s_time_offset;
+};
+
+#endif  // COMMON_CHECKPOINT_H_
+/// @}
@@ -0,0 +1,169 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file hostquantum.cpp
+/// Runs the quanta of several initiators in parallel on host threads.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include "core/common/hostquantum.h"
+
+namespace {
+  HostQuantum *s_instance = NULL;
+}  // namespace
+
+HostQuantum &HostQuantum::instance() {
+  static HostQuantum coordinator;
+  return coordinator;
+}
+
+bool HostQuantum::in_worker() {
+  return s_instance && s_instance->m_current.get() != NULL;
+}
+
+HostQuantum::HostQuantum() :
+  m_active(0),
+  m_arrived(0),
+  m_running(0),
+  m_in_round(false),
+  m_exit(false),
+  m_current(&HostQuantum::keep_worker) {
+  s_instance = this;
+}
+
+HostQuantum::~HostQuantum() {
+  {
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    m_exit = true;
+    m_cond.notify_all();
+  }
+  for (std::vector<Worker *>::iterator w = m_workers.begin(); w != m_workers.end(); ++w) {
+    (*w)->thread->join();
+    delete (*w)->thread;
+    delete *w;
+  }
+  s_instance = NULL;
+}
+
+void HostQuantum::attach(Client *client) {
+  Worker *w = new Worker;
+  w->client = client;
+  w->arrived = false;
+  w->go = false;
+  w->thread = new boost::thread(&HostQuantum::worker_loop, this, w);
+  m_workers.push_back(w);
+  m_active++;
+}
+
+HostQuantum::Worker *HostQuantum::worker(Client *client) {
+  for (std::vector<Worker *>::iterator w = m_workers.begin(); w != m_workers.end(); ++w) {
+    if ((*w)->client == client) {
+      return *w;
+    }
+  }
+  return NULL;
+}
+
+void HostQuantum::run(Client *client) {
+  Worker *w = worker(client);
+  w->arrived = true;
+  m_arrived++;
+  if (!m_in_round && m_arrived == m_active) {
+    round();
+  }
+  // Clients arriving during a round wait for the next one
+  while (w->arrived) {
+    sc_core::wait(m_round_done);
+  }
+}
+
+void HostQuantum::leave(Client *client) {
+  m_active--;
+  if (!m_in_round && m_arrived && m_arrived == m_active) {
+    round();
+  }
+}
+
+void HostQuantum::join(Client *client) {
+  m_active++;
+}
+
+void HostQuantum::round() {
+  std::vector<Worker *> ready;
+  m_in_round = true;
+  for (std::vector<Worker *>::iterator w = m_workers.begin(); w != m_workers.end(); ++w) {
+    if ((*w)->arrived) {
+      (*w)->client->slice_begin();
+      ready.push_back(*w);
+    }
+  }
+  m_arrived -= ready.size();
+
+  {
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    m_running = ready.size();
+    for (std::vector<Worker *>::iterator w = ready.begin(); w != ready.end(); ++w) {
+      (*w)->go = true;
+    }
+    m_cond.notify_all();
+
+    // Serve the workers until all slices are done
+    while (m_running || !m_calls.empty()) {
+      if (m_calls.empty()) {
+        m_cond.wait(lock);
+        continue;
+      }
+      Call *request = m_calls.front();
+      m_calls.pop_front();
+      lock.unlock();
+      request->serve();
+      lock.lock();
+      request->m_done = true;
+      m_cond.notify_all();
+    }
+  }
+
+  for (std::vector<Worker *>::iterator w = ready.begin(); w != ready.end(); ++w) {
+    (*w)->client->slice_end();
+    (*w)->arrived = false;
+  }
+  m_in_round = false;
+  m_round_done.notify();
+}
+
+void HostQuantum::call(Call &request) {
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  request.m_done = false;
+  m_calls.push_back(&request);
+  m_cond.notify_all();
+  while (!request.m_done) {
+    m_cond.wait(lock);
+  }
+}
+
+void HostQuantum::worker_loop(Worker *w) {
+  m_current.reset(w);
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while (true) {
+    while (!w->go && !m_exit) {
+      m_cond.wait(lock);
+    }
+    if (m_exit) {
+      break;
+    }
+    lock.unlock();
+    w->client->slice_run();
+    lock.lock();
+    w->go = false;
+    m_running--;
+    m_cond.notify_all();
+  }
+  m_current.release();
+}
+/// @}
@@ -0,0 +1,152 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file hostquantum.h
+/// Runs the quanta of several initiators in parallel on host threads.
+///
+/// Every participating initiator (client) has its own host worker thread.
+/// The SystemC process of a client calls run() at each quantum boundary.
+/// The last one to arrive starts one slice per client on the workers and
+/// serves their kernel calls until all slices have ended, while the others
+/// sleep on an event. So the SystemC kernel is blocked during a quantum and
+/// simulated time only advances between quanta or inside kernel calls.
+///
+/// Inside a slice a client must not touch the SystemC kernel or other
+/// models. Everything that does (bus transactions, signals, tools) is
+/// wrapped into a HostQuantum::Call and executed by call().
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef COMMON_HOSTQUANTUM_H_
+#define COMMON_HOSTQUANTUM_H_
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <deque>
+#include <vector>
+
+#include "core/common/systemc.h"
+
+class HostQuantum {
+  public:
+    /// Participant of the parallel quanta
+    class Client {
+      public:
+        virtual ~Client() {}
+
+        /// Prepare the next slice. Called in the SystemC context while no
+        /// worker is running.
+        virtual void slice_begin() = 0;
+
+        /// Execute one slice. Called on the host worker of the client.
+        virtual void slice_run() = 0;
+
+        /// Publish the results of the slice. Called in the SystemC context
+        /// after all workers of the round have finished.
+        virtual void slice_end() = 0;
+    };
+
+    /// Work a host worker hands to the SystemC kernel
+    class Call {
+      public:
+        Call() : m_done(false) {}
+        virtual ~Call() {}
+
+        /// Executed in the SystemC context of the round leader,
+        /// may call wait().
+        virtual void serve() = 0;
+
+      private:
+        friend class HostQuantum;
+        bool m_done;
+    };
+
+    /// The coordinator of all host thread clients
+    static HostQuantum &instance();
+
+    /// Returns true if the calling thread is a host worker
+    static bool in_worker();
+
+    /// Register a client and start its worker.
+    /// The client takes part in the rounds from now on.
+    void attach(Client *client);
+
+    /// Run one slice of the client. Called from its SystemC process at a
+    /// quantum boundary, returns after the slice has been executed.
+    void run(Client *client);
+
+    /// The client stops taking part in the rounds (e.g. a halted processor)
+    void leave(Client *client);
+
+    /// The client takes part in the rounds again
+    void join(Client *client);
+
+    /// Execute a call in the SystemC context and wait for its completion.
+    /// Must be called from a host worker.
+    void call(Call &request);  // NOLINT(runtime/references)
+
+    /// Serializes atomic memory operations of the workers
+    boost::mutex &atomic_mutex() {
+      return m_atomic;
+    }
+
+    ~HostQuantum();
+
+  private:
+    HostQuantum();
+
+    struct Worker {
+      Client *client;
+      boost::thread *thread;
+      bool arrived;
+      bool go;
+    };
+
+    /// Find the worker of a client
+    Worker *worker(Client *client);
+
+    /// Execute the slices of all arrived clients
+    void round();
+
+    /// Main function of a host worker
+    void worker_loop(Worker *worker);
+
+    /// Thread local marker of the workers, never deleted by the tss
+    static void keep_worker(Worker *worker) {}
+
+    std::vector<Worker *> m_workers;
+
+    /// Number of clients taking part in the rounds
+    unsigned int m_active;
+
+    /// Number of clients waiting for the next round
+    unsigned int m_arrived;
+
+    /// Number of slices still executing in the current round
+    unsigned int m_running;
+
+    bool m_in_round;
+    bool m_exit;
+
+    /// Pending kernel calls of the workers
+    std::deque<Call *> m_calls;
+
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    boost::mutex m_atomic;
+    boost::thread_specific_ptr<Worker> m_current;
+
+    /// Notified at the end of each round
+    sc_core::sc_event m_round_done;
+};
+
+#endif  // COMMON_HOSTQUANTUM_H_
+/// @}
@@ -0,0 +1,151 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file intervalpowermonitor.cpp
+/// Power monitor sampling all components at a fixed simulated-time period.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "core/common/intervalpowermonitor.h"
+#include "core/common/verbose.h"
+
+namespace {
+  const std::string s_swi_power = ".power.swi_power";
+
+  bool ends_with(const std::string &str, const std::string &suffix) {
+    return str.size() > suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+}  // namespace
+
+IntervalPowerMonitor::IntervalPowerMonitor(sc_core::sc_module_name name) :
+  sc_core::sc_module(name),
+  g_file("file", ""),
+  g_period("period", 1000000ull) {
+  SC_THREAD(sample_thread);
+}
+
+void IntervalPowerMonitor::start_of_simulation() {
+  // The only scan of the parameter list, samples use the references
+  gs::cnf::cnf_api *mApi = gs::cnf::GCnf_Api::getApiInstance(NULL);
+  std::vector<std::string> param_list = mApi->getParamList();
+  for (std::vector<std::string>::iterator it = param_list.begin(); it != param_list.end(); ++it) {
+    if (!ends_with(*it, s_swi_power)) {
+      continue;
+    }
+    std::string model = it->substr(0, it->size() - s_swi_power.size());
+    Component c;
+    c.name = model;
+    c.swi = dynamic_cast<gs::gs_param<double> *>(mApi->getPar(*it));
+    c.sta = dynamic_cast<gs::gs_param<double> *>(mApi->getPar(model + ".power.sta_power"));
+    c.internal = dynamic_cast<gs::gs_param<double> *>(mApi->getPar(model + ".power.int_power"));
+    c.frame = dynamic_cast<gs::gs_param<sc_core::sc_time> *>(mApi->getPar(model + ".power.power_frame_starting_time"));
+    c.swi_energy = 0.0;
+    c.last_frame = c.frame ? c.frame->getValue() : sc_core::SC_ZERO_TIME;
+    c.energy = 0.0;
+    if (!c.swi) {
+      v::warn << name() << "Power output of " << model << " has an unexpected type, ignored" << v::endl;
+      continue;
+    }
+    m_components.push_back(c);
+  }
+  m_last = sc_core::sc_time_stamp();
+
+  if (!g_file.getValue().empty()) {
+    m_out.open(g_file.getValue().c_str());
+    if (!m_out) {
+      v::warn << name() << "Could not open power file " << g_file.getValue() << v::endl;
+    } else {
+      m_out << "time_ns,component,static_uW,internal_uW,switching_uW,energy_uJ" << std::endl;
+    }
+  }
+  v::info << name() << "Sampling " << m_components.size() << " components every "
+          << g_period << " ns" << v::endl;
+}
+
+void IntervalPowerMonitor::end_of_simulation() {
+  sample();
+
+  double total = 0.0;
+  v::report << name() << " ********************************************" << v::endl;
+  v::report << name() << " * Energy per component:" << v::endl;
+  v::report << name() << " * ---------------------" << v::endl;
+  for (std::vector<Component>::iterator c = m_components.begin(); c != m_components.end(); ++c) {
+    v::report << name() << " * " << c->name << ": " << std::setprecision(6) << c->energy << " uJ" << v::endl;
+    total += c->energy;
+  }
+  v::report << name() << " * Total energy: " << std::setprecision(6) << total << " uJ" << v::endl;
+  v::report << name() << " ********************************************" << v::endl;
+  if (m_out.is_open()) {
+    m_out.close();
+  }
+}
+
+void IntervalPowerMonitor::sample_thread() {
+  if (!g_period) {
+    return;
+  }
+  sc_core::sc_time period(static_cast<double>(g_period), sc_core::SC_NS);
+  while (true) {
+    wait(period);
+    sample();
+  }
+}
+
+double IntervalPowerMonitor::switching_energy(Component &c, const sc_core::sc_time &now) {  // NOLINT(runtime/references)
+  sc_core::sc_time frame = c.frame ? c.frame->getValue() : sc_core::SC_ZERO_TIME;
+  if (frame != c.last_frame) {
+    // The model started a new power frame, its counters restarted
+    c.swi_energy = 0.0;
+    c.last_frame = frame;
+  }
+  if (now <= frame) {
+    return 0.0;
+  }
+  // getValue runs the pre_read callback, the result is the average since frame start
+  return c.swi->getValue() * (now - frame).to_seconds();
+}
+
+void IntervalPowerMonitor::sample() {
+  sc_core::sc_time now = sc_core::sc_time_stamp();
+  double dt = (now - m_last).to_seconds();
+  if (dt <= 0.0) {
+    return;
+  }
+  double sta_total = 0.0;
+  double int_total = 0.0;
+  double swi_total = 0.0;
+  for (std::vector<Component>::iterator c = m_components.begin(); c != m_components.end(); ++c) {
+    double sta = c->sta ? c->sta->getValue() * 1e-6 : 0.0;  // pW -> uW
+    double internal = c->internal ? c->internal->getValue() : 0.0;
+    double swi_energy = switching_energy(*c, now);
+    double swi = (swi_energy - c->swi_energy) / dt;
+    c->swi_energy = swi_energy;
+
+    double energy = (sta + internal + swi) * dt;
+    c->energy += energy;
+    sta_total += sta;
+    int_total += internal;
+    swi_total += swi;
+    if (m_out.is_open()) {
+      m_out << static_cast<uint64_t>(now.to_seconds() * 1e9) << "," << c->name << ","
+            << sta << "," << internal << "," << swi << "," << energy << "\n";
+    }
+  }
+  if (m_out.is_open()) {
+    m_out << static_cast<uint64_t>(now.to_seconds() * 1e9) << ",total,"
+          << sta_total << "," << int_total << "," << swi_total << ","
+          << (sta_total + int_total + swi_total) * dt << std::endl;
+  }
+  m_last = now;
+}
+/// @}
@@ -0,0 +1,91 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file intervalpowermonitor.h
+/// Power monitor sampling all components at a fixed simulated-time period.
+///
+/// At start of simulation the monitor looks up the power outputs
+/// (power.sta_power, power.int_power, power.swi_power and
+/// power.power_frame_starting_time) of every component once and keeps
+/// direct references to them. Each sample reads only these parameters,
+/// so its cost grows with the number of components, not with the number
+/// of parameters in the system. The switching power of a component is the
+/// average since its power frame start, the monitor turns it back into
+/// energy and reports the difference per interval.
+///
+/// The samples are streamed as CSV to g_file, one line per component and
+/// interval plus a "total" line:
+///
+///     time_ns,component,static_uW,internal_uW,switching_uW,energy_uJ
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef COMMON_INTERVALPOWERMONITOR_H_
+#define COMMON_INTERVALPOWERMONITOR_H_
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/common/sr_param.h"
+#include "core/common/systemc.h"
+
+class IntervalPowerMonitor : public sc_core::sc_module {
+  public:
+    SC_HAS_PROCESS(IntervalPowerMonitor);
+
+    IntervalPowerMonitor(sc_core::sc_module_name name);
+
+    /// Looks up the power outputs of all components and opens g_file
+    void start_of_simulation();
+
+    /// Writes the last (partial) interval and the energy summary
+    void end_of_simulation();
+
+    /// Takes a sample every g_period
+    void sample_thread();
+
+    /// Write the energy of all components since the last sample
+    void sample();
+
+    /// CSV output file
+    sr_param<std::string> g_file;
+
+    /// Sampling period in ns
+    sr_param<uint64_t> g_period;
+
+  private:
+    struct Component {
+      std::string name;
+      /// Static power (pW)
+      gs::gs_param<double> *sta;
+      /// Internal power (uW)
+      gs::gs_param<double> *internal;
+      /// Average switching power since frame start (uW)
+      gs::gs_param<double> *swi;
+      gs::gs_param<sc_core::sc_time> *frame;
+      /// Switching energy since frame start at the last sample (uJ)
+      double swi_energy;
+      /// Frame start at the last sample
+      sc_core::sc_time last_frame;
+      /// Total energy over all intervals (uJ)
+      double energy;
+    };
+
+    /// Switching energy of a component since its frame start (uJ)
+    double switching_energy(Component &c, const sc_core::sc_time &now);  // NOLINT(runtime/references)
+
+    std::vector<Component> m_components;
+    std::ofstream m_out;
+    sc_core::sc_time m_last;
+};
+
+#endif  // COMMON_INTERVALPOWERMONITOR_H_
+/// @}
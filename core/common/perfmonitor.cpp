@@ -0,0 +1,210 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file perfmonitor.cpp
+/// Simulation performance counters of the SoCRocket Virtual Platform.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/common/perfmonitor.h"
+#include "core/common/verbose.h"
+
+namespace {
+  const std::string s_instructions = ".instruction_count";
+  const std::string s_issued = ".counters.transactions_issued";
+  const std::string s_served = ".counters.transactions_served";
+
+  bool ends_with(const std::string &str, const std::string &suffix) {
+    return str.size() > suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  double wall_seconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+  }
+
+  double cpu_seconds(const struct rusage &ru) {
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec * 1e-6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec * 1e-6;
+  }
+
+  void write_counts(std::ostream &out, const char *key,  // NOLINT(runtime/references)
+                    const std::vector<std::pair<std::string, uint64_t> > &counts) {
+    out << "  \"" << key << "\": {";
+    for (uint32_t i = 0; i < counts.size(); i++) {
+      out << (i ? ", " : "") << "\"" << counts[i].first << "\": " << counts[i].second;
+    }
+    out << "}";
+  }
+}  // namespace
+
+PerfMonitor::PerfMonitor(sc_core::sc_module_name name) :
+  sc_core::sc_module(name),
+  g_json("json", ""),
+  g_dump("dump", false),
+  m_wall("wall_seconds", 0.0),
+  m_cpu("cpu_seconds", 0.0),
+  m_instructions("instructions", 0ull),
+  m_mips("mips", 0.0),
+  m_wall_start(wall_seconds()),
+  m_cpu_start(0.0),
+  m_vcsw_start(0),
+  m_ivcsw_start(0) {
+  GC_REGISTER_TYPED_PARAM_CALLBACK(&m_wall, gs::cnf::pre_read, PerfMonitor, result_cb);
+  GC_REGISTER_TYPED_PARAM_CALLBACK(&m_cpu, gs::cnf::pre_read, PerfMonitor, result_cb);
+  GC_REGISTER_TYPED_PARAM_CALLBACK(&m_instructions, gs::cnf::pre_read, PerfMonitor, result_cb);
+  GC_REGISTER_TYPED_PARAM_CALLBACK(&m_mips, gs::cnf::pre_read, PerfMonitor, result_cb);
+  GC_REGISTER_TYPED_PARAM_CALLBACK(&g_dump, gs::cnf::post_write, PerfMonitor, dump_cb);
+}
+
+PerfMonitor::~PerfMonitor() {
+  GC_UNREGISTER_CALLBACKS();
+}
+
+void PerfMonitor::start_of_simulation() {
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  m_wall_start = wall_seconds();
+  m_cpu_start = cpu_seconds(ru);
+  m_vcsw_start = ru.ru_nvcsw;
+  m_ivcsw_start = ru.ru_nivcsw;
+}
+
+void PerfMonitor::end_of_simulation() {
+  dump();
+}
+
+void PerfMonitor::sample(Sample &s) {  // NOLINT(runtime/references)
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  s.wall = wall_seconds() - m_wall_start;
+  s.cpu = cpu_seconds(ru) - m_cpu_start;
+  s.sim = sc_core::sc_time_stamp().to_seconds();
+  s.deltas = sc_core::sc_delta_count();
+  s.vcsw = ru.ru_nvcsw - m_vcsw_start;
+  s.ivcsw = ru.ru_nivcsw - m_ivcsw_start;
+  s.instructions = 0;
+  s.cores.clear();
+  s.masters.clear();
+  s.slaves.clear();
+
+  gs::cnf::cnf_api *mApi = gs::cnf::GCnf_Api::getApiInstance(NULL);
+  std::vector<std::string> param_list = mApi->getParamList();
+  for (std::vector<std::string>::iterator it = param_list.begin(); it != param_list.end(); ++it) {
+    std::vector<std::pair<std::string, uint64_t> > *list = NULL;
+    std::string model;
+    if (ends_with(*it, s_instructions)) {
+      list = &s.cores;
+      model = it->substr(0, it->size() - s_instructions.size());
+    } else if (ends_with(*it, s_issued)) {
+      list = &s.masters;
+      model = it->substr(0, it->size() - s_issued.size());
+    } else if (ends_with(*it, s_served)) {
+      list = &s.slaves;
+      model = it->substr(0, it->size() - s_served.size());
+    } else {
+      continue;
+    }
+    uint64_t value = strtoull(mApi->getValue(*it).c_str(), NULL, 10);
+    list->push_back(std::make_pair(model, value));
+    if (list == &s.cores) {
+      s.instructions += value;
+    }
+  }
+}
+
+void PerfMonitor::print(const Sample &s) {
+  double mips = s.wall > 0.0 ? s.instructions / s.wall / 1e6 : 0.0;
+  v::report << name() << " ********************************************" << v::endl;
+  v::report << name() << " * Simulation Performance:" << v::endl;
+  v::report << name() << " * -----------------------" << v::endl;
+  v::report << name() << " * Wall-clock time: " << std::setprecision(6) << s.wall << " s" << v::endl;
+  v::report << name() << " * Host CPU time: " << std::setprecision(6) << s.cpu << " s" << v::endl;
+  v::report << name() << " * Simulated time: " << std::setprecision(6) << s.sim << " s" << v::endl;
+  v::report << name() << " * Delta cycles: " << std::dec << s.deltas << v::endl;
+  v::report << name() << " * Host context switches: " << std::dec << s.vcsw + s.ivcsw << v::endl;
+  for (uint32_t i = 0; i < s.cores.size(); i++) {
+    v::report << name() << " * Instructions " << s.cores[i].first << ": " << std::dec << s.cores[i].second << v::endl;
+  }
+  v::report << name() << " * Instructions: " << std::dec << s.instructions << v::endl;
+  v::report << name() << " * MIPS: " << std::setprecision(4) << mips << v::endl;
+  for (uint32_t i = 0; i < s.masters.size(); i++) {
+    v::report << name() << " * Master transactions " << s.masters[i].first << ": " << std::dec << s.masters[i].second << v::endl;
+  }
+  for (uint32_t i = 0; i < s.slaves.size(); i++) {
+    v::report << name() << " * Slave transactions " << s.slaves[i].first << ": " << std::dec << s.slaves[i].second << v::endl;
+  }
+  v::report << name() << " ********************************************" << v::endl;
+}
+
+void PerfMonitor::write_json(std::ostream &out, const Sample &s) {  // NOLINT(runtime/references)
+  double mips = s.wall > 0.0 ? s.instructions / s.wall / 1e6 : 0.0;
+  out << std::setprecision(9) << "{" << std::endl;
+  out << "  \"wall_seconds\": " << s.wall << "," << std::endl;
+  out << "  \"cpu_seconds\": " << s.cpu << "," << std::endl;
+  out << "  \"sim_seconds\": " << s.sim << "," << std::endl;
+  out << "  \"delta_cycles\": " << s.deltas << "," << std::endl;
+  out << "  \"context_switches\": {\"voluntary\": " << s.vcsw << ", \"involuntary\": " << s.ivcsw << "}," << std::endl;
+  out << "  \"instructions\": " << s.instructions << "," << std::endl;
+  out << "  \"mips\": " << mips << "," << std::endl;
+  write_counts(out, "cores", s.cores);
+  out << "," << std::endl;
+  write_counts(out, "ahb_masters", s.masters);
+  out << "," << std::endl;
+  write_counts(out, "ahb_slaves", s.slaves);
+  out << std::endl << "}" << std::endl;
+}
+
+void PerfMonitor::dump() {
+  Sample s;
+  sample(s);
+  print(s);
+  std::string filename = g_json;
+  if (!filename.empty()) {
+    std::ofstream file(filename.c_str(), std::ios::out | std::ios::trunc);
+    if (file) {
+      write_json(file, s);
+    } else {
+      v::warn << name() << "Could not write performance report to " << filename << v::endl;
+    }
+  }
+}
+
+gs::cnf::callback_return_type PerfMonitor::result_cb(
+    gs::gs_param_base &changed_param,  // NOLINT(runtime/references)
+    gs::cnf::callback_type reason) {
+  Sample s;
+  sample(s);
+  m_wall = s.wall;
+  m_cpu = s.cpu;
+  m_instructions = s.instructions;
+  m_mips = s.wall > 0.0 ? s.instructions / s.wall / 1e6 : 0.0;
+  return GC_RETURN_OK;
+}
+
+gs::cnf::callback_return_type PerfMonitor::dump_cb(
+    gs::gs_param_base &changed_param,  // NOLINT(runtime/references)
+    gs::cnf::callback_type reason) {
+  if (g_dump) {
+    dump();
+    g_dump = false;
+  }
+  return GC_RETURN_OK;
+}
+/// @}
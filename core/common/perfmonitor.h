@@ -0,0 +1,118 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file perfmonitor.h
+/// Simulation performance counters of the SoCRocket Virtual Platform.
+///
+/// Collects the host wall-clock and CPU time, the simulated time, the
+/// executed instructions of every core (instruction_count parameters), the
+/// AHB transactions of every master and slave (counters.transactions) and
+/// the delta cycles of the kernel. The numbers are reported at the end of
+/// simulation and can be requested at any time by reading the result
+/// parameters or writing true to the dump parameter (e.g. via USI/CCI).
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef COMMON_PERFMONITOR_H_
+#define COMMON_PERFMONITOR_H_
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "core/common/sr_param.h"
+#include "core/common/systemc.h"
+
+class PerfMonitor : public sc_core::sc_module {
+  public:
+    GC_HAS_CALLBACKS();
+    SC_HAS_PROCESS(PerfMonitor);
+
+    /// Snapshot of all counters
+    struct Sample {
+      /// Host wall-clock time since start of simulation (s)
+      double wall;
+      /// Host CPU time of the process since start of simulation (s)
+      double cpu;
+      /// Simulated time (s)
+      double sim;
+      /// SystemC delta cycles
+      uint64_t deltas;
+      /// Voluntary and involuntary host context switches
+      uint64_t vcsw;
+      uint64_t ivcsw;
+      /// Sum of all executed instructions
+      uint64_t instructions;
+      /// Executed instructions per core (name, count)
+      std::vector<std::pair<std::string, uint64_t> > cores;
+      /// Transactions per AHB master and slave (name, count)
+      std::vector<std::pair<std::string, uint64_t> > masters;
+      std::vector<std::pair<std::string, uint64_t> > slaves;
+    };
+
+    PerfMonitor(sc_core::sc_module_name name);
+    ~PerfMonitor();
+
+    /// Starts the host timers
+    void start_of_simulation();
+
+    /// Prints the report and writes g_json
+    void end_of_simulation();
+
+    /// Collect the current values of all counters
+    void sample(Sample &s);  // NOLINT(runtime/references)
+
+    /// Print a sample as statistic lines
+    void print(const Sample &s);
+
+    /// Write a sample as JSON object
+    static void write_json(std::ostream &out, const Sample &s);  // NOLINT(runtime/references)
+
+    /// Print the report and write the JSON file
+    void dump();
+
+    /// Refreshes the result parameters before they are read
+    gs::cnf::callback_return_type result_cb(
+        gs::gs_param_base &changed_param,  // NOLINT(runtime/references)
+        gs::cnf::callback_type reason);
+
+    /// Writing true dumps the report on demand
+    gs::cnf::callback_return_type dump_cb(
+        gs::gs_param_base &changed_param,  // NOLINT(runtime/references)
+        gs::cnf::callback_type reason);
+
+    /// JSON file written by dump() and at the end of simulation, empty to disable
+    sr_param<std::string> g_json;
+
+    /// Write true to dump the report at the current simulation time
+    sr_param<bool> g_dump;
+
+    /// Host wall-clock seconds (read only)
+    sr_param<double> m_wall;
+
+    /// Host CPU seconds (read only)
+    sr_param<double> m_cpu;
+
+    /// Executed instructions of all cores (read only)
+    sr_param<uint64_t> m_instructions;
+
+    /// Million simulated instructions per host second (read only)
+    sr_param<double> m_mips;
+
+  private:
+    /// Host time of start_of_simulation
+    double m_wall_start;
+    double m_cpu_start;
+    uint64_t m_vcsw_start;
+    uint64_t m_ivcsw_start;
+};
+
+#endif  // COMMON_PERFMONITOR_H_
+/// @}
@@ -0,0 +1,215 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file tracewriter.cpp
+/// Compact binary trace of instructions and memory accesses.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "core/common/tracewriter.h"
+#include "core/common/verbose.h"
+
+namespace {
+  const uint32_t s_version = 1;
+}  // namespace
+
+// -- TraceWriter::Channel ----------------------------------------------------
+
+TraceWriter::Channel::Channel(TraceWriter *writer, uint16_t id) :
+  m_writer(writer),
+  m_id(id),
+  m_block(new std::vector<TraceRecord>(s_block_records)),
+  m_fill(0) {
+}
+
+void TraceWriter::Channel::flush() {
+  if (m_fill) {
+    m_block = m_writer->submit(m_block, m_fill);
+    m_fill = 0;
+  }
+}
+
+// -- TraceWriter -------------------------------------------------------------
+
+TraceWriter &TraceWriter::instance() {
+  static TraceWriter writer;
+  return writer;
+}
+
+TraceWriter::TraceWriter() :
+  m_open(false),
+  m_stop(false),
+  m_failed(false),
+  m_file(NULL),
+  m_compress(false),
+  m_thread(NULL) {
+}
+
+TraceWriter::~TraceWriter() {
+  close();
+  for (std::vector<std::vector<TraceRecord> *>::iterator block = m_free.begin(); block != m_free.end(); ++block) {
+    delete *block;
+  }
+}
+
+bool TraceWriter::open(const std::string &filename, bool compress) {
+  if (m_open) {
+    close();
+  }
+#ifdef HAVE_ZLIB
+  m_compress = compress;
+#else
+  if (compress) {
+    v::warn << "TraceWriter" << "Built without zlib, writing " << filename << " uncompressed" << v::endl;
+  }
+  m_compress = false;
+#endif
+#ifdef HAVE_ZLIB
+  if (m_compress) {
+    // Level 1: the writer thread has to keep up with the simulation
+    m_file = gzopen(filename.c_str(), "wb1");
+  } else
+#endif
+  {
+    m_file = fopen(filename.c_str(), "wb");
+  }
+  if (!m_file) {
+    v::warn << "TraceWriter" << "Could not open trace file " << filename << v::endl;
+    return false;
+  }
+
+  TraceHeader header;
+  memcpy(header.magic, "SRTRACE", 8);
+  header.version = s_version;
+  header.record_size = sizeof(TraceRecord);
+  header.byte_order = 0x0102;
+
+  m_filename = filename;
+  m_failed = !write(&header, sizeof(header));
+  m_stop = false;
+  m_open = true;
+  m_thread = new boost::thread(&TraceWriter::writer_loop, this);
+  return !m_failed;
+}
+
+void TraceWriter::close() {
+  if (!m_open) {
+    return;
+  }
+  for (std::vector<Channel *>::iterator channel = m_channels.begin(); channel != m_channels.end(); ++channel) {
+    (*channel)->flush();
+    delete (*channel)->m_block;
+    delete *channel;
+  }
+  m_channels.clear();
+  {
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    m_stop = true;
+    m_cond.notify_all();
+  }
+  m_thread->join();
+  delete m_thread;
+  m_thread = NULL;
+
+#ifdef HAVE_ZLIB
+  if (m_compress) {
+    gzclose(static_cast<gzFile>(m_file));
+  } else
+#endif
+  {
+    fclose(static_cast<FILE *>(m_file));
+  }
+  m_file = NULL;
+  m_open = false;
+  if (m_failed) {
+    v::warn << "TraceWriter" << "Write error, trace file " << m_filename << " is incomplete" << v::endl;
+  }
+}
+
+TraceWriter::Channel *TraceWriter::channel(const std::string &name) {
+  Channel *channel = new Channel(this, m_channels.size());
+  m_channels.push_back(channel);
+
+  // Name block: a source record followed by the padded name
+  uint8_t len = name.size() < 255 ? name.size() : 255;
+  uint32_t count = 1 + (len + sizeof(TraceRecord) - 1) / sizeof(TraceRecord);
+  std::vector<TraceRecord> *block = new std::vector<TraceRecord>(count);
+  memset(&(*block)[0], 0, count * sizeof(TraceRecord));
+  (*block)[0].source = channel->m_id;
+  (*block)[0].kind = TRACE_SOURCE;
+  (*block)[0].size = len;
+  memcpy(&(*block)[1], name.data(), len);
+  delete submit(block, count);
+  return channel;
+}
+
+std::vector<TraceRecord> *TraceWriter::submit(std::vector<TraceRecord> *block, uint32_t count) {
+  std::vector<TraceRecord> *fresh = NULL;
+  block->resize(count);
+  {
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    // Backpressure: do not let the simulation run away from the disk
+    while (m_queue.size() >= s_max_queued) {
+      m_cond.wait(lock);
+    }
+    m_queue.push_back(block);
+    if (!m_free.empty()) {
+      fresh = m_free.back();
+      m_free.pop_back();
+    }
+    m_cond.notify_all();
+  }
+  if (!fresh) {
+    fresh = new std::vector<TraceRecord>();
+  }
+  fresh->resize(s_block_records);
+  return fresh;
+}
+
+void TraceWriter::writer_loop() {
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while (true) {
+    while (m_queue.empty() && !m_stop) {
+      m_cond.wait(lock);
+    }
+    if (m_queue.empty()) {
+      break;
+    }
+    std::vector<TraceRecord> *block = m_queue.front();
+    m_queue.pop_front();
+    m_cond.notify_all();
+    lock.unlock();
+
+    if (!m_failed && !write(&(*block)[0], block->size() * sizeof(TraceRecord))) {
+      m_failed = true;
+    }
+
+    lock.lock();
+    m_free.push_back(block);
+  }
+}
+
+bool TraceWriter::write(const void *data, size_t len) {
+#ifdef HAVE_ZLIB
+  if (m_compress) {
+    return gzwrite(static_cast<gzFile>(m_file), data, len) == static_cast<int>(len);
+  }
+#endif
+  return fwrite(data, 1, len, static_cast<FILE *>(m_file)) == len;
+}
+/// @}
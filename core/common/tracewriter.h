@@ -0,0 +1,162 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup common
+/// @{
+/// @file tracewriter.h
+/// Compact binary trace of instructions and memory accesses.
+///
+/// A trace file starts with a TraceHeader followed by fixed-size
+/// TraceRecords. Every producer (e.g. a core or a cache) writes into its own
+/// TraceWriter::Channel without locking. Full channel blocks are handed to a
+/// background thread which writes them to the file, compressed with zlib if
+/// requested. The records of different channels are therefore interleaved
+/// in blocks and only ordered by time within a channel.
+///
+/// A channel announces its name with a TRACE_SOURCE record whose size field
+/// holds the length of the name. The name follows in the next records,
+/// padded to whole records. core/tools/tracedump converts traces to text
+/// or CSV.
+///
+/// The data field of memory accesses holds the accessed bytes as a
+/// big-endian value, right-aligned for accesses shorter than a word. Of
+/// 8-byte accesses only the first word is kept, size still reads 8.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef COMMON_TRACEWRITER_H_
+#define COMMON_TRACEWRITER_H_
+
+#include <stdint.h>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+/// Record types of a trace
+enum TraceKind {
+  TRACE_SOURCE = 0,  ///< Channel name, addr: unused, size: name length
+  TRACE_INSTR  = 1,  ///< Executed instruction, addr: pc, data: opcode, aux: instruction id
+  TRACE_IFETCH = 2,  ///< Instruction fetch, addr: address, data: opcode, aux: asi
+  TRACE_DREAD  = 3,  ///< Data read, addr: address, data: first word, aux: asi
+  TRACE_DWRITE = 4   ///< Data write, addr: address, data: first word, aux: asi
+};
+
+/// File header of a trace
+struct TraceHeader {
+  char magic[8];        ///< "SRTRACE\0"
+  uint32_t version;     ///< Format version
+  uint16_t record_size; ///< sizeof(TraceRecord)
+  uint16_t byte_order;  ///< 0x0102 written in host byte order
+};
+
+/// One trace entry
+struct TraceRecord {
+  uint64_t time;    ///< Simulation time in resolution units (ps by default)
+  uint32_t addr;
+  uint32_t data;
+  uint16_t source;  ///< Channel id
+  uint8_t kind;     ///< TraceKind
+  uint8_t size;     ///< Access size in bytes
+  uint32_t aux;
+};
+
+class TraceWriter {
+  public:
+    /// Records of one producer, must only be used by one thread at a time
+    class Channel {
+      public:
+        /// Append a record, hands the block to the writer thread when full
+        void record(uint8_t kind, uint64_t time, uint32_t addr, uint32_t data, uint8_t size, uint32_t aux) {
+          TraceRecord &r = (*m_block)[m_fill];
+          r.time = time;
+          r.addr = addr;
+          r.data = data;
+          r.source = m_id;
+          r.kind = kind;
+          r.size = size;
+          r.aux = aux;
+          if (++m_fill == m_block->size()) {
+            flush();
+          }
+        }
+
+        /// Hand the records collected so far to the writer thread
+        void flush();
+
+      private:
+        friend class TraceWriter;
+        Channel(TraceWriter *writer, uint16_t id);
+
+        TraceWriter *m_writer;
+        uint16_t m_id;
+        std::vector<TraceRecord> *m_block;
+        uint32_t m_fill;
+    };
+
+    /// The trace file of the platform
+    static TraceWriter &instance();
+
+    /// Create the trace file and start the writer thread.
+    /// Compression needs zlib, otherwise the trace is written uncompressed.
+    bool open(const std::string &filename, bool compress = false);
+
+    /// Flush all channels, stop the writer thread and close the file.
+    /// No channel may be used concurrently.
+    void close();
+
+    /// Returns true between open() and close()
+    bool is_open() const {
+      return m_open;
+    }
+
+    /// Create a channel and write its name to the trace.
+    /// Channels live until close().
+    Channel *channel(const std::string &name);
+
+    ~TraceWriter();
+
+  private:
+    TraceWriter();
+
+    /// Queue a filled block and return an empty one
+    std::vector<TraceRecord> *submit(std::vector<TraceRecord> *block, uint32_t count);
+
+    /// Main function of the writer thread
+    void writer_loop();
+
+    /// Write raw bytes to the (compressed) file
+    bool write(const void *data, size_t len);
+
+    /// Records per block
+    static const uint32_t s_block_records = 16384;
+
+    /// Filled blocks in flight before producers wait for the writer
+    static const uint32_t s_max_queued = 16;
+
+    bool m_open;
+    bool m_stop;
+    bool m_failed;
+    std::string m_filename;
+
+    /// FILE * or gzFile
+    void *m_file;
+    bool m_compress;
+
+    std::vector<Channel *> m_channels;
+    std::deque<std::vector<TraceRecord> *> m_queue;
+    std::vector<std::vector<TraceRecord> *> m_free;
+
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    boost::thread *m_thread;
+};
+
+#endif  // COMMON_TRACEWRITER_H_
+/// @}
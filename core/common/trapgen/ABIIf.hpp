@@ -27,6 +27,7 @@
 #ifndef ABIIF_HPP
 #define ABIIF_HPP
 
+#include <string>
 #include <vector>
 
 #include <boost/circular_buffer.hpp>
@@ -92,6 +93,24 @@ class ABIIf {
     virtual unsigned char readCharMem(const regWidth &address) = 0;
     virtual void writeMem(const regWidth &address, regWidth datum) = 0;
     virtual void writeCharMem(const regWidth &address, unsigned char datum) = 0;
+    ///Reads a block of memory in target byte order; the default reads it byte
+    ///by byte, processors providing a block access to memory override it
+    virtual void readMemBlock(const regWidth &address, unsigned char *data, unsigned int length) {
+      for (unsigned int i = 0; i < length; i++) {
+        data[i] = this->readCharMem(address + i);
+      }
+    }
+    ///Writes a block of memory in target byte order
+    virtual void writeMemBlock(const regWidth &address, const unsigned char *data, unsigned int length) {
+      for (unsigned int i = 0; i < length; i++) {
+        this->writeCharMem(address + i, data[i]);
+      }
+    }
+    ///Target description sent to GDB (qXfer:features:read:target.xml);
+    ///empty if the processor does not provide one
+    virtual std::string getGDBTargetDescription() const {
+      return "";
+    }
     virtual regWidth getCodeLimit() = 0;
     virtual bool isRoutineEntry(const InstructionBase *instr) throw() = 0;
     virtual bool isRoutineExit(const InstructionBase *instr) throw() = 0;
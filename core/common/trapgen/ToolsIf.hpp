@@ -32,16 +32,18 @@
 
 namespace trap {
 ///Base class for the tools which need to interact with memory,
-///i.e. to be called for every write operation which happens in
-///memory. Note that only one tool at a time can interact
-///with memory
+///i.e. to be called for every write (notifyAddress) and read
+///(notifyRead) operation which happens in memory. Note that only
+///one tool at a time can interact with memory
 template<class addressType>
 class MemoryToolsIf {
   public:
 #ifndef NDEBUG
     virtual void notifyAddress(addressType address, unsigned int size) throw() = 0;
+    virtual void notifyRead(addressType address, unsigned int size) throw() {}
 #else
     virtual void notifyAddress(addressType address, unsigned int size) = 0;
+    virtual void notifyRead(addressType address, unsigned int size) {}
 #endif
     virtual ~MemoryToolsIf() {}
 };
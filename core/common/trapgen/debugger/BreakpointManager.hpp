@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 
+#include "core/common/trapgen/debugger/PageFilter.hpp"
 #include "core/common/vmap.h"
 
 
@@ -48,6 +49,8 @@ class BreakpointManager {
   private:
     vmap<AddressType, Breakpoint<AddressType> > breakpoints;
     typename vmap<AddressType, Breakpoint<AddressType> >::iterator lastBreak;
+    ///Checked on every issued instruction before the map
+    PageFilter filter;
   public:
     BreakpointManager() {
       this->lastBreak = this->breakpoints.end();
@@ -56,6 +59,7 @@ class BreakpointManager {
     // Eliminates all the breakpoints
     void clearAllBreaks() {
       this->breakpoints.clear();
+      this->filter.clear();
       this->lastBreak = this->breakpoints.end();
     }
 
@@ -66,6 +70,7 @@ class BreakpointManager {
       this->breakpoints[address].address = address;
       this->breakpoints[address].length = length;
       this->breakpoints[address].type = type;
+      this->filter.add(address, 1);
       this->lastBreak = this->breakpoints.end();
       return true;
     }
@@ -75,12 +80,13 @@ class BreakpointManager {
         return false;
       }
       this->breakpoints.erase(address);
+      this->filter.remove(address, 1);
       this->lastBreak = this->breakpoints.end();
       return true;
     }
 
     inline bool hasBreakpoint(AddressType address) const throw() {
-      return this->breakpoints.find(address) != this->lastBreak;
+      return this->filter.mayContain(address) && this->breakpoints.find(address) != this->lastBreak;
     }
 
     Breakpoint<AddressType>*getBreakPoint(AddressType address) throw() {
@@ -41,6 +41,7 @@
 #endif
 #endif
 
+#include <sstream>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -123,9 +124,11 @@ void trap::GDBConnectionManager::sendResponse(GDBResponse &response){
                                     pairsIter != pairsEnd; pairsIter++){
             if(pairsIter->first == "thread" || pairsIter->first == "watch" ||
             pairsIter->first == "rwatch" || pairsIter->first == "awatch" || pairsIter->first == "library"){
-                //it is a hex number representing a register and the second part
-                //represents the value of that register
-                payload += pairsIter->first + ':' + this->toHexString(pairsIter->second, response.size*2);
+                //the second part is a plain number (e.g. the watched address),
+                //it is sent most significant digit first whatever the endianess
+                std::ostringstream os;
+                os << std::hex << pairsIter->second;
+                payload += pairsIter->first + ':' + os.str();
             }
             else{
                 //it is a hex number representing a register and the second part
@@ -172,11 +175,19 @@ void trap::GDBConnectionManager::sendResponse(GDBResponse &response){
                 payload += ';' + *dataIter;
             }
         break;}
+        case GDBResponse::RAW_rsp:{
+            //The message is sent as it is (e.g. qSupported features)
+            payload = response.message;
+        break;}
+        case GDBResponse::BINARY_rsp:{
+            //Prefix (e.g. 'm' or 'l' for qXfer) followed by the escaped binary data
+            payload = response.message + this->escapeBinary(response.data);
+        break;}
         default:{
         break;}
     }
 
-    unsigned char ack = '\x0';
+    int ack = 0;
     bool retry = false;
     do{
         //Now I complete the packet with the checksum
@@ -202,7 +213,7 @@ void trap::GDBConnectionManager::sendResponse(GDBResponse &response){
             numRetries = 0;
             do{
                 ack = this->readQueueChar();
-                if(ack == '\x0'){
+                if(ack < 0){
                     std::cerr << std::endl <<  "Connection Unexpetedly closed by the GDB Debugger" << std::endl << std::endl;
                     this->killed = true;
                     return;
@@ -229,13 +240,13 @@ trap::GDBRequest trap::GDBConnectionManager::processRequest(){
     GDBRequest req;
 
     do{
-        unsigned char receivedChar = '\x0';
+        int receivedChar = 0;
         boost::system::error_code asioError;
 
         //Reading the starting character
         while((receivedChar & 0x7f) != '$'){
             receivedChar = this->readQueueChar();
-            if(receivedChar == '\x0'){
+            if(receivedChar < 0){
                 std::cerr << std::endl << "Connection Unexpetedly closed by the GDB Debugger before sending a request" << std::endl;
                 std::cerr << std::endl << "There might be a problem with your GDB client" << std::endl << std::endl;
                 std::cerr << std::endl << "Detaching from GDB and restarting simulation" << std::endl << std::endl;
@@ -252,32 +263,35 @@ trap::GDBRequest trap::GDBConnectionManager::processRequest(){
         }
 
         //Now I have to start reading the payload: I go on until # is enocuntered;
+        //the payload is kept 8 bit clean for the binary packets
         payload = "";
-        while((receivedChar & 0x7f) != '#'){
+        while(receivedChar != '#'){
             receivedChar = this->readQueueChar();
-            if(receivedChar == '\x0'){
+            if(receivedChar < 0){
                 std::cerr << std::endl << "Connection Unexpetedly closed by the GDB Debugger" << std::endl << std::endl;
                 std::cerr << std::endl << "Detaching from GDB and restarting simulation" << std::endl << std::endl;
                 req.type = GDBRequest::ERROR_req;
                 this->killed = true;
                 return req;
             }
-            if((receivedChar & 0x7f) != '#')
-                payload += (char)(receivedChar & 0x7f);
+            if(receivedChar != '#')
+                payload += (char)receivedChar;
         }
 
         //Finally I read the checksum: it should be composed of two characters
         char checkSum[2];
-        checkSum[0] = this->readQueueChar();
-        if(checkSum[0] == '\x0'){
+        receivedChar = this->readQueueChar();
+        checkSum[0] = (char)receivedChar;
+        if(receivedChar < 0){
             std::cerr << std::endl << "Connection Unexpetedly closed by the GDB Debugger" << std::endl << std::endl;
             std::cerr << std::endl << "Detaching from GDB and restarting simulation" << std::endl << std::endl;
             req.type = GDBRequest::ERROR_req;
             this->killed = true;
             return req;
         }
-        checkSum[1] = this->readQueueChar();
-        if(checkSum[1] == '\x0'){
+        receivedChar = this->readQueueChar();
+        checkSum[1] = (char)receivedChar;
+        if(receivedChar < 0){
             std::cerr << std::endl << "Connection Unexpetedly closed by the GDB Debugger" << std::endl << std::endl;
             std::cerr << std::endl << "Detaching from GDB and restarting simulation" << std::endl << std::endl;
             req.type = GDBRequest::ERROR_req;
@@ -429,6 +443,26 @@ trap::GDBRequest trap::GDBConnectionManager::processRequest(){
         break;}
         case 'q':{
             req.type = GDBRequest::q_req;
+            if(payload.compare(0, 9, "Supported") == 0){
+                req.command = "Supported";
+                break;
+            }
+            if(payload.compare(0, 5, "Xfer:") == 0){
+                //qXfer:object:read:annex:offset,length
+                std::string::size_type sepIndex = payload.find_last_of(':');
+                std::string::size_type sepIndex2 = payload.find(',', sepIndex);
+                if(sepIndex == std::string::npos || sepIndex2 == std::string::npos){
+                    req.type = GDBRequest::UNK_req;
+                    break;
+                }
+                req.command = "Xfer";
+                req.extension = payload.substr(5, sepIndex - 5);
+                std::string temp = payload.substr(sepIndex + 1, sepIndex2 - sepIndex - 1);
+                req.address = this->toIntNum(temp);
+                temp = payload.substr(sepIndex2 + 1);
+                req.length = this->toIntNum(temp);
+                break;
+            }
             std::string::size_type sepIndex = payload.find(',');
             if(sepIndex == std::string::npos){
                 req.type = GDBRequest::UNK_req;
@@ -479,26 +513,34 @@ trap::GDBRequest trap::GDBConnectionManager::processRequest(){
             req.type = GDBRequest::v_req;
             req.command = payload;
         break;}
-/*        case 'X':{
+        case 'x':{
+            //Binary memory read: same arguments as m
+            req.type = GDBRequest::x_req;
+            std::string::size_type sepIndex = payload.find(',');
+            std::string temp = payload.substr(0, sepIndex);
+            req.address = this->toIntNum(temp);
+            temp = payload.substr(sepIndex + 1);
+            req.length = this->toIntNum(temp);
+        break;}
+        case 'X':{
             req.type = GDBRequest::X_req;
             std::string::size_type sepIndex = payload.find(',');
             std::string::size_type sepIndex2 = payload.find(':');
-            if(sepIndex == std::string::npos || sepIndex2 == std::string::npos)
-                std::cerr << __PRETTY_FUNCTION__ << ": error in the M message: no arguments given" << std::endl;
+            if(sepIndex == std::string::npos || sepIndex2 == std::string::npos){
+                std::cerr << __PRETTY_FUNCTION__ << ": error in the X message: no arguments given" << std::endl;
+                req.type = GDBRequest::UNK_req;
+                break;
+            }
             std::string temp = payload.substr(0, sepIndex);
             req.address = this->toIntNum(temp);
             temp = payload.substr(sepIndex + 1, sepIndex2 - sepIndex - 1);
             req.length = this->toIntNum(temp);
-            temp = payload.substr(sepIndex2 + 1);
             //Now it is time to read the content of memory
-            std::string::iterator dataIter, dataIterEnd;
-            for(dataIter = temp.begin(), dataIterEnd = temp.end(); dataIter != dataIterEnd; dataIter++){
-                req.data.push_back(*dataIter);
-            }
+            this->unescapeBinary(payload.substr(sepIndex2 + 1), req.data);
             //Now I check that the length of the buffer is the specified one
             if(req.data.size() != req.length)
                 std::cerr << __PRETTY_FUNCTION__ << ": error in the X message: different length of bytes" << std::endl;
-        break;}*/
+        break;}
         case 'z':{
             req.type = GDBRequest::z_req;
             std::string::size_type sepIndex = payload.find(',');
@@ -538,23 +580,48 @@ trap::GDBRequest trap::GDBConnectionManager::processRequest(){
 bool trap::GDBConnectionManager::checkInterrupt(){
     unsigned char recivedChar = '\x0';
     boost::system::error_code asioError;
+    //Bytes of a packet up to the checksum are queued as they are: binary
+    //data may contain 0x03, only outside of packets it is an interrupt
+    enum {OUTSIDE, PAYLOAD, CHECKSUM1, CHECKSUM2} state = OUTSIDE;
+    bool interrupt = false;
     //Reading the starting character
     do{
         this->socket->read_some(boost::asio::buffer(&recivedChar, 1), asioError);
         if(asioError == boost::asio::error::eof){
             boost::mutex::scoped_lock lock(this->queueMutex);
-            this->recvdChars.push_back('\x0');
+            this->recvdChars.push_back(-1);
             this->emptyQueueCond.notify_all();
             this->killed = true;
             return false;
         }
-        if((recivedChar & 0x7f) != 0x03 && !this->killed){
+        switch(state){
+            case OUTSIDE:
+                if((recivedChar & 0x7f) == 0x03){
+                    interrupt = true;
+                }
+                else if(recivedChar == '$'){
+                    state = PAYLOAD;
+                }
+                break;
+            case PAYLOAD:
+                if(recivedChar == '#'){
+                    state = CHECKSUM1;
+                }
+                break;
+            case CHECKSUM1:
+                state = CHECKSUM2;
+                break;
+            default:
+                state = OUTSIDE;
+                break;
+        }
+        if(!interrupt && !this->killed){
             boost::mutex::scoped_lock lock(this->queueMutex);
             this->recvdChars.push_back(recivedChar);
             this->emptyQueueCond.notify_all();
         }
         //std::cerr << recivedChar << "- hex form -" << std::hex << std::showbase << (unsigned int)recivedChar << std::endl;
-    }while((recivedChar & 0x7f) != 0x03 && !this->killed);
+    }while(!interrupt && !this->killed);
     //std::cerr << "returned since an interrupt was encountered" << std::endl;
     if(this->killed){
         return false;
@@ -565,12 +632,12 @@ bool trap::GDBConnectionManager::checkInterrupt(){
 }
 
 ///Reads a character from the queue of ready characters
-unsigned char trap::GDBConnectionManager::readQueueChar(){
+int trap::GDBConnectionManager::readQueueChar(){
     boost::mutex::scoped_lock lock(this->queueMutex);
     while(this->recvdChars.empty()){
         this->emptyQueueCond.wait(lock);
     }
-    unsigned char recvd = this->recvdChars.front();
+    int recvd = this->recvdChars.front();
     this->recvdChars.pop_front();
     return recvd;
 }
@@ -670,6 +737,36 @@ int trap::GDBConnectionManager::chToHex(unsigned char ch){
     return -1;
 }
 
+///Escapes the characters which must not appear in the binary data
+///of a packet ('#', '$', '}' and '*')
+std::string trap::GDBConnectionManager::escapeBinary(const std::vector<char> &data){
+    std::string escaped;
+    escaped.reserve(data.size() + data.size()/8);
+    std::vector<char>::const_iterator dataIter, dataEnd;
+    for(dataIter = data.begin(), dataEnd = data.end(); dataIter != dataEnd; dataIter++){
+        if(*dataIter == '#' || *dataIter == '$' || *dataIter == '}' || *dataIter == '*'){
+            escaped += '}';
+            escaped += (char)(*dataIter ^ 0x20);
+        }
+        else
+            escaped += *dataIter;
+    }
+    return escaped;
+}
+
+///Reverts escapeBinary
+void trap::GDBConnectionManager::unescapeBinary(const std::string &data, std::vector<unsigned char> &result){
+    result.reserve(data.size());
+    for(std::string::size_type i = 0; i < data.size(); i++){
+        if(data[i] == '}' && i + 1 < data.size()){
+            i++;
+            result.push_back((unsigned char)(data[i] ^ 0x20));
+        }
+        else
+            result.push_back((unsigned char)data[i]);
+    }
+}
+
 ///Converts a hexadecimal number into the corresponding character string
 std::string trap::GDBConnectionManager::toStr(std::string &toConvert){
     //What I do is to read the string element in couples; then
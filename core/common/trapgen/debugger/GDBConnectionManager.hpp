@@ -49,7 +49,7 @@ namespace trap {
  */
 struct GDBRequest {
   enum Type {QUEST_req = 0, EXCL_req, c_req, C_req, D_req, g_req, G_req, H_req, i_req, I_req, k_req, m_req, M_req,
-             p_req, P_req, q_req, s_req, S_req, t_req, T_req, v_req, X_req, z_req, Z_req, UNK_req, ERROR_req, INTR_req};
+             p_req, P_req, q_req, s_req, S_req, t_req, T_req, v_req, x_req, X_req, z_req, Z_req, UNK_req, ERROR_req, INTR_req};
   Type type;
   unsigned int address;
   unsigned int length;
@@ -75,7 +75,7 @@ struct GDBRequest {
  */
 struct GDBResponse {
   enum Type {S_rsp = 0, T_rsp, W_rsp, X_rsp, OUTPUT_rsp, OK_rsp, ERROR_rsp, MEM_READ_rsp, REG_READ_rsp, CONT_rsp,
-             NOT_SUPPORTED_rsp};
+             NOT_SUPPORTED_rsp, RAW_rsp, BINARY_rsp};
   Type type;
   unsigned int payload;
   std::string message;
@@ -122,19 +122,26 @@ class GDBConnectionManager {
     int chToHex(unsigned char ch);
     ///Converts and integer hex to a char representing it
     unsigned char hexToInt(unsigned int num);
+    ///Escapes the characters which must not appear in the binary data
+    ///of a packet ('#', '$', '}' and '*')
+    std::string escapeBinary(const std::vector<char> &data);
+    ///Reverts escapeBinary
+    void unescapeBinary(const std::string &data, std::vector<unsigned char> &result);
     ///Map used to convert hex strings in integers
     std::map<char, unsigned int> HexMap;
     ///Specifis whether communication has been killed by the other endpoint or not
     bool killed;
-    ///List of characters received from the GDB stub
-    std::list<unsigned char> recvdChars;
+    ///List of characters received from the GDB stub; -1 signals that the
+    ///connection was closed
+    std::list<int> recvdChars;
     ///Mutex and condition variables managing access to the
     ///queue of received characters
     boost::mutex queueMutex;
     boost::condition emptyQueueCond;
 
-    ///Reads a character from the queue of ready characters
-    unsigned char readQueueChar();
+    ///Reads a character from the queue of ready characters; returns -1
+    ///if the connection was closed
+    int readQueueChar();
   public:
     GDBConnectionManager(bool endianess);
     ~GDBConnectionManager();
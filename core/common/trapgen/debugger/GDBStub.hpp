@@ -33,7 +33,6 @@
  * "set remotelogfile file" logs all the remote communication on the specified file
  */
 
-//// **** TODO:  it seeems that watchpoints are completely ignored ... :-(
 //// **** TODO:  sometimes segmentation fault when GDB is closed while the program is
 // still running; it seems there is a race condition with the GDB thread...
 
@@ -50,6 +49,8 @@
 
 #include "core/common/systemc.h"
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 #include "core/common/trapgen/utils/trap_utils.hpp"
@@ -92,6 +93,7 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
               boost::mutex::scoped_lock lk(gdbStub.cleanupMutex);
               gdbStub.breakManager.clearAllBreaks();
               gdbStub.watchManager.clearAllWatchs();
+              gdbStub.watchPending = false;
               gdbStub.step = 0;
               gdbStub.isConnected = false;
             }
@@ -117,6 +119,10 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
     Breakpoint<issueWidth> *breakReached;
     ///Keeps track of the last watchpoint encountered by this processor
     Watchpoint<issueWidth> *watchReached;
+    ///A watchpoint was hit by the current instruction; the stop is
+    ///reported when the next instruction is issued, so that GDB sees
+    ///the access completed
+    bool watchPending;
     ///Specifies whether the breakpoints are enabled or not
     bool breakEnabled;
     ///Specifies whether the watchpoints are enabled or not
@@ -191,6 +197,18 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
       return this->step == 2;
     }
 
+    ///Checks if a memory access hits a watchpoint of the matching kind;
+    ///the stop itself is deferred to the next instruction issue
+    inline void checkWatchpoint(issueWidth address, unsigned int size, bool isWrite) throw() {
+      if (this->watchEnabled && this->watchManager.hasWatchpoint(address, size)) {
+        Watchpoint<issueWidth> *watch = this->watchManager.getWatchPoint(address, size, isWrite);
+        if (watch != NULL) {
+          this->watchReached = watch;
+          this->watchPending = true;
+        }
+      }
+    }
+
     ///Starts the thread which will manage the connection with the
     ///GDB debugger
     void startThread() {
@@ -412,9 +430,13 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
         // m request: read memory
         return this->readMemory(req);
         break;
+      case GDBRequest::x_req:
+        // x request: binary read memory
+        return this->readMemoryBinary(req);
+        break;
       case GDBRequest::M_req:
-// case GDBRequest::X_req:
-        // M request: write memory
+      case GDBRequest::X_req:
+        // M request: write memory; X request: write memory, binary data
         return this->writeMemory(req);
         break;
       case GDBRequest::p_req:
@@ -567,22 +589,45 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
       return true;
     }
 
-    ///Reads the value of a memory location
-    bool readMemory(GDBRequest &req) {
-      GDBResponse rsp;
-      rsp.type = GDBResponse::MEM_READ_rsp;
-
-      for (unsigned int i = 0; i < req.length; i++) {
+    ///Reads a block of memory with a single access to the processor;
+    ///if this fails the block is read again byte by byte, so that only
+    ///the unreadable bytes are replaced by 0
+    void readMemoryBlock(unsigned int address, unsigned int length, std::vector<char> &data) {
+      data.resize(length);
+      if (length == 0) {
+        return;
+      }
+      try {
+        this->processorInstance.readMemBlock(address, reinterpret_cast<unsigned char *>(&data[0]), length);
+        return;
+      } catch (...) {
+      }
+      for (unsigned int i = 0; i < length; i++) {
         try {
-          unsigned char memContent = this->processorInstance.readCharMem(req.address + i);
-          this->valueToBytes(rsp.data, memContent);
+          data[i] = this->processorInstance.readCharMem(address + i);
         } catch (...) {
-          std::cerr << "GDB Stub: error in reading memory at address " << std::hex << std::showbase << req.address +
+          std::cerr << "GDB Stub: error in reading memory at address " << std::hex << std::showbase << address +
             i << std::endl;
-          this->valueToBytes(rsp.data, 0);
+          data[i] = 0;
         }
       }
+    }
 
+    ///Reads the value of a memory location
+    bool readMemory(GDBRequest &req) {
+      GDBResponse rsp;
+      rsp.type = GDBResponse::MEM_READ_rsp;
+      this->readMemoryBlock(req.address, req.length, rsp.data);
+      this->connManager.sendResponse(rsp);
+      return true;
+    }
+
+    ///Reads the value of a memory location, the content is sent as binary data
+    bool readMemoryBinary(GDBRequest &req) {
+      GDBResponse rsp;
+      rsp.type = GDBResponse::BINARY_rsp;
+      rsp.message = "b";
+      this->readMemoryBlock(req.address, req.length, rsp.data);
       this->connManager.sendResponse(rsp);
       return true;
     }
@@ -605,6 +650,7 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
       // First of all I have to perform some cleanup
       this->breakManager.clearAllBreaks();
       this->watchManager.clearAllWatchs();
+      this->watchPending = false;
       this->step = 0;
       this->isConnected = false;
       // Finally I can send a positive response
@@ -664,8 +710,16 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
     bool writeMemory(GDBRequest &req) {
       bool error = false;
       unsigned int bytes = 0;
+      if (!req.data.empty()) {
+        try {
+          this->processorInstance.writeMemBlock(req.address, &req.data[0], req.data.size());
+          bytes = req.data.size();
+        } catch (...) {
+          // Written again byte by byte to find the failing address
+        }
+      }
       std::vector<unsigned char>::iterator dataIter, dataEnd;
-      for (dataIter = req.data.begin(), dataEnd = req.data.end(); dataIter != dataEnd; dataIter++) {
+      for (dataIter = req.data.begin() + bytes, dataEnd = req.data.end(); dataIter != dataEnd; dataIter++) {
         try {
           this->processorInstance.writeCharMem(req.address + bytes, *dataIter);
           bytes++;
@@ -726,6 +780,7 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
       boost::mutex::scoped_lock lk(this->cleanupMutex);
       this->breakManager.clearAllBreaks();
       this->watchManager.clearAllWatchs();
+      this->watchPending = false;
       this->step = 0;
       this->isConnected = false;
       return true;
@@ -783,11 +838,47 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
       return true;
     }
 
+    ///Answers a qXfer read with the requested part of an object; only the
+    ///target description is supported
+    bool xferRead(GDBRequest &req) {
+      GDBResponse resp;
+      std::string document;
+      if (req.extension == "features:read:target.xml") {
+        document = this->processorInstance.getGDBTargetDescription();
+      }
+      if (document.empty()) {
+        resp.type = GDBResponse::NOT_SUPPORTED_rsp;
+      } else if (req.address > document.size()) {
+        resp.type = GDBResponse::ERROR_rsp;
+      } else {
+        unsigned int length = std::min<unsigned int>(req.length, document.size() - req.address);
+        resp.type = GDBResponse::BINARY_rsp;
+        // m: more data follows, l: last part
+        resp.message = (req.address + length < document.size()) ? "m" : "l";
+        resp.data.assign(document.begin() + req.address, document.begin() + req.address + length);
+      }
+      this->connManager.sendResponse(resp);
+      return true;
+    }
+
     // Note that to add additional custom commands you simply have to extend the following chain of
     // if clauses
     bool genericQuery(GDBRequest &req) {
       // I have to determine the query packet; in case it is Rcmd I deal with it
       GDBResponse resp;
+      if (req.command == "Supported") {
+        // Large packets let GDB transfer memory in few requests
+        resp.type = GDBResponse::RAW_rsp;
+        resp.message = "PacketSize=4000;binary-upload+";
+        if (!this->processorInstance.getGDBTargetDescription().empty()) {
+          resp.message += ";qXfer:features:read+";
+        }
+        this->connManager.sendResponse(resp);
+        return true;
+      }
+      if (req.command == "Xfer") {
+        return this->xferRead(req);
+      }
       if (req.command != "Rcmd") {
         resp.type = GDBResponse::NOT_SUPPORTED_rsp;
       } else {
@@ -912,6 +1003,8 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
       processorInstance(processorInstance),
       step(0),
       breakReached(NULL),
+      watchReached(NULL),
+      watchPending(false),
       breakEnabled(true),
       watchEnabled(true),
       isKilled(false),
@@ -956,6 +1049,12 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
     ///Method called at every cycle from the processor's main loop
     bool newIssue(const issueWidth &curPC, const InstructionBase *curInstr) throw() {
       if (!this->firstRun) {
+        if (this->watchPending) {
+          this->watchPending = false;
+          this->step = 0;
+          this->setStopped(WATCH_stop);
+          return false;
+        }
         this->checkStep();
         this->checkBreakpoint(curPC);
       } else {
@@ -971,7 +1070,7 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
     ///The debugger needs the pipeline to be empty only in case it is going to be stopped
     ///because, for exmple, we hitted a breakpoint or we are in step mode
     bool emptyPipeline(const issueWidth &curPC) const throw() {
-      return !this->firstRun && (this->goingToStep() || this->goingToBreak(curPC));
+      return !this->firstRun && (this->watchPending || this->goingToStep() || this->goingToBreak(curPC));
     }
 
     ///Method called whenever a particular address is written into memory
@@ -980,15 +1079,16 @@ class GDBStub : public ToolsIf<issueWidth>, public MemoryToolsIf<issueWidth>, pu
 #else
     inline void notifyAddress(issueWidth address, unsigned int size) {
 #endif
-      if (this->watchEnabled && this->watchManager.hasWatchpoint(address, size)) {
-        this->watchReached = this->watchManager.getWatchPoint(address, size);
+      this->checkWatchpoint(address, size, true);
+    }
+
+    ///Method called whenever a particular address is read from memory
 #ifndef NDEBUG
-        if (this->watchReached == NULL) {
-          THROW_EXCEPTION("I stopped because of a watchpoint, but no watchpoint was found");
-        }
+    inline void notifyRead(issueWidth address, unsigned int size) throw() {
+#else
+    inline void notifyRead(issueWidth address, unsigned int size) {
 #endif
-        this->setStopped(WATCH_stop);
-      }
+      this->checkWatchpoint(address, size, false);
     }
 };
 }
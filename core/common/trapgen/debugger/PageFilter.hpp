@@ -0,0 +1,96 @@
+/***************************************************************************\
+*
+*   This file is part of TRAP.
+*
+*   TRAP is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with this program; if not, write to the
+*   Free Software Foundation, Inc.,
+*   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*   or see <http://www.gnu.org/licenses/>.
+*
+*
+*
+*   (c) agent, 2026
+*
+\ ***************************************************************************/
+
+#ifndef PAGEFILTER_HPP
+#define PAGEFILTER_HPP
+
+#include <vector>
+
+#include "core/common/vmap.h"
+
+namespace trap {
+///Filter in front of the breakpoint and watchpoint maps: one bit per
+///4 KB page of the 32 bit address space tells whether the page contains
+///any break/watchpoint. Accesses to the other pages are rejected with a
+///single bit test; without any entry the bitmap is not even allocated.
+class PageFilter {
+  private:
+    static const unsigned int PAGE_BITS = 12;
+    ///One bit per page, allocated with the first entry
+    std::vector<unsigned int> pages;
+    ///Number of entries on each page
+    vmap<unsigned int, unsigned int> refs;
+
+    inline bool testPage(unsigned int page) const throw() {
+      return (this->pages[page >> 5] >> (page & 31)) & 1;
+    }
+  public:
+    ///Adds the address range [address, address + length)
+    void add(unsigned int address, unsigned int length) {
+      if (this->pages.empty()) {
+        this->pages.resize(1 << (32 - PAGE_BITS - 5), 0);
+      }
+      unsigned int last = (address + (length ? length - 1 : 0)) >> PAGE_BITS;
+      for (unsigned int page = address >> PAGE_BITS; page <= last; page++) {
+        if (this->refs[page]++ == 0) {
+          this->pages[page >> 5] |= 1u << (page & 31);
+        }
+      }
+    }
+
+    ///Removes a range previously added
+    void remove(unsigned int address, unsigned int length) {
+      unsigned int last = (address + (length ? length - 1 : 0)) >> PAGE_BITS;
+      for (unsigned int page = address >> PAGE_BITS; page <= last; page++) {
+        vmap<unsigned int, unsigned int>::iterator ref = this->refs.find(page);
+        if (ref != this->refs.end() && --ref->second == 0) {
+          this->refs.erase(ref);
+          this->pages[page >> 5] &= ~(1u << (page & 31));
+        }
+      }
+      if (this->refs.empty()) {
+        this->clear();
+      }
+    }
+
+    void clear() {
+      std::vector<unsigned int>().swap(this->pages);
+      this->refs.clear();
+    }
+
+    ///True if an access of size bytes at address touches a page with entries
+    inline bool mayContain(unsigned int address, unsigned int size = 1) const throw() {
+      if (this->pages.empty()) {
+        return false;
+      }
+      unsigned int first = address >> PAGE_BITS;
+      unsigned int last = (address + size - 1) >> PAGE_BITS;
+      return this->testPage(first) || (last != first && this->testPage(last));
+    }
+};
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 
+#include "core/common/trapgen/debugger/PageFilter.hpp"
 #include "core/common/vmap.h"
 
 namespace trap {
@@ -47,6 +48,8 @@ class WatchpointManager {
   private:
     vmap<AddressType, Watchpoint<AddressType> > watchpoints;
     typename vmap<AddressType, Watchpoint<AddressType> >::iterator lastWatch;
+    ///Checked on every memory access before the map
+    PageFilter filter;
   public:
     WatchpointManager() {
       this->lastWatch = this->watchpoints.end();
@@ -54,6 +57,7 @@ class WatchpointManager {
     // Eliminates all the breakpoints
     void clearAllWatchs() {
       this->watchpoints.clear();
+      this->filter.clear();
       this->lastWatch = this->watchpoints.end();
     }
     bool addWatchpoint(typename Watchpoint<AddressType>::Type type, AddressType address, unsigned int length) {
@@ -67,6 +71,7 @@ class WatchpointManager {
         this->watchpoints[address + i].length = length;
         this->watchpoints[address + i].type = type;
       }
+      this->filter.add(address, length);
       this->lastWatch = this->watchpoints.end();
       return true;
     }
@@ -80,11 +85,15 @@ class WatchpointManager {
       for (unsigned int i = 0; i < length; i++) {
         this->watchpoints.erase(address + i);
       }
+      this->filter.remove(address, length);
       this->lastWatch = this->watchpoints.end();
       return true;
     }
 
     inline bool hasWatchpoint(AddressType address, unsigned int size) const throw() {
+      if (!this->filter.mayContain(address, size)) {
+        return false;
+      }
       for (unsigned int i = 0; i < size; i++) {
         if (this->watchpoints.find(address + i) != this->lastWatch) {
           return true;
@@ -104,6 +113,21 @@ class WatchpointManager {
       return NULL;
     }
 
+    ///Returns the watchpoint hit by a read or write access, NULL if the
+    ///access touches only watchpoints of the other kind
+    Watchpoint<AddressType>*getWatchPoint(AddressType address, unsigned int size, bool isWrite) throw() {
+      for (unsigned int i = 0; i < size; i++) {
+        typename vmap<AddressType, Watchpoint<AddressType> >::iterator foundWatchPoint = this->watchpoints.find(
+          address + i);
+        if (foundWatchPoint != this->lastWatch &&
+            (foundWatchPoint->second.type == Watchpoint<AddressType>::ACCESS_watch ||
+             (foundWatchPoint->second.type == Watchpoint<AddressType>::WRITE_watch) == isWrite)) {
+          return &(foundWatchPoint->second);
+        }
+      }
+      return NULL;
+    }
+
     vmap<AddressType, Watchpoint<AddressType> >&getWatchpoints() throw() {
       return this->watchpoints;
     }
@@ -56,6 +56,7 @@ extern "C" {
 #include "core/common/trapgen/utils/trap_utils.hpp"
 
 #include "core/common/trapgen/elfloader/elfFrontend.hpp"
+#include "core/common/trapgen/elfloader/elfSegmentLoader.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -137,9 +138,13 @@ trap::ELFFrontend::ELFFrontend(std::string binaryName) : execName(binaryName){
 }
 
 trap::ELFFrontend::~ELFFrontend(){
+    if(this->programData != NULL){
+        delete [] this->programData;
+    }
 }
 
-///Reads the program instructions contained in the file
+///Reads the extent of the program contained in the file. The program
+///data itself is only loaded on request (see getProgData)
 void trap::ELFFrontend::readProgramData(){
     size_t numProgSegments = 0;
     GElf_Phdr elfProgHeader;
@@ -147,42 +152,25 @@ void trap::ELFFrontend::readProgramData(){
         THROW_ERROR("Error in retrieving the number of program headers: " << elf_errmsg ( -1));
     }
 
-    std::map<unsigned int, unsigned char> memMap;
+    bool found = false;
+    this->programData = NULL;
+    this->codeSize.first = 0;
+    this->codeSize.second = 0;
     for(size_t i = 0; i < numProgSegments; i++){
         if(gelf_getphdr(this->elf_pointer, i, &elfProgHeader) == NULL){
             THROW_ERROR("Error in retireving program header " << i);
         }
-        if(elfProgHeader.p_type == PT_LOAD){
-            //Found a standard loadable segment: I can put its content into the executable
-            //image
-            std::map<unsigned int, unsigned char>::iterator curMapPos = memMap.end();
-            if(elfProgHeader.p_filesz > 0){
-                unsigned char * fileContent = new unsigned char[elfProgHeader.p_filesz];
-                //Now I have to actually read the strean if bytes from the executable file
-                lseek(this->elfFd, elfProgHeader.p_offset, SEEK_SET);
-                if(read(this->elfFd, (void *)fileContent, elfProgHeader.p_filesz) != static_cast<int>(elfProgHeader.p_filesz)){
-                    THROW_ERROR("Error in reading the content of program section at virtual address " << std::hex << std::showbase << elfProgHeader.p_vaddr << " of size " << elfProgHeader.p_filesz << std::dec);
-                }
-                for(size_t curPos = 0; curPos < elfProgHeader.p_filesz; curPos++){
-                    curMapPos = memMap.insert(curMapPos, std::pair<unsigned int, unsigned char>(elfProgHeader.p_vaddr + curPos, fileContent[curPos]));
-                }
-                delete [] fileContent;
+        if(elfProgHeader.p_type == PT_LOAD && elfProgHeader.p_memsz > 0){
+            //Found a standard loadable segment: it extends the executable image
+            if(!found || elfProgHeader.p_vaddr < this->codeSize.second){
+                this->codeSize.second = elfProgHeader.p_vaddr;
             }
-            for(size_t curPos = elfProgHeader.p_filesz; curPos < elfProgHeader.p_memsz; curPos++){
-                curMapPos = memMap.insert(curMapPos, std::pair<unsigned int, unsigned char>(elfProgHeader.p_vaddr + curPos, 0));
+            if(!found || elfProgHeader.p_vaddr + elfProgHeader.p_memsz > this->codeSize.first){
+                this->codeSize.first = elfProgHeader.p_vaddr + elfProgHeader.p_memsz;
             }
+            found = true;
         }
     }
-    //Ok: now finally, I can take the map and convert it into the unsigned char * array representing the various
-    //bytes in memory
-    this->codeSize.second = memMap.begin()->first;
-    this->codeSize.first = memMap.rbegin()->first;
-    this->programData = new unsigned char[this->codeSize.first - this->codeSize.second];
-    std::memset(this->programData, 0, this->codeSize.first - this->codeSize.second);
-    std::map<unsigned int, unsigned char>::iterator memBeg,  memEnd;
-    for(memBeg = memMap.begin(),  memEnd = memMap.end(); memBeg != memEnd; memBeg++){
-        this->programData[memBeg->first - this->codeSize.second] = memBeg->second;
-    }
 }
 
 ///Now I have to read the symbols contained into the file, mapping them
@@ -358,5 +346,11 @@ unsigned int trap::ELFFrontend::getEntryPoint() const{
 
 ///Returns a pointer to the array contianing the program data
 unsigned char * trap::ELFFrontend::getProgData(){
+    if(this->programData == NULL){
+        //The segments are copied as whole blocks from the mapped file
+        ELFSegmentLoader loader(this->execName);
+        this->programData = new unsigned char[this->codeSize.first - this->codeSize.second];
+        loader.copyTo(this->programData);
+    }
     return this->programData;
 }
@@ -0,0 +1,164 @@
+/***************************************************************************\
+ *
+ *   This file is part of objcodeFrontend.
+ *
+ *   objcodeFrontend is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU Lesser General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This library is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU Lesser General Public License for more details.
+ *
+ *   You should have received a copy of the GNU Lesser General Public License
+ *   along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *   or see <http://www.gnu.org/licenses/>.
+ *
+ *
+ *
+ *   (c) agent, 2026
+ *
+\ ***************************************************************************/
+
+extern "C" {
+#include <gelf.h>
+}
+
+#include <cstring>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "core/common/trapgen/utils/trap_utils.hpp"
+
+#include "core/common/trapgen/elfloader/elfSegmentLoader.hpp"
+
+trap::ELFSegmentLoader::ELFSegmentLoader(std::string fileName) : execName(fileName), elfFd(-1), image(NULL), imageSize(0),
+                                entryPoint(0), binaryStart(0), binaryEnd(0){
+    if(elf_version(EV_CURRENT) == EV_NONE){
+        THROW_ERROR("Error, wrong version of the ELF library");
+    }
+    //The destructor does not run if the constructor throws, so the parser,
+    //the mapping and the file are released here
+    Elf *elf_pointer = NULL;
+    try{
+        this->elfFd = open(fileName.c_str(), O_RDONLY, 0);
+        if(this->elfFd < 0){
+            THROW_EXCEPTION("Error in opening file " << fileName);
+        }
+        struct stat fileStat;
+        if(fstat(this->elfFd, &fileStat) != 0 || fileStat.st_size == 0){
+            THROW_EXCEPTION("Error in reading the size of file " << fileName);
+        }
+        //The whole file is mapped: segment contents are used directly from the
+        //mapping, so only the pages actually loaded are read from disk
+        this->imageSize = fileStat.st_size;
+        void *mapping = mmap(NULL, this->imageSize, PROT_READ, MAP_PRIVATE, this->elfFd, 0);
+        if(mapping == MAP_FAILED){
+            THROW_EXCEPTION("Error in mapping file " << fileName);
+        }
+        this->image = static_cast<unsigned char *>(mapping);
+
+        elf_pointer = elf_memory(reinterpret_cast<char *>(this->image), this->imageSize);
+        if(elf_pointer == NULL || elf_kind(elf_pointer) != ELF_K_ELF){
+            THROW_ERROR(" File " << fileName << " is not a valid ELF type: only executable files are allowed");
+        }
+        GElf_Ehdr elfExecHeader;
+        if(gelf_getehdr(elf_pointer, &elfExecHeader) == NULL){
+            THROW_ERROR("Error in reading the executable header " << elf_errmsg ( -1));
+        }
+        if(elfExecHeader.e_type != ET_EXEC){
+            THROW_ERROR(" File " << fileName << " is not a valid ELF type: only executable files are allowed");
+        }
+        this->entryPoint = elfExecHeader.e_entry;
+
+        size_t numProgSegments = 0;
+        if(elf_getphdrnum(elf_pointer, &numProgSegments) != 0){
+            THROW_ERROR("Error in retrieving the number of program headers: " << elf_errmsg ( -1));
+        }
+        for(size_t i = 0; i < numProgSegments; i++){
+            GElf_Phdr elfProgHeader;
+            if(gelf_getphdr(elf_pointer, i, &elfProgHeader) == NULL){
+                THROW_ERROR("Error in retireving program header " << i);
+            }
+            if(elfProgHeader.p_type != PT_LOAD || elfProgHeader.p_memsz == 0){
+                continue;
+            }
+            if(elfProgHeader.p_offset + elfProgHeader.p_filesz > this->imageSize || elfProgHeader.p_filesz > elfProgHeader.p_memsz){
+                THROW_ERROR("Error in reading the content of program section at virtual address " << std::hex << std::showbase << elfProgHeader.p_vaddr << " of size " << elfProgHeader.p_filesz << std::dec);
+            }
+            Segment segment;
+            segment.address = elfProgHeader.p_vaddr;
+            segment.data = this->image + elfProgHeader.p_offset;
+            segment.fileSize = elfProgHeader.p_filesz;
+            segment.memSize = elfProgHeader.p_memsz;
+            if(this->segments.empty() || segment.address < this->binaryStart){
+                this->binaryStart = segment.address;
+            }
+            if(this->segments.empty() || segment.address + segment.memSize > this->binaryEnd){
+                this->binaryEnd = segment.address + segment.memSize;
+            }
+            this->segments.push_back(segment);
+        }
+        int elfStatus = elf_end(elf_pointer);
+        elf_pointer = NULL;
+        if(elfStatus != 0){
+            THROW_ERROR("Error in closing the elf parser --> " << elf_errmsg(-1));
+        }
+    } catch(...){
+        if(elf_pointer != NULL){
+            elf_end(elf_pointer);
+        }
+        this->release();
+        throw;
+    }
+}
+
+trap::ELFSegmentLoader::~ELFSegmentLoader(){
+    this->release();
+}
+
+void trap::ELFSegmentLoader::release(){
+    if(this->image != NULL){
+        munmap(this->image, this->imageSize);
+        this->image = NULL;
+    }
+    if(this->elfFd >= 0){
+        close(this->elfFd);
+        this->elfFd = -1;
+    }
+}
+
+const std::vector<trap::ELFSegmentLoader::Segment> & trap::ELFSegmentLoader::getSegments() const{
+    return this->segments;
+}
+
+unsigned int trap::ELFSegmentLoader::getEntryPoint() const{
+    return this->entryPoint;
+}
+
+unsigned int trap::ELFSegmentLoader::getBinaryStart() const{
+    return this->binaryStart;
+}
+
+unsigned int trap::ELFSegmentLoader::getBinaryEnd() const{
+    return this->binaryEnd;
+}
+
+void trap::ELFSegmentLoader::copyTo(unsigned char *dest) const{
+    std::memset(dest, 0, this->binaryEnd - this->binaryStart);
+    std::vector<Segment>::const_iterator segIter, segEnd;
+    for(segIter = this->segments.begin(), segEnd = this->segments.end(); segIter != segEnd; segIter++){
+        std::memcpy(dest + (segIter->address - this->binaryStart), segIter->data, segIter->fileSize);
+    }
+}
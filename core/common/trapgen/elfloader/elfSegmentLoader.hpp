@@ -0,0 +1,84 @@
+/***************************************************************************\
+*
+*   This file is part of objcodeFrontend.
+*
+*   objcodeFrontend is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU Lesser General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This library is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU Lesser General Public License for more details.
+*
+*   You should have received a copy of the GNU Lesser General Public License
+*   along with this program; if not, write to the
+*   Free Software Foundation, Inc.,
+*   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*   or see <http://www.gnu.org/licenses/>.
+*
+*
+*   (c) agent, 2026
+*
+\ ***************************************************************************/
+
+#ifndef ELFSEGMENTLOADER_HPP
+#define ELFSEGMENTLOADER_HPP
+
+#include <string>
+#include <vector>
+
+namespace trap {
+///Loads the program segments of an ELF file. The file is mapped into
+///memory and the loadable segments are handed out as whole blocks,
+///instead of being copied byte by byte into an intermediate image.
+class ELFSegmentLoader {
+  public:
+    ///A loadable segment (PT_LOAD program header)
+    struct Segment {
+        ///Start address of the segment in the target memory
+        unsigned int address;
+        ///Segment content inside the mapped file
+        const unsigned char *data;
+        ///Number of bytes taken from the file
+        unsigned int fileSize;
+        ///Size of the segment in memory; the bytes beyond
+        ///fileSize (e.g. .bss) are zero
+        unsigned int memSize;
+    };
+  private:
+    ///Name of the executable file
+    std::string execName;
+    ///file descriptor representing the open elf file
+    int elfFd;
+    ///Start and size of the mapped file
+    unsigned char *image;
+    size_t imageSize;
+    ///Loadable segments sorted as in the program header table
+    std::vector<Segment> segments;
+    unsigned int entryPoint;
+    ///Lowest and highest (exclusive) address of all loadable segments
+    unsigned int binaryStart;
+    unsigned int binaryEnd;
+    ///Unmaps and closes the file
+    void release();
+  public:
+    ELFSegmentLoader(std::string fileName);
+    ~ELFSegmentLoader();
+    ///Returns the loadable segments of the file
+    const std::vector<Segment> &getSegments() const;
+    ///Returns the entry point of the executable code
+    unsigned int getEntryPoint() const;
+    ///Returns the start address of the loadable code
+    unsigned int getBinaryStart() const;
+    ///Returns the end address of the loadable code
+    unsigned int getBinaryEnd() const;
+    ///Copies all segments into the flat array dest, which must
+    ///hold getBinaryEnd() - getBinaryStart() bytes. Gaps between
+    ///segments and the zero-initialized part are cleared.
+    void copyTo(unsigned char *dest) const;
+};
+}
+
+#endif
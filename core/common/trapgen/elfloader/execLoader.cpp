@@ -37,11 +37,12 @@ extern "C" {
 
 #include "core/common/trapgen/elfloader/elfFrontend.hpp"
 #include "core/common/trapgen/elfloader/execLoader.hpp"
+#include "core/common/trapgen/elfloader/elfSegmentLoader.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 
-trap::ExecLoader::ExecLoader(std::string fileName, bool plainFile) : plainFile(plainFile), elfFrontend(NULL), programData(NULL) {
+trap::ExecLoader::ExecLoader(std::string fileName, bool plainFile) : plainFile(plainFile), execName(fileName), elfFrontend(NULL), segmentLoader(NULL), programData(NULL) {
     if(plainFile) {
         /// Here I simply have to read the input file, putting all the bytes
         /// of its content in the programData array
@@ -58,8 +59,17 @@ trap::ExecLoader::ExecLoader(std::string fileName, bool plainFile) : plainFile(p
         this->programData = new unsigned char[progDim];
         //Now I read the whole file
         this->plainExecFile.read((char *)this->programData, progDim);
+
+        ELFSegmentLoader::Segment segment;
+        segment.address = 0;
+        segment.data = this->programData;
+        segment.fileSize = progDim;
+        segment.memSize = progDim;
+        this->plainSegments.push_back(segment);
     } else {
-        this->elfFrontend = &ELFFrontend::getInstance(fileName);
+        //Extents and entry point come from the program headers, the
+        //symbol tables are only parsed if getFrontend is called
+        this->segmentLoader = new ELFSegmentLoader(fileName);
     }
 }
 
@@ -68,23 +78,27 @@ trap::ExecLoader::~ExecLoader(){
         delete [] this->programData;
         this->programData = NULL;
     }
+    if (this->segmentLoader != NULL){
+        delete this->segmentLoader;
+        this->segmentLoader = NULL;
+    }
     if (this->plainExecFile.is_open()){
         this->plainExecFile.close();        
     }
 }
 
 unsigned int trap::ExecLoader::getProgStart(){
-    if(this->elfFrontend == NULL && !this->plainFile){
+    if(this->segmentLoader == NULL && !this->plainFile){
         THROW_ERROR("The binary parser not yet correcly created");
     }
     if(this->plainFile)
         return 0;
     else
-        return this->elfFrontend->getEntryPoint();
+        return this->segmentLoader->getEntryPoint();
 }
 
 unsigned int trap::ExecLoader::getProgDim(){
-    if(this->elfFrontend == NULL && !this->plainFile){
+    if(this->segmentLoader == NULL && !this->plainFile){
         THROW_ERROR("The binary parser not yet correcly created");
     }
     if(this->plainFile){
@@ -92,28 +106,48 @@ unsigned int trap::ExecLoader::getProgDim(){
         return plainExecFile.tellg();
     }
     else{
-        return this->elfFrontend->getBinaryEnd() - this->elfFrontend->getBinaryStart();
+        return this->segmentLoader->getBinaryEnd() - this->segmentLoader->getBinaryStart();
     }
 }
 
 unsigned char * trap::ExecLoader::getProgData(){
-    if(this->elfFrontend == NULL && !this->plainFile){
+    if(this->segmentLoader == NULL && !this->plainFile){
         THROW_ERROR("The binary parser not yet correcly created");
     }
-    if(this->plainFile){
-        return this->programData;
-    }
-    else{
-        return this->elfFrontend->getProgData();
+    if(this->programData == NULL){
+        //Flat image of the segments, only built on request
+        this->programData = new unsigned char[this->getProgDim()];
+        this->segmentLoader->copyTo(this->programData);
     }
+    return this->programData;
 }
 
 unsigned int trap::ExecLoader::getDataStart(){
-    if(this->elfFrontend == NULL && !this->plainFile){
+    if(this->segmentLoader == NULL && !this->plainFile){
         THROW_ERROR("The binary parser not yet correcly created");
     }
     if(this->plainFile)
         return 0;
     else
-        return this->elfFrontend->getBinaryStart();
+        return this->segmentLoader->getBinaryStart();
+}
+
+const std::vector<trap::ELFSegmentLoader::Segment> & trap::ExecLoader::getSegments(){
+    if(this->segmentLoader == NULL && !this->plainFile){
+        THROW_ERROR("The binary parser not yet correcly created");
+    }
+    if(this->plainFile)
+        return this->plainSegments;
+    else
+        return this->segmentLoader->getSegments();
+}
+
+trap::ELFFrontend & trap::ExecLoader::getFrontend(){
+    if(this->plainFile){
+        THROW_ERROR("A plain file has no symbols");
+    }
+    if(this->elfFrontend == NULL){
+        this->elfFrontend = &ELFFrontend::getInstance(this->execName);
+    }
+    return *this->elfFrontend;
 }
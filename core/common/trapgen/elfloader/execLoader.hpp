@@ -28,6 +28,7 @@
 #define EXECLOADER_HPP
 
 #include <string>
+#include <vector>
 
 #include <fstream>
 #include <iostream>
@@ -37,6 +38,7 @@ extern "C" {
 }
 
 #include "core/common/trapgen/elfloader/elfFrontend.hpp"
+#include "core/common/trapgen/elfloader/elfSegmentLoader.hpp"
 
 namespace trap {
 class ExecLoader {
@@ -44,8 +46,14 @@ class ExecLoader {
     ///Specifies whether a normal binary file (ELF; COFF, etc.) or a plain file (just the
     ///opcodes of the instructions) was used.
     bool plainFile;
-    ///Keeps reference to the main elf parser
+    ///Name of the executable file
+    std::string execName;
+    ///Keeps reference to the main elf parser, created on the first symbol query
     ELFFrontend *elfFrontend;
+    ///Maps the ELF file and provides its loadable segments
+    ELFSegmentLoader *segmentLoader;
+    ///The single segment of a plain file
+    std::vector<ELFSegmentLoader::Segment> plainSegments;
     ///Holds the data of the program to be executed in case it is a simply
     ///sequence of instructions (i.e. not an ELF structured file)
     unsigned char *programData;
@@ -67,6 +75,13 @@ class ExecLoader {
     unsigned int getProgDim();
     ///Returns a pointer to the array contianing the program data
     unsigned char*getProgData();
+    ///Returns the loadable segments of the program. Memories should
+    ///prefer them over getProgData: each segment can be written as one
+    ///block and its zero-initialized part cleared separately
+    const std::vector<ELFSegmentLoader::Segment> &getSegments();
+    ///Returns the ELF parser for symbol queries; it is created on
+    ///the first call, so loading alone parses the file only once
+    ELFFrontend &getFrontend();
 };
 }
 
@@ -127,6 +127,30 @@ class SparseMemoryLT : public sc_module {
     inline void write_byte_dbg(const unsigned int &address, const unsigned char &datum) throw() {
       this->mem[address] = datum;
     }
+
+    // Method used to write a whole block (e.g. a program segment) into memory;
+    // consecutive bytes are inserted next to each other without a new lookup
+    inline void write_block_dbg(const unsigned int &address, const unsigned char *data, const unsigned int &len) throw() {
+      std::map<unsigned int, unsigned char>::iterator hint = this->mem.lower_bound(address);
+      for(unsigned int i = 0; i < len; i++){
+        hint = this->mem.insert(hint, std::make_pair(address + i, data[i]));
+        hint->second = data[i];
+        ++hint;
+      }
+    }
+
+    // Method used to clear a block of memory (e.g. the .bss section); bytes,
+    // which were never written, read as zero, so they are simply dropped
+    inline void erase_dbg(const unsigned int &address, const unsigned int &len) throw() {
+      if(len == 0){
+        return;
+      }
+      std::map<unsigned int, unsigned char>::iterator end = this->mem.end();
+      if(address + len > address){
+        end = this->mem.lower_bound(address + len);
+      }
+      this->mem.erase(this->mem.lower_bound(address), end);
+    }
   private:
     const sc_time latency;
     std::map<unsigned int, unsigned char> mem;
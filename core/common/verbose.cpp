@@ -12,7 +12,11 @@
 /// @author Rolf Meyer
 ///
 
+#include <algorithm>
+#include <cstdlib>
 #include <string>
+#include <utility>
+#include <vector>
 #include "core/common/verbose.h"
 
 namespace v {
@@ -92,6 +96,117 @@ logstream<4> analysis(&logbuf);
 logstream<5> debug(&logbuf);
 logstream<99> null_log(&logbuf);
 
+template<> logstream<0, 99> unfiltered_stream<0>::stream(&logbuf);
+template<> logstream<1, 99> unfiltered_stream<1>::stream(&logbuf);
+template<> logstream<2, 99> unfiltered_stream<2>::stream(&logbuf);
+template<> logstream<3, 99> unfiltered_stream<3>::stream(&logbuf);
+template<> logstream<4, 99> unfiltered_stream<4>::stream(&logbuf);
+template<> logstream<5, 99> unfiltered_stream<5>::stream(&logbuf);
+
+namespace {
+  typedef std::vector<std::pair<std::string, int> > rules_t;
+
+  /// Module specific levels
+  rules_t &rules() {
+    static rules_t list;
+    return list;
+  }
+
+  /// Level of modules without a rule
+  int &defaultLevel() {
+    static int level = VERBOSITY;
+    return level;
+  }
+
+  /// All living Verbosity instances, updated when the rules change
+  std::vector<Verbosity *> &instances() {
+    static std::vector<Verbosity *> list;
+    return list;
+  }
+
+  /// A rule matches the module itself and everything below it
+  bool matches(const std::string &rule, const std::string &module) {
+    return module.compare(0, rule.size(), rule) == 0 &&
+           (module.size() == rule.size() || module[rule.size()] == '.');
+  }
+}  // namespace
+
+Verbosity::Verbosity(const std::string &module) :
+  m_module(module),
+  m_level(VERBOSITY) {
+  instances().push_back(this);
+  update();
+}
+
+Verbosity::~Verbosity() {
+  std::vector<Verbosity *> &list = instances();
+  list.erase(std::remove(list.begin(), list.end(), this), list.end());
+}
+
+void Verbosity::set_module(const std::string &module) {
+  m_module = module;
+  update();
+}
+
+void Verbosity::update() {
+  size_t best = 0;
+  m_level = defaultLevel();
+  for (rules_t::iterator rule = rules().begin(); rule != rules().end(); ++rule) {
+    if (rule->first.size() >= best && matches(rule->first, m_module)) {
+      best = rule->first.size();
+      m_level = rule->second;
+    }
+  }
+}
+
+void setVerbosity(const std::string &module, int level) {
+  rules_t &list = rules();
+  rules_t::iterator rule = list.begin();
+  while (rule != list.end() && rule->first != module) {
+    ++rule;
+  }
+  if (rule == list.end()) {
+    list.push_back(std::make_pair(module, level));
+  } else {
+    rule->second = level;
+  }
+  for (std::vector<Verbosity *>::iterator it = instances().begin(); it != instances().end(); ++it) {
+    (*it)->update();
+  }
+}
+
+void setVerbosity(int level) {
+  defaultLevel() = level;
+  for (std::vector<Verbosity *>::iterator it = instances().begin(); it != instances().end(); ++it) {
+    (*it)->update();
+  }
+}
+
+bool parseVerbosity(const std::string &spec) {
+  size_t pos = 0;
+  while (pos < spec.size()) {
+    size_t end = spec.find(',', pos);
+    if (end == std::string::npos) {
+      end = spec.size();
+    }
+    std::string item = spec.substr(pos, end - pos);
+    size_t eq = item.find('=');
+    std::string level = (eq == std::string::npos) ? item : item.substr(eq + 1);
+    char *tail = NULL;
+    int value = strtol(level.c_str(), &tail, 10);
+    if (level.empty() || *tail != '\0') {
+      return false;
+    }
+    if (eq == std::string::npos) {
+      setVerbosity(value);
+    } else {
+      setVerbosity(item.substr(0, eq), value);
+    }
+    pos = end + 1;
+  }
+  return true;
+}
+
 /** Linux internal consol color pattern */
 Color bgBlack("\e[40m");
 Color bgWhite("\e[47m");
@@ -26,6 +26,11 @@
 /// ~~~
 /// Defining the verbosity at configuration time has the advantage that undesired output is optimized way (compared to runtime switching).
 ///
+/// Messages in hot paths use V_LOG with the v::Verbosity of their module instead.
+/// Their level is selected per module at runtime (setVerbosity, parseVerbosity,
+/// `conf.system.verbosity` in leon3mp) and a disabled message costs one compare.
+/// core/common/bench/verbose_bench measures the overhead per access.
+///
 /// @date 2010-2015
 /// @copyright All rights reserved.
 ///            Any reproduction, use, distribution or disclosure of this
@@ -42,6 +47,7 @@
 #include <iomanip>
 #include <iostream>  // NOLINT(readability/streams)
 #include <streambuf>
+#include <string>
 
 #include "core/common/common.h"
 #include "core/common/systemc.h"
@@ -140,9 +146,15 @@ extern Number uintptr;
 #endif
 #endif
 
+/// Levels above V_MAXVERBOSITY are removed from V_LOG and V_IF at compile time.
+/// By default all levels can be enabled at runtime.
+#ifndef V_MAXVERBOSITY
+#define V_MAXVERBOSITY 99
+#endif
+
 /// Message stream.
 /// This stream is used for output messages
-template<int level>
+template<int level, int ceiling = VERBOSITY>
 class msgstream {
   public:
     explicit msgstream(std::streambuf *sb) :
@@ -151,14 +163,14 @@ class msgstream {
 
     template<class T>
     inline msgstream &operator<<(const T &in) {
-      if (level < VERBOSITY) {
+      if (level < ceiling) {
         m_stream << in;
       }
       return *this;
     }
 
     inline msgstream &operator<<(std::ostream & (*in)(std::ostream &)) {
-      if (level < VERBOSITY) {
+      if (level < ceiling) {
         m_stream << in;
       }
       return *this;
@@ -169,7 +181,7 @@ class msgstream {
 
 /// This stream is used for an output line.
 /// It defines the Header of a line and returns a msgstream for the message itself.
-template<int level>
+template<int level, int ceiling = VERBOSITY>
 class logstream {
   public:
     explicit logstream(std::streambuf *sb) :
@@ -177,8 +189,8 @@ class logstream {
     }
 
     template<class T>
-    inline msgstream<level> &operator<<(const T &in) {
-      if (level < VERBOSITY) {
+    inline msgstream<level, ceiling> &operator<<(const T &in) {
+      if (level < ceiling) {
         m_stream << "@" << sc_core::sc_time_stamp().to_string().c_str()
                  << " /" << std::dec
                  << (unsigned)sc_core::sc_delta_count() << " ("
@@ -215,11 +227,11 @@ class logstream {
        }*/
 
     operator bool() const {
-      return level < VERBOSITY;
+      return level < ceiling;
     }
 
   private:
-    msgstream<level> m_stream;
+    msgstream<level, ceiling> m_stream;
 };
 
 extern logstream<0> error;
@@ -230,6 +242,85 @@ extern logstream<4> analysis;
 extern logstream<5> debug;
 extern logstream<99> null_log;
 
+/// Runtime verbosity of one module.
+///
+/// The level is looked up from the rules given to setVerbosity() and cached,
+/// so a disabled message costs a single compare. Use it with V_LOG or V_IF:
+///
+/// ~~~{.cpp}
+/// V_LOG(m_verbosity, v::debug) << name() << "Access " << v::uint32 << addr << v::endl;
+/// V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("Access");
+/// ~~~
+///
+/// Neither the message nor its arguments are evaluated if the level is
+/// disabled for the module. V_LOG prints independent of the compile-time
+/// VERBOSITY, V_MAXVERBOSITY removes the statements completely.
+class Verbosity {
+  public:
+    /// @param module Hierarchical name of the module the rules are matched against
+    explicit Verbosity(const std::string &module = "");
+    ~Verbosity();
+
+    /// Change the module name and look up its level again
+    void set_module(const std::string &module);
+
+    /// Returns true if messages of the level are printed for this module
+    bool enabled(int level) const {
+      return level < m_level;
+    }
+
+    /// The cached level, messages below it are printed
+    int level() const {
+      return m_level;
+    }
+
+  private:
+    friend void setVerbosity(const std::string &module, int level);
+    friend void setVerbosity(int level);
+
+    /// Look up the level of the module in the rules
+    void update();
+
+    std::string m_module;
+    int m_level;
+};
+
+/// Set the runtime level of a module and all modules below it in the hierarchy.
+/// The most specific rule wins. Messages with a level below it are printed.
+void setVerbosity(const std::string &module, int level);
+
+/// Set the runtime level of all modules without a specific rule
+/// (the default is VERBOSITY)
+void setVerbosity(int level);
+
+/// Apply a rule list like "4" or "3,leon3_0=5,ahbctrl.arbiter=6".
+/// Returns false on a syntax error.
+bool parseVerbosity(const std::string &rules);
+
+/// Level of a stream
+template<int level, int ceiling>
+inline int streamLevel(const logstream<level, ceiling> &) {
+  return level;
+}
+
+/// Streams without compile-time filter used by V_LOG
+template<int level>
+struct unfiltered_stream {
+  static logstream<level, 99> stream;
+};
+
+template<> logstream<0, 99> unfiltered_stream<0>::stream;
+template<> logstream<1, 99> unfiltered_stream<1>::stream;
+template<> logstream<2, 99> unfiltered_stream<2>::stream;
+template<> logstream<3, 99> unfiltered_stream<3>::stream;
+template<> logstream<4, 99> unfiltered_stream<4>::stream;
+template<> logstream<5, 99> unfiltered_stream<5>::stream;
+
+template<int level, int ceiling>
+inline logstream<level, 99> &unfiltered(const logstream<level, ceiling> &) {
+  return unfiltered_stream<level>::stream;
+}
+
 /// This function can be used if you wish to log all verbose output in a file.
 /// The logfile gets filled with data in parallel to the screen output.
 /// If you want to end the logging to a file simply call the function with NULL as parameter.
@@ -245,5 +336,17 @@ void logFile(const char *filename);
 void logApplication(const char *name);
 }  // namespace v
 
+/// True if the stream level is enabled for a v::Verbosity
+#define V_ENABLED(verbosity, stream) \
+  (::v::streamLevel(stream) < V_MAXVERBOSITY && (verbosity).enabled(::v::streamLevel(stream)))
+
+/// Execute the following statement only if the stream level is enabled
+#define V_IF(verbosity, stream) \
+  if (!V_ENABLED(verbosity, stream)) {} else  // NOLINT(readability/braces)
+
+/// Log to a stream if its level is enabled for a v::Verbosity
+#define V_LOG(verbosity, stream) \
+  V_IF(verbosity, stream) ::v::unfiltered(stream)
+
 #endif  // COMMON_VERBOSE_H_
 /// @}
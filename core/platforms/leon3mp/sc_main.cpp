@@ -30,8 +30,13 @@
 #include <stdexcept>
 
 #include "core/common/verbose.h"
+#include "core/common/checkpoint.h"
+#include "core/common/perfmonitor.h"
+#include "core/common/tracewriter.h"
+#include "core/common/intervalpowermonitor.h"
 #include "gaisler/leon3/leon3.h"
 #include "gaisler/ahbin/ahbin.h"
+#include "gaisler/ahbdma/ahbdma.h"
 #include "gaisler/memory/memory.h"
 #include "gaisler/apbctrl/apbctrl.h"
 #include "gaisler/ahbmem/ahbmem.h"
@@ -41,6 +46,7 @@
 #include "gaisler/apbuart/apbuart.h"
 #include "gaisler/apbuart/tcpio.h"
 #include "gaisler/apbuart/reportio.h"
+#include "gaisler/apbuart/consoleio.h"
 #include "gaisler/irqmp/irqmp.h"
 #include "gaisler/ahbctrl/ahbctrl.h"
 #include "gaisler/ahbprof/ahbprof.h"
@@ -127,8 +133,10 @@ int sc_main(int argc, char** argv) {
 
     SR_INCLUDE_MODULE(ArrayStorage);
     SR_INCLUDE_MODULE(MapStorage);
+    SR_INCLUDE_MODULE(PagedStorage);
     SR_INCLUDE_MODULE(ReportIO);
     SR_INCLUDE_MODULE(TcpIO);
+    SR_INCLUDE_MODULE(ConsoleIO);
 
 
 #ifdef HAVE_USI
@@ -177,10 +185,24 @@ int sc_main(int argc, char** argv) {
     gs::gs_param<unsigned int> p_system_clock("clk", 10.0, p_system);
     gs::gs_param<std::string> p_system_osemu("osemu", "", p_system);
     gs::gs_param<std::string> p_system_log("log", "", p_system);
+    // Runtime log levels, e.g. "4" or "3,leon3_0=6,ahbctrl=6" (see v::parseVerbosity)
+    gs::gs_param<std::string> p_system_verbosity("verbosity", "", p_system);
+    if(!v::parseVerbosity(p_system_verbosity.getValue())) {
+      v::warn << "main" << "Invalid verbosity rules: " << p_system_verbosity.getValue() << v::endl;
+    }
+    // Run each processor on its own host thread (quantum in ns)
+    gs::gs_param<bool> p_system_parallel("parallel", false, p_system);
+    gs::gs_param<unsigned int> p_system_quantum("quantum", 10000, p_system);
 
     gs::gs_param_array p_report("report", p_conf);
     gs::gs_param<bool> p_report_timing("timing", true, p_report);
     gs::gs_param<bool> p_report_power("power", true, p_report);
+    // Power per interval (ns, 0: off) streamed as CSV to power_file
+    gs::gs_param<uint64_t> p_report_power_interval("power_interval", 0ull, p_report);
+    gs::gs_param<std::string> p_report_power_file("power_file", "", p_report);
+    // Simulation performance report, JSON file name (empty: log only)
+    gs::gs_param<bool> p_report_perf("perf", true, p_report);
+    gs::gs_param<std::string> p_report_perf_json("perf_json", "", p_report);
 /*
     if(!((std::string)p_system_log).empty()) {
         v::logApplication((char *)((std::string)p_system_log).c_str());
@@ -295,11 +317,13 @@ int sc_main(int argc, char** argv) {
     gs::gs_param<unsigned int> p_mctrl_prom_banks("banks", 2, p_mctrl_prom);
     gs::gs_param<unsigned int> p_mctrl_prom_bsize("bsize", 2, p_mctrl_prom);
     gs::gs_param<unsigned int> p_mctrl_prom_width("width", 32, p_mctrl_prom);
+    gs::gs_param<std::string> p_mctrl_prom_storage("storage", "ArrayStorage", p_mctrl_prom);
     gs::gs_param<unsigned int> p_mctrl_io_addr("addr", 0x200, p_mctrl_io);
     gs::gs_param<unsigned int> p_mctrl_io_mask("mask", 0xE00, p_mctrl_io);
     gs::gs_param<unsigned int> p_mctrl_io_banks("banks", 1, p_mctrl_io);
     gs::gs_param<unsigned int> p_mctrl_io_bsize("bsize", 512, p_mctrl_io);
     gs::gs_param<unsigned int> p_mctrl_io_width("width", 32, p_mctrl_io);
+    gs::gs_param<std::string> p_mctrl_io_storage("storage", "PagedStorage", p_mctrl_io);
     gs::gs_param<unsigned int> p_mctrl_ram_addr("addr", 0x400, p_mctrl_ram);
     gs::gs_param<unsigned int> p_mctrl_ram_mask("mask", 0xC00, p_mctrl_ram);
     gs::gs_param<bool> p_mctrl_ram_wprot("wprot", false, p_mctrl_ram);
@@ -307,10 +331,12 @@ int sc_main(int argc, char** argv) {
     gs::gs_param<unsigned int> p_mctrl_ram_sram_banks("banks", 4, p_mctrl_ram_sram);
     gs::gs_param<unsigned int> p_mctrl_ram_sram_bsize("bsize", 128, p_mctrl_ram_sram);
     gs::gs_param<unsigned int> p_mctrl_ram_sram_width("width", 32, p_mctrl_ram_sram);
+    gs::gs_param<std::string> p_mctrl_ram_sram_storage("storage", "PagedStorage", p_mctrl_ram_sram);
     gs::gs_param<unsigned int> p_mctrl_ram_sdram_banks("banks", 2, p_mctrl_ram_sdram);
     gs::gs_param<unsigned int> p_mctrl_ram_sdram_bsize("bsize", 256, p_mctrl_ram_sdram);
     gs::gs_param<unsigned int> p_mctrl_ram_sdram_width("width", 32, p_mctrl_ram_sdram);
     gs::gs_param<unsigned int> p_mctrl_ram_sdram_cols("cols", 16, p_mctrl_ram_sdram);
+    gs::gs_param<std::string> p_mctrl_ram_sdram_storage("storage", "ArrayStorage", p_mctrl_ram_sdram);
     gs::gs_param<unsigned int> p_mctrl_index("index", 0u, p_mctrl);
     gs::gs_param<bool> p_mctrl_ram8("ram8", true, p_mctrl);
     gs::gs_param<bool> p_mctrl_ram16("ram16", true, p_mctrl);
@@ -360,7 +386,7 @@ int sc_main(int argc, char** argv) {
                      p_mctrl_prom_bsize * 1024,
                      p_mctrl_prom_width,
                      0,
-                     "ArrayStorage",
+                     p_mctrl_prom_storage,
                      p_report_power
     );
 
@@ -368,6 +394,12 @@ int sc_main(int argc, char** argv) {
     mctrl.mem(rom.bus);
     rom.set_clk(p_system_clock, SC_NS);
 
+    // ELF loader (loaded by the memory before the end of elaboration)
+    gs::gs_param<std::string> p_mctrl_prom_elf("elf", "", p_mctrl_prom);
+    if (!p_mctrl_prom_elf.getValue().empty()) {
+      rom.g_elf_file = p_mctrl_prom_elf.getValue();
+    }
+
     // IO memory instantiation
     Memory io( "io",
                MEMDevice::IO,
@@ -375,7 +407,7 @@ int sc_main(int argc, char** argv) {
                p_mctrl_prom_bsize * 1024 * 1024,
                p_mctrl_prom_width,
                0,
-               "MapStorage",
+               p_mctrl_io_storage,
                p_report_power
     );
 
@@ -385,6 +417,9 @@ int sc_main(int argc, char** argv) {
 
     // ELF loader from leon (Trap-Gen)
     gs::gs_param<std::string> p_mctrl_io_elf("elf", "", p_mctrl_io);
+    if (!p_mctrl_io_elf.getValue().empty()) {
+      io.g_elf_file = p_mctrl_io_elf.getValue();
+    }
 
     // SRAM instantiation
     Memory sram( "sram",
@@ -393,7 +428,7 @@ int sc_main(int argc, char** argv) {
                  p_mctrl_ram_sram_bsize * 1024 * 1024,
                  p_mctrl_ram_sram_width,
                  0,
-                 "MapStorage",
+                 p_mctrl_ram_sram_storage,
                  p_report_power
     );
 
@@ -403,6 +438,9 @@ int sc_main(int argc, char** argv) {
 
     // ELF loader from leon (Trap-Gen)
     gs::gs_param<std::string> p_mctrl_ram_sram_elf("elf", "", p_mctrl_ram_sram);
+    if (!p_mctrl_ram_sram_elf.getValue().empty()) {
+      sram.g_elf_file = p_mctrl_ram_sram_elf.getValue();
+    }
 
     // SDRAM instantiation
     Memory sdram( "sdram",
@@ -411,7 +449,7 @@ int sc_main(int argc, char** argv) {
                        p_mctrl_ram_sdram_bsize * 1024 * 1024,
                        p_mctrl_ram_sdram_width,
                        p_mctrl_ram_sdram_cols,
-                       "ArrayStorage",
+                       p_mctrl_ram_sdram_storage,
                        p_report_power
     );
 
@@ -421,6 +459,9 @@ int sc_main(int argc, char** argv) {
 
     // ELF loader from leon (Trap-Gen)
     gs::gs_param<std::string> p_mctrl_ram_sdram_elf("elf", "", p_mctrl_ram_sdram);
+    if (!p_mctrl_ram_sdram_elf.getValue().empty()) {
+      sdram.g_elf_file = p_mctrl_ram_sdram_elf.getValue();
+    }
 
 
     //leon3.ENTRY_POINT   = 0;
@@ -485,6 +526,39 @@ int sc_main(int argc, char** argv) {
       sr_signal::connect(irqmp.irq_in, ahbin->irq, p_ahbin_irq);
     }
 
+    // AHBMaster/APBSlave - ahbdma
+    // ===========================
+    gs::gs_param_array p_ahbdma("ahbdma", p_conf);
+    gs::gs_param<bool> p_ahbdma_en("en", false, p_ahbdma);
+    gs::gs_param<unsigned int> p_ahbdma_index("index", 15, p_ahbdma);
+    gs::gs_param<unsigned int> p_ahbdma_pindex("pindex", 8, p_ahbdma);
+    gs::gs_param<unsigned int> p_ahbdma_paddr("paddr", 0x008, p_ahbdma);
+    gs::gs_param<unsigned int> p_ahbdma_pmask("pmask", 0xFFF, p_ahbdma);
+    gs::gs_param<unsigned int> p_ahbdma_irq("irq", 6, p_ahbdma);
+    gs::gs_param<unsigned int> p_ahbdma_burst("burst", 1024, p_ahbdma);
+    gs::gs_param<bool> p_ahbdma_dmi("dmi", true, p_ahbdma);
+    if(p_ahbdma_en) {
+      AHBDMA *ahbdma = new AHBDMA("ahbdma",
+        ambaLayer,
+        p_ahbdma_index,
+        p_ahbdma_pindex,
+        p_ahbdma_paddr,
+        p_ahbdma_pmask,
+        p_ahbdma_irq,
+        p_ahbdma_burst,
+        p_ahbdma_dmi,
+        p_report_power
+      );
+
+      // Connect to ahb, apb and clock
+      ahbdma->ahb(ahbctrl.ahbIN);
+      apbctrl.apb(ahbdma->apb);
+      ahbdma->set_clk(p_system_clock, SC_NS);
+
+      // Connect interrupt out
+      sr_signal::connect(irqmp.irq_in, ahbdma->irq, p_ahbdma_irq);
+    }
+
     // CREATE LEON3 Processor
     // ===================================================
     // Always enabled.
@@ -524,6 +598,12 @@ int sc_main(int argc, char** argv) {
     gs::gs_param<unsigned int> p_mmu_cache_mmu_mmupgsz("mmupgsz", 0u, p_mmu_cache_mmu);
 
     gs::gs_param<std::string> p_proc_history("history", "", p_system);
+    // Binary instruction and memory access trace (see core/tools/tracedump)
+    gs::gs_param<std::string> p_system_trace("trace", "", p_system);
+    gs::gs_param<bool> p_system_trace_compress("trace_compress", false, p_system);
+    if(!((std::string)p_system_trace).empty()) {
+      TraceWriter::instance().open(p_system_trace.getValue(), p_system_trace_compress);
+    }
 
     gs::gs_param_array p_gdb("gdb", p_conf);
     gs::gs_param<bool> p_gdb_en("en", false, p_gdb);
@@ -576,6 +656,7 @@ int sc_main(int argc, char** argv) {
       // Set clock
       leon3->set_clk(p_system_clock, SC_NS);
       connect(leon3->snoop, ahbctrl.snoop);
+      connect(ahbctrl.dmi_snoop, leon3->dmi_snoop);
 
       // History logging
       std::string history = p_proc_history;
@@ -599,6 +680,19 @@ int sc_main(int argc, char** argv) {
       if(!((std::string)p_system_osemu).empty()) {
         leon3->g_osemu = p_system_osemu;
       }
+
+      // Parallel execution on host threads
+      // ===================================
+      if(p_system_parallel) {
+        leon3->g_parallel = true;
+        leon3->g_quantum = p_system_quantum;
+      }
+
+      // Binary trace
+      // ============
+      if(!((std::string)p_system_trace).empty()) {
+        leon3->g_trace = true;
+      }
     }
 
     // APBSlave - GPTimer
@@ -658,6 +752,9 @@ int sc_main(int argc, char** argv) {
         case 1:
           uart_backend = "TcpIO";
           break;
+        case 2:
+          uart_backend = "ConsoleIO";
+          break;
         default:
           uart_backend = "ReportIO";
           break;
@@ -696,6 +793,9 @@ int sc_main(int argc, char** argv) {
         case 1:
           uart_backend = "TcpIO";
           break;
+        case 2:
+          uart_backend = "ConsoleIO";
+          break;
         default:
           uart_backend = "ReportIO";
           break;
@@ -1050,6 +1150,35 @@ int sc_main(int argc, char** argv) {
 #endif /* #ifdef HAVE_AHBGPGPU */
     irqmp_rst_stimuli stimuli("platform_stimuli");
     connect(stimuli.irqmp_rst, irqmp.rst);
+
+    // Checkpoints
+    // ===========
+    // Instantiated last: the state is restored after all resets at start of simulation
+    gs::gs_param_array p_checkpoint("checkpoint", p_conf);
+    gs::gs_param<std::string> p_checkpoint_save("save", "", p_checkpoint);
+    gs::gs_param<uint64_t> p_checkpoint_save_at("save_at", 0ull, p_checkpoint);
+    gs::gs_param<std::string> p_checkpoint_restore("restore", "", p_checkpoint);
+    Checkpoint checkpoint("checkpoint");
+    checkpoint.g_save = p_checkpoint_save;
+    checkpoint.g_save_at = p_checkpoint_save_at;
+    checkpoint.g_restore = p_checkpoint_restore;
+
+    // Simulation performance counters
+    // ===============================
+    PerfMonitor *perfmon = NULL;
+    if (p_report_perf) {
+      perfmon = new PerfMonitor("perf");
+      perfmon->g_json = p_report_perf_json;
+    }
+
+    // Interval power monitor
+    // ======================
+    IntervalPowerMonitor *powmon = NULL;
+    if (p_report_power && p_report_power_interval) {
+      powmon = new IntervalPowerMonitor("powmon");
+      powmon->g_period = p_report_power_interval;
+      powmon->g_file = p_report_power_file;
+    }
 #ifndef HAVE_USI
     (void) signal(SIGINT, stopSimFunction);
     (void) signal(SIGTERM, stopSimFunction);
@@ -1065,6 +1194,7 @@ int sc_main(int argc, char** argv) {
 #endif
 //    muntrace();
     cend = clock();
+    TraceWriter::instance().close();
 
     v::report << "Summary" << "Start: " << dec << cstart << v::endl;
     v::report << "Summary" << "End:   " << dec << cend << v::endl;
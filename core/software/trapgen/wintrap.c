@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* Trap and branch heavy kernel: every descent deeper than the register
+   windows raises window overflow traps and every return the matching
+   underflow traps, the inner loop is dominated by short conditional
+   branches. Used to measure the cost of taking traps in the simulator. */
+
+unsigned long descend(unsigned long depth, unsigned long acc);
+
+unsigned long descend(depth, acc)
+unsigned long depth, acc;
+{
+ if (depth == 0)
+  return(acc);
+ if (acc & 1)
+  acc = acc * 3 + 1;
+ else
+  acc = acc >> 1;
+ return(descend(depth - 1, acc) + 1);
+}
+
+unsigned long branches(unsigned long n)
+{
+ unsigned long i, odd = 0, even = 0;
+ for (i = 0; i < n; i++) {
+  if (i & 1)
+   odd++;
+  else
+   even++;
+  if ((i & 7) == 0)
+   odd ^= even;
+ }
+ return(odd + even);
+}
+
+int main()
+{
+ register unsigned long IMax, i, value = 0;
+
+ #ifdef SHORT_BENCH
+ IMax = 200;
+ #else
+ IMax = 5000;
+ #endif
+
+ printf("\n");
+ printf("Window Trap Benchmark\n");
+
+ for (i = 0; i < IMax; i++) {
+  value += descend(32, i);
+  value += branches(64);
+ }
+
+ printf("\n");
+ printf("Checksum after %ld iterations: %ld\n", IMax, value);
+  return 0;
+}
@@ -0,0 +1,18 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+# vim: set expandtab:ts=4:sw=4:setfiletype python
+
+def options(self):
+    """No options to define"""
+    pass
+
+def configure(self):
+    """zlib is optional, it compresses binary traces"""
+    if self.check_cxx(
+            lib          = 'z',
+            header_name  = 'zlib.h',
+            uselib_store = 'ZLIB',
+            mandatory    = False,
+            msg          = 'Checking for zlib (trace compression)'
+        ):
+        self.env.append_unique('DEFINES_ZLIB', 'HAVE_ZLIB')
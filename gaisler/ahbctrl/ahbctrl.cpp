@@ -13,6 +13,9 @@
 /// @author Thomas Schuster
 ///
 
+#include <cmath>
+#include <cstring>
+#include <sstream>
 #include <string>
 #include <map>
 #include <utility>
@@ -43,6 +46,7 @@ AHBCtrl::AHBCtrl(
   ahbIN("ahbIN", amba::amba_AHB, ambaLayer, false),
   ahbOUT("ahbOUT", amba::amba_AHB, ambaLayer, false),
   snoop("snoop"),
+  dmi_snoop(&AHBCtrl::dmi_snoop_cb, "dmi_snoop"),
   g_ioaddr("ioaddr", ioaddr, m_generics),
   g_iomask("iomask", iomask, m_generics),
   g_cfgaddr("cfgaddr", cfgaddr, m_generics),
@@ -55,10 +59,14 @@ AHBCtrl::AHBCtrl(
   g_fpnpen("fpnpen", fpnpen, m_generics),
   g_mcheck("mcheck", mcheck, m_generics),
   g_pow_mon("pow_mon",pow_mon, m_generics),
+  g_ltdecoupled("ltdecoupled", false, m_generics),
+  g_idlesleep("idlesleep", true, m_generics),
   arbiter_eval_delay(1, SC_PS),
   busy(false),
+  m_bus_free(SC_ZERO_TIME),
   robin(0),
   address_bus_owner(-1),
+  data_bus_state(IDLE),
   m_AcceptPEQ("AcceptPEQ"),
   m_RequestPEQ("RequestPEQ"),
   m_ResponsePEQ("ResponsePEQ"),
@@ -151,15 +159,13 @@ AHBCtrl::AHBCtrl(
     ("fpnpen", fpnpen)
     ("mcheck", mcheck)
     ("pow_mon", pow_mon)
+    ("ltdecoupled", g_ltdecoupled)
+    ("idlesleep", g_idlesleep)
     ("ambaLayer", ambaLayer)
     ("Created an AHBCtrl with this parameters");
 
-  // initialize the slave_map_cache with some bogus numbers which will trigger MISS
-  slave_info_t tmp;
-  tmp.hindex = 0;
-  tmp.hmask  = ~0;
-  tmp.binding = ~0;
-  slave_map_cache = std::pair<uint32_t, slave_info_t>(~0, tmp);
+  // Nothing is mapped before start_of_simulation
+  memset(m_decode, -1, sizeof(m_decode));
 }
 
 AHBCtrl::AHBCtrl(
@@ -182,6 +188,7 @@ AHBCtrl::AHBCtrl(
   ahbIN("ahbIN", amba::amba_AHB, ambaLayer, false),
   ahbOUT("ahbOUT", amba::amba_AHB, ambaLayer, false),
   snoop("snoop"),
+  dmi_snoop(&AHBCtrl::dmi_snoop_cb, "dmi_snoop"),
   g_ioaddr("ioaddr", ioaddr, m_generics),
   g_iomask("iomask", iomask, m_generics),
   g_cfgaddr("cfgaddr", cfgaddr, m_generics),
@@ -194,10 +201,14 @@ AHBCtrl::AHBCtrl(
   g_fpnpen("fpnpen", fpnpen, m_generics),
   g_mcheck("mcheck", mcheck, m_generics),
   g_pow_mon("pow_mon",pow_mon, m_generics),
+  g_ltdecoupled("ltdecoupled", false, m_generics),
+  g_idlesleep("idlesleep", true, m_generics),
   arbiter_eval_delay(1, SC_PS),
   busy(false),
+  m_bus_free(SC_ZERO_TIME),
   robin(0),
   address_bus_owner(-1),
+  data_bus_state(IDLE),
   m_AcceptPEQ("AcceptPEQ"),
   m_RequestPEQ("RequestPEQ"),
   m_ResponsePEQ("ResponsePEQ"),
@@ -292,15 +303,13 @@ AHBCtrl::AHBCtrl(
     ("fpnpen", fpnpen)
     ("mcheck", mcheck)
     ("pow_mon", pow_mon)
+    ("ltdecoupled", g_ltdecoupled)
+    ("idlesleep", g_idlesleep)
     ("ambaLayer", ambaLayer)
     ("Created an AHBCtrl with this parameters");
 
-  // initialize the slave_map_cache with some bogus numbers which will trigger MISS
-  slave_info_t tmp;
-  tmp.hindex = 0;
-  tmp.hmask  = ~0;
-  tmp.binding = ~0;
-  slave_map_cache = std::pair<uint32_t, slave_info_t>(~0, tmp);
+  // Nothing is mapped before start_of_simulation
+  memset(m_decode, -1, sizeof(m_decode));
 }
 
 // Reset handler
@@ -308,6 +317,16 @@ void AHBCtrl::dorst() {
   // nothing to do
 }
 
+// Checkpoints are taken between transactions, only the arbitration
+// state survives. The decode tables are rebuilt at start of simulation.
+void AHBCtrl::checkpoint_save(CheckpointArchive &ar) {
+  ar.put("robin", robin);
+}
+
+void AHBCtrl::checkpoint_restore(const CheckpointArchive &ar) {
+  ar.get("robin", robin);
+}
+
 // Destructor
 AHBCtrl::~AHBCtrl() {
   GC_UNREGISTER_CALLBACKS();
@@ -385,6 +404,17 @@ void AHBCtrl::init_generics() {
     ("name", "Power Monitoring")
     ("If true enable power monitoring");
 
+  g_ltdecoupled.add_properties()
+    ("name", "LT temporal decoupling")
+    ("If true the LT bus does not synchronize with the SystemC kernel. "
+     "Bus contention is computed from the time the bus is occupied by previous transactions "
+     "and added to the annotated delay. Has no effect on AT simulation.");
+
+  g_idlesleep.add_properties()
+    ("name", "AT arbiter idle sleep")
+    ("If true the AT arbiter sleeps while the bus is idle instead of running every clock cycle. "
+     "Arbitration results and timing are the same, false runs the arbiter in every cycle.");
+
 }
 
 // Helper function for creating slave map decoder entries
@@ -399,36 +429,32 @@ void AHBCtrl::setAddressMap(const uint32_t binding, const uint32_t hindex, const
   slave_map.insert(std::pair<uint32_t, slave_info_t>(haddr, tmp));
 }
 
+// Expands slave_map into the flat decoder table.
+// Entries are applied in ascending address order, so in case of an
+// overlap the BAR with the higher address wins like in the map lookup.
+void AHBCtrl::build_decoder() {
+  memset(m_decode, -1, sizeof(m_decode));
+  for (std::map<uint32_t, slave_info_t>::iterator it = slave_map.begin(); it != slave_map.end(); ++it) {
+    for (uint32_t area = 0; area < 4096; area++) {
+      if (!((area ^ it->first) & it->second.hmask)) {
+        // There may be up to four BARs per device.
+        // Only store device ID.
+        m_decode[area] = static_cast<int8_t>(it->second.binding >> 2);
+      }
+    }
+  }
+}
+
 // Find slave index by address
 int AHBCtrl::get_index(const uint32_t address) {
   m_total_transactions++;
 
-  // Use 12 bit segment address for decoding
-  uint32_t addr = address >> 20;
-
-  // check cache, otherwise search within map
-  slave_info_t info = slave_map_cache.second;
-  if ( ! ((addr ^ slave_map_cache.first) & info.hmask) ) {
-    // There may be up to four BARs per device.
-    // Only return device ID.
-    m_right_transactions++;
-    return (info.binding) >> 2;
-  }
-
-  std::map<uint32_t, slave_info_t>::iterator it = --(slave_map.upper_bound( addr ));
-  info = it->second;
-  if ( ! ((addr ^ it->first) & info.hmask) ) {
-    // MISS in the cache: update cache
-    slave_map_cache = *it;
-  
-    // There may be up to four BARs per device.
-    // Only return device ID.
+  // Use 12 bit segment address (1 MB areas) for decoding
+  int index = m_decode[address >> 20];
+  if (index >= 0) {
     m_right_transactions++;
-    return (info.binding) >> 2;
   }
-
-  // no slave found
-  return -1;
+  return index;
 }
 
 // Returns a PNP register from the slave configuration area
@@ -444,7 +470,7 @@ unsigned int AHBCtrl::getPNPReg(const uint32_t address) {
       ((static_cast<uint32_t>(g_ioaddr) << 20) |
        (static_cast<uint32_t>(g_cfgaddr) << 8)) &
        ((static_cast<uint32_t>(g_iomask) << 20) | (static_cast<uint32_t>(g_cfgmask) << 8)));
-  srDebug()("addr", addr)("Accessing PNP area");
+  V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("Accessing PNP area");
 
   // Slave area
   if (addr >= 0x800) {
@@ -456,7 +482,7 @@ unsigned int AHBCtrl::getPNPReg(const uint32_t address) {
     // Calculate offset within device information
     unsigned int offset = (addr >> 2) & 0x7;
 
-    srDebug()("addr", addr)("device", device)("offset", offset)("Access mSlaves");
+    V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("device", device)("offset", offset)("Access mSlaves");
 
     if (device >= num_of_slave_bindings) {
       srWarn()("addr", addr)("device", device)("slavecount", num_of_slave_bindings)("Access to unregistered PNP Slave Register!");
@@ -516,13 +542,18 @@ void AHBCtrl::b_transport(uint32_t id,
     mstobj = other_socket->get_parent();
   //}
 
-  srDebug()("pointer", reinterpret_cast<size_t>(&trans))("busy", busy)("is_lock", is_lock)("id", id)("lock_master", lock_master)("delay", delay)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(&trans))("busy", busy)("is_lock", is_lock)("id", id)("lock_master", lock_master)("delay", delay)(__PRETTY_FUNCTION__);
   // Bus occupied or locked by other master
   while (busy || (is_lock && (id != lock_master))) {
     wait(clock_cycle);
   }
 
   busy = true;
+
+  // Wait for the end of previous transactions in the annotated time
+  if (g_ltdecoupled) {
+    lt_arbitrate(id, delay);
+  }
   is_lock = ahbIN.get_extension<amba::amba_lock>(lock, trans);
 
   lock_master = id;
@@ -534,7 +565,7 @@ void AHBCtrl::b_transport(uint32_t id,
   uint32_t addr   = trans.get_address();
   // Extract length from payload
   uint32_t length = trans.get_data_length();
-  srDebug()("pointer", reinterpret_cast<size_t>(&trans))("busy", busy)("is_lock", is_lock)("id", id)("lock_master", lock_master)("addr", addr)("delay", delay)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(&trans))("busy", busy)("is_lock", is_lock)("id", id)("lock_master", lock_master)("addr", addr)("delay", delay)(__PRETTY_FUNCTION__);
   
   // Is this an access to configuration area
   if (g_fpnpen && ((
@@ -562,8 +593,12 @@ void AHBCtrl::b_transport(uint32_t id,
       // and return
       trans.set_response_status(tlm::TLM_OK_RESPONSE);
 
-      wait(delay);
-      delay = SC_ZERO_TIME;
+      if (g_ltdecoupled) {
+        m_bus_free = sc_time_stamp() + delay;
+      } else {
+        wait(delay);
+        delay = SC_ZERO_TIME;
+      }
 
       msclogger::return_backward(this, &ahbIN, &trans, tlm::TLM_COMPLETED, delay);
 
@@ -577,7 +612,9 @@ void AHBCtrl::b_transport(uint32_t id,
         ("Forbidden write to AHBCTRL configuration area (PNP)!");
       trans.set_response_status(tlm::TLM_COMMAND_ERROR_RESPONSE);
 
-      delay = SC_ZERO_TIME;
+      if (!g_ltdecoupled) {
+        delay = SC_ZERO_TIME;
+      }
 
       msclogger::return_backward(this, &ahbIN, &trans, tlm::TLM_COMPLETED, delay);
 
@@ -595,7 +632,7 @@ void AHBCtrl::b_transport(uint32_t id,
       other_socket = ahbOUT.get_other_side(index, a);
       slvobj = other_socket->get_parent();
 
-      srDebug()("addr", trans.get_address())("master", mstobj->name())("slave", slvobj->name())("AHBRequest, b_transport");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", trans.get_address())("master", mstobj->name())("slave", slvobj->name())("AHBRequest, b_transport");
     //}
 
     // Broadcast master_id and address for dcache snooping
@@ -614,18 +651,24 @@ void AHBCtrl::b_transport(uint32_t id,
     // uint32_t id = data_int & 0xFFFFFFFF;
     delay+=clock_cycle;
 
-    srDebug()("addr", trans.get_address())("master", mstobj->name())("slave", slvobj->name())("Outbound b_tranport");
+    V_IF(m_verbosity, v::debug) srDebug()("addr", trans.get_address())("master", mstobj->name())("slave", slvobj->name())("Outbound b_tranport");
     // Forward request to the selected slave
     ahbOUT[index]->b_transport(trans, delay);
 
-    srDebug()("addr", trans.get_address())("master", mstobj->name())("slave", slvobj->name())("Outbound b_tranport called");
-    // v::debug << name() << "Delay after return from slave: " << delay << v::endl;
+    V_IF(m_verbosity, v::debug) srDebug()("addr", trans.get_address())("master", mstobj->name())("slave", slvobj->name())("Outbound b_tranport called");
+    // V_LOG(m_verbosity, v::debug) << name() << "Delay after return from slave: " << delay << v::endl;
 
     // Power event end
     // PM::send(this,event_name,0,sc_time_stamp()+delay,id,g_pow_mon);
 
-    wait(delay);
-    delay = SC_ZERO_TIME;
+    if (g_ltdecoupled) {
+      // The bus is occupied until the end of the transaction.
+      // The master consumes the delay at the end of its quantum.
+      m_bus_free = sc_time_stamp() + delay;
+    } else {
+      wait(delay);
+      delay = SC_ZERO_TIME;
+    }
     // Broadcast master_id and address for dcache snooping
     if (trans.get_command() == tlm::TLM_WRITE_COMMAND) { // By ABBAS 
       snoopy.master_id  = id;
@@ -649,14 +692,42 @@ void AHBCtrl::b_transport(uint32_t id,
     // Invalid index
     trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
 
-    wait(delay);
-    delay = SC_ZERO_TIME;
+    if (!g_ltdecoupled) {
+      wait(delay);
+      delay = SC_ZERO_TIME;
+    }
 
     busy = false;
     return;
   }
 }
 
+// Decoupled LT arbitration. Instead of waiting for the bus the master
+// is delayed until the end of the last transaction in annotated time.
+void AHBCtrl::lt_arbitrate(uint32_t id, sc_time &delay) {  // NOLINT(runtime/references)
+  sc_time start = sc_time_stamp() + delay;
+  sc_time waiting_time = SC_ZERO_TIME;
+  sc_time tmp;
+
+  if (m_bus_free > start) {
+    waiting_time = m_bus_free - start;
+  }
+
+  // Statistic
+  if (waiting_time > m_max_wait) {
+    m_max_wait = waiting_time;
+    m_max_wait_master = id;
+  }
+
+  tmp = m_total_wait;
+  tmp += waiting_time;
+
+  m_total_wait = tmp;
+  m_arbitrated++;
+
+  delay += waiting_time;
+}
+
 // Non-blocking forward transport function for ahb_slave multi-socket
 // A master may send BEGIN_REQ or END_RESP. The model replies with
 // TLM_ACCEPTED or TLM_COMPLETED, respectively.
@@ -665,7 +736,7 @@ tlm::tlm_sync_enum AHBCtrl::nb_transport_fw(
     tlm::tlm_generic_payload &trans,  // NOLINT(runtime/references)
     tlm::tlm_phase &phase,            // NOLINT(runtime/references)
     sc_core::sc_time &delay) {        // NOLINT(runtime/references)
-  srDebug()("pointer", reinterpret_cast<size_t>(&trans))("phase", phase)("delay", delay)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(&trans))("phase", phase)("delay", delay)(__PRETTY_FUNCTION__);
 
   if (phase == tlm::BEGIN_REQ) {
     // Increment reference counter
@@ -677,7 +748,7 @@ tlm::tlm_sync_enum AHBCtrl::nb_transport_fw(
     ahbIN.get_extension<amba::amba_id>(m_id, trans);
     m_id->value = master_id;
 
-    srDebug()("pointer", reinterpret_cast<size_t>(&trans))("master_id", master_id)("refcount", trans.get_ref_count());
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(&trans))("master_id", master_id)("refcount", trans.get_ref_count());
 
     // In communication with the ahbctrl, BEGIN_REQ marks the begin of the bus request.
     // Transaction is send to request thread, where it is going to be decoded and put in PENDING state.
@@ -723,7 +794,7 @@ tlm::tlm_sync_enum AHBCtrl::nb_transport_bw(
     tlm::tlm_generic_payload &trans,  // NOLINT(runtime/references)
     tlm::tlm_phase &phase,            // NOLINT(runtime/references)
     sc_core::sc_time &delay) {        // NOLINT(runtime/references)
-  srDebug()("pointer", reinterpret_cast<size_t>(&trans))("phase", phase)("delay", delay)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(&trans))("phase", phase)("delay", delay)(__PRETTY_FUNCTION__);
 
   // The slave has sent END_REQ
   if (phase == tlm::END_REQ) {
@@ -779,16 +850,31 @@ void AHBCtrl::arbitrate() {
 
   wait(1, SC_PS);
 
+  // Time of the last arbiter cycle
+  sc_core::sc_time tick = sc_time_stamp();
+
   // Arbiter phase shift:
   // --------------------
   while (true) {
-    wait(clock_cycle);
+    // Nothing to arbitrate and no transfer to count.
+    // Sleep until a master requests the bus, then continue
+    // on the clock grid the arbiter would have followed.
+    if (g_idlesleep && (address_bus_owner == -1) && ((data_bus_state == RESPONSE) || (data_bus_state == IDLE)) &&
+        !requests_waiting()) {
+      wait(m_arbiter_event);
+
+      double cycles = ceil((sc_time_stamp() - tick) / clock_cycle);
+      tick += clock_cycle * ((cycles < 1.0) ? 1.0 : cycles);
+    } else {
+      tick += clock_cycle;
+    }
+    wait(tick - sc_time_stamp());
 
     // print_requests();
 
     // Last address of current transfer must have been sampled.
     // Last data sample is on the way.
-    // v::debug << name() << " address_bus_owner: " << address_bus_owner << " data_bus_state: "
+    // V_LOG(m_verbosity, v::debug) << name() << " address_bus_owner: " << address_bus_owner << " data_bus_state: "
     //          << data_bus_state << v::endl;
     // if (sc_time_stamp() > sc_core::sc_time(83880, SC_NS)) sc_stop();
 
@@ -827,10 +913,10 @@ void AHBCtrl::arbitrate() {
           for (uint32_t i = 0; i < num_of_master_bindings; i++) {
             robin = (robin + 1) % num_of_master_bindings;
 
-            srDebug()("robin", robin)(__PRETTY_FUNCTION__);
+            V_IF(m_verbosity, v::debug) srDebug()("robin", robin)(__PRETTY_FUNCTION__);
 
             if (request_map[robin].state == TRANS_PENDING) {
-              srDebug()("robin", robin)("Selected for robin");
+              V_IF(m_verbosity, v::debug) srDebug()("robin", robin)("Selected for robin");
 
               address_bus_owner = robin;
               request_map[robin].state = TRANS_SCHEDULED;
@@ -846,7 +932,7 @@ void AHBCtrl::arbitrate() {
           }
         } else {
           if (request_map[lock_master].state == TRANS_PENDING) {
-            srDebug()("robin", robin)("Selected for robin");
+            V_IF(m_verbosity, v::debug) srDebug()("robin", robin)("Selected for robin");
 
             address_bus_owner = lock_master;
             request_map[lock_master].state = TRANS_SCHEDULED;
@@ -903,7 +989,7 @@ void AHBCtrl::arbitrate() {
           phase = tlm::BEGIN_REQ;
           delay = SC_ZERO_TIME;
 
-          srDebug()("pointer", reinterpret_cast<size_t>(&trans))("phase", phase)("delay", delay)(__PRETTY_FUNCTION__);
+          V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(&trans))("phase", phase)("delay", delay)(__PRETTY_FUNCTION__);
 
           // Forward arrow for msc
           msclogger::forward(this, &ahbOUT, trans, phase, delay, slave_id);
@@ -927,6 +1013,16 @@ void AHBCtrl::arbitrate() {
   }
 }
 
+// Returns true if any master is waiting for the bus
+bool AHBCtrl::requests_waiting() const {
+  for (int i = 0; i < 16; i++) {
+    if (request_map[i].state == TRANS_PENDING) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Queue incoming master transactions
 void AHBCtrl::AcceptThread() {
   int slave_id = 16;
@@ -961,7 +1057,7 @@ void AHBCtrl::AcceptThread() {
         slave_id = get_index(trans->get_address());
       }
 
-      v::debug << name() << "Decoding (" << hex << trans << ")" << " - Master: " << master_id->value << " Slave : " <<
+      V_LOG(m_verbosity, v::debug) << name() << "Decoding (" << hex << trans << ")" << " - Master: " << master_id->value << " Slave : " <<
         dec << slave_id << " Address: " << hex << trans->get_address() << v::endl;
 
       if (slave_id >= 0) {
@@ -974,6 +1070,9 @@ void AHBCtrl::AcceptThread() {
 
         request_map[master_id->value] = connection;
         response_map[master_id->value] = connection;
+
+        // Wake up the arbiter
+        m_arbiter_event.notify();
       } else {
         v::error << name() << "DECODING ERROR" << v::endl;
       }
@@ -1026,7 +1125,7 @@ void AHBCtrl::RequestThread() {
       phase = tlm::END_REQ;
       delay = SC_ZERO_TIME;
 
-      v::debug << name() << "Transaction 0x" << hex << trans << " call to nb_transport_bw with phase " << phase <<
+      V_LOG(m_verbosity, v::debug) << name() << "Transaction 0x" << hex << trans << " call to nb_transport_bw with phase " << phase <<
         v::endl;
 
       // Backward arrow for msc
@@ -1070,7 +1169,7 @@ void AHBCtrl::ResponseThread() {
       phase = tlm::BEGIN_RESP;
       delay = SC_ZERO_TIME;
 
-      v::debug << name() << "Transaction 0x" << hex << trans << " call to nb_transport_bw with phase " << phase <<
+      V_LOG(m_verbosity, v::debug) << name() << "Transaction 0x" << hex << trans << " call to nb_transport_bw with phase " << phase <<
         v::endl;
 
       // Backward arrow for msc
@@ -1119,7 +1218,7 @@ void AHBCtrl::EndResponseThread() {
         // Data bus is now idle
         data_bus_state = IDLE;
 
-        v::debug << name() << "Release " << trans << " Ref-Count before calling release " << trans->get_ref_count() <<
+        V_LOG(m_verbosity, v::debug) << name() << "Release " << trans << " Ref-Count before calling release " << trans->get_ref_count() <<
           v::endl;
 
         // Decrement reference counter
@@ -1132,7 +1231,7 @@ void AHBCtrl::EndResponseThread() {
         phase = tlm::END_RESP;
         delay = SC_ZERO_TIME;
 
-        v::debug << name() << "Transaction 0x" << hex << trans << " call to nb_transport_fw with phase " << phase <<
+        V_LOG(m_verbosity, v::debug) << name() << "Transaction 0x" << hex << trans << " call to nb_transport_fw with phase " << phase <<
           v::endl;
 
         // Forward arrow for msc
@@ -1145,7 +1244,7 @@ void AHBCtrl::EndResponseThread() {
         assert((status == tlm::TLM_ACCEPTED) || (status == tlm::TLM_COMPLETED));
 #endif
 
-        v::debug << name() << "Release " << trans << " Ref-Count before calling release " << trans->get_ref_count() <<
+        V_LOG(m_verbosity, v::debug) << name() << "Release " << trans << " Ref-Count before calling release " << trans->get_ref_count() <<
           v::endl;
 
         // Decrement reference counter
@@ -1155,23 +1254,9 @@ void AHBCtrl::EndResponseThread() {
   }
 }
 
-// Set up slave map and collect plug & play information
-void AHBCtrl::start_of_simulation() {
-  // Get number of bindings at master socket (number of connected slaves)
-  num_of_slave_bindings = ahbOUT.size();
-  // Get number of bindings at slave socket (number of connected masters)
-  num_of_master_bindings = ahbIN.size();
-
-  // Max. 16 AHB slaves allowed
-  assert(num_of_slave_bindings <= 16);
-
-  // Max. 16 AHB masters allowed
-  assert(num_of_master_bindings <= 16);
-
-  srInfo()
-    ("slaves", num_of_slave_bindings)
-    ("masters", num_of_master_bindings)
-    ("AHB decoder initialization");
+// Collects the slave BARs and PNP records and rebuilds the decoder
+void AHBCtrl::update_slave_map() {
+  slave_map.clear();
 
   // Iterate/detect the registered slaves
   // ------------------------------------
@@ -1220,7 +1305,7 @@ void AHBCtrl::start_of_simulation() {
           // Insert slave region into memory map
           setAddressMap(i + j, sbusid, addr, mask);
         } else {
-          srDebug()
+          V_IF(m_verbosity, v::debug) srDebug()
             ("bar", j)
             ("name", obj->name())
             ("index", sbusid)
@@ -1235,6 +1320,65 @@ void AHBCtrl::start_of_simulation() {
     }
   }
 
+  build_decoder();
+}
+
+// A slave BAR changed: rebuild the decoder, granted DMI regions may be stale
+gs::cnf::callback_return_type AHBCtrl::slave_config_cb(
+    gs::gs_param_base &changed_param,  // NOLINT(runtime/references)
+    gs::cnf::callback_type reason) {
+  srInfo()
+    ("param", changed_param.getName())
+    ("Slave configuration changed, rebuilding the AHB decoder");
+  update_slave_map();
+  if (g_mcheck) {
+    checkMemMap();
+  }
+  if (m_ambaLayer == amba::amba_LT) {
+    invalidate_direct_mem_ptr(0, 0, ~0ull);
+  }
+  return GC_RETURN_OK;
+}
+
+// Set up slave map and collect plug & play information
+void AHBCtrl::start_of_simulation() {
+  // Get number of bindings at master socket (number of connected slaves)
+  num_of_slave_bindings = ahbOUT.size();
+  // Get number of bindings at slave socket (number of connected masters)
+  num_of_master_bindings = ahbIN.size();
+
+  // Max. 16 AHB slaves allowed
+  assert(num_of_slave_bindings <= 16);
+
+  // Max. 16 AHB masters allowed
+  assert(num_of_master_bindings <= 16);
+
+  srInfo()
+    ("slaves", num_of_slave_bindings)
+    ("masters", num_of_master_bindings)
+    ("AHB decoder initialization");
+
+  // Iterate/detect the registered slaves and build the decoder
+  update_slave_map();
+
+  // The decoder follows later changes of the slave BARs
+  gs::cnf::cnf_api *mApi = gs::cnf::GCnf_Api::getApiInstance(NULL);
+  const char *fields[] = { "haddr", "hmask", "htype" };
+  for (uint32_t i = 0; i < num_of_slave_bindings; i++) {
+    uint32_t a = 0;
+    sc_core::sc_object *obj = ahbOUT.get_other_side(i, a)->get_parent();
+    for (uint32_t j = 0; j < 4; j++) {
+      for (uint32_t k = 0; k < 3; k++) {
+        std::ostringstream param;
+        param << obj->name() << ".generics.bar." << j << "." << fields[k];
+        gs::gs_param_base *par = mApi->getPar(param.str());
+        if (par) {
+          GC_REGISTER_TYPED_PARAM_CALLBACK(par, gs::cnf::post_write, AHBCtrl, slave_config_cb);
+        }
+      }
+    }
+  }
+
   // Iterate/detect the registered masters
   // ------------------------------------
   for (uint32_t i = 0; i < (num_of_master_bindings << 2); i += 4) {
@@ -1279,7 +1423,7 @@ void AHBCtrl::start_of_simulation() {
             ("index", mbusid)
             ("Binding BAR of Master to AHB Address");
         } else {
-          srDebug()
+          V_IF(m_verbosity, v::debug) srDebug()
             ("bar", j)
             ("name", obj->name())
             ("index", mbusid)
@@ -1375,6 +1519,18 @@ void AHBCtrl::end_of_simulation() {
     v::report << name() << " * " << v::endl;
   }
 
+  if ((m_ambaLayer == amba::amba_LT) && g_ltdecoupled && m_arbitrated) {
+    sc_time max_wait = m_max_wait;
+    sc_time total_wait = m_total_wait;
+
+    v::report << name() << " * Maximum bus contention: " << m_max_wait << " (" << max_wait / clock_cycle <<
+      " cycles)" << v::endl;
+    v::report << name() << " * Master with maximum contention: " << m_max_wait_master << v::endl;
+    v::report << name() << " * Average contention / transaction: " << total_wait / m_arbitrated << " (" <<
+    (total_wait / m_arbitrated) / clock_cycle << " cycles)" << v::endl;
+    v::report << name() << " * " << v::endl;
+  }
+
   v::report << name() << " * AHB Master interface reports: " << v::endl;
   print_transport_statistics(name());
 
@@ -1477,7 +1633,7 @@ unsigned int AHBCtrl::transport_dbg(uint32_t id, tlm::tlm_generic_payload &trans
     other_socket = ahbOUT.get_other_side(index, a);
     sc_core::sc_object *obj = other_socket->get_parent();
 
-    srDebug()
+    V_IF(m_verbosity, v::debug) srDebug()
       ("addr", trans.get_address())
       ("length", trans.get_data_length())
       ("master", mstobj->name())
@@ -1531,6 +1687,11 @@ void AHBCtrl::invalidate_direct_mem_ptr(unsigned int index, sc_dt::uint64 start_
   }
 }
 
+// A master wrote through DMI: broadcast the store to the snooping caches like a bus write
+void AHBCtrl::dmi_snoop_cb(const t_snoop &store, const sc_core::sc_time &delay) {
+  snoop.write(store);
+}
+
 // Collect common transport statistics
 void AHBCtrl::transport_statistics(tlm::tlm_generic_payload &gp) {  // NOLINT(runtime/references)
   if (gp.is_write()) {
@@ -27,9 +27,10 @@
 #include "core/common/sr_signal.h"
 #include "core/common/msclogger.h"
 #include "core/common/socrocket.h"
+#include "core/common/checkpoint.h"
 #include "core/common/sr_param.h"
 
-class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
+class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice, public Checkpointable {
   public:
     GC_HAS_CALLBACKS();
     SC_HAS_PROCESS(AHBCtrl);
@@ -44,6 +45,8 @@ class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
     amba::amba_master_socket<32, 0> ahbOUT;
     /// Broadcast of master_id and write address for dcache snooping
     signal<t_snoop>::out snoop;
+    /// Stores the masters did through DMI, forwarded to snoop
+    signal<t_snoop>::in dmi_snoop;
 
     // Public functions
     // ----------------
@@ -74,6 +77,9 @@ class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
     virtual bool get_direct_mem_ptr(unsigned int index, tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data);
     virtual void invalidate_direct_mem_ptr(unsigned int index, sc_dt::uint64 start_range, sc_dt::uint64 end_range);
 
+    /// Forwards the DMI stores of a master to the snooping caches
+    void dmi_snoop_cb(const t_snoop &store, const sc_core::sc_time &delay);
+
     /// The arbiter thread. Responsible for arbitrating transactions in AT mode.
     void arbitrate();
 
@@ -144,6 +150,12 @@ class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
     /// Reset Callback
     void dorst();
 
+    /// Save the arbitration state (round robin pointer)
+    void checkpoint_save(CheckpointArchive &ar);
+
+    /// Restore the arbitration state
+    void checkpoint_restore(const CheckpointArchive &ar);
+
     /// Desctructor
     ~AHBCtrl();
 
@@ -190,11 +202,20 @@ class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
     /// Enable power monitoring (Only TLM)
     sr_param<bool> g_pow_mon;
 
+    /// Temporal decoupling in LT mode (bus occupancy instead of waiting)
+    sr_param<bool> g_ltdecoupled;
+
+    /// Let the AT arbiter sleep while no master requests the bus
+    sr_param<bool> g_idlesleep;
+
     const sc_time arbiter_eval_delay;
 
     // Shows if bus is busy in LT mode
     bool busy;
 
+    /// End of the last transaction on the bus in decoupled LT mode
+    sc_time m_bus_free;
+
     typedef tlm::tlm_generic_payload payload_t;
     typedef gs::socket::bindability_base<tlm::tlm_base_protocol_types> socket_t;
 
@@ -209,7 +230,9 @@ class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
 
     /// Address decoder table (slave index, (bar addr, mask))
     std::map<uint32_t, slave_info_t> slave_map;
-    std::pair<uint32_t, slave_info_t> slave_map_cache;
+
+    /// Flat decoder: slave index per 1 MB area of the address space, -1 if unmapped
+    int8_t m_decode[4096];
 
     /// Connection state:
     //  -----------------
@@ -243,6 +266,9 @@ class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
     int32_t address_bus_owner;
     DbusStateType data_bus_state;
 
+    /// Wakes the arbiter from idle when a new request is pending
+    sc_event m_arbiter_event;
+
     /// PEQs for arbitration, request notification and responses
     tlm_utils::peq_with_get<payload_t> m_AcceptPEQ;
     tlm_utils::peq_with_get<payload_t> m_RequestPEQ;
@@ -366,12 +392,29 @@ class AHBCtrl : public BaseModule<DefaultBase>, public CLKDevice {
     /// Helper function for creating slave map decoder entries
     void setAddressMap(const uint32_t binding, const uint32_t hindex, const uint32_t haddr, const uint32_t hmask);
 
+    /// Collects the slave BARs into slave_map and rebuilds the decoder
+    void update_slave_map();
+
+    /// Expands slave_map into the flat decoder table m_decode
+    void build_decoder();
+
+    /// Called when a BAR parameter of a slave changes
+    gs::cnf::callback_return_type slave_config_cb(
+        gs::gs_param_base &changed_param,  // NOLINT(runtime/references)
+        gs::cnf::callback_type reason);
+
     /// Get slave index for a given address
     int get_index(const uint32_t address);
 
     /// Returns a PNP register from the slave configuration area
     unsigned int getPNPReg(const uint32_t address);
 
+    /// Decoupled LT mode: Adds the time the bus is still occupied to the delay
+    void lt_arbitrate(uint32_t id, sc_time &delay);  // NOLINT(runtime/references)
+
+    /// True if any master is waiting for arbitration (AT only)
+    bool requests_waiting() const;
+
     /// Keeps track of master-payload relation
     void addPendingTransaction(
         tlm::tlm_generic_payload &trans,  // NOLINT(runtime/references)
@@ -0,0 +1,276 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup ahbctrl
+/// @{
+/// @file ahbctrl_bench.cpp
+/// Checks that the idle sleep of the AT arbiter keeps grant order and timing.
+///
+/// Three AT masters send bursty traffic with idle gaps to a fast and a slow
+/// slave. The reference system runs the arbiter in every clock cycle
+/// (idlesleep = false), the other one lets it sleep while the bus is idle.
+/// The time and master of every grant (END_REQ) and every BEGIN_RESP must
+/// be the same in both, for fixed priority and for round-robin arbitration.
+/// A difference makes the program exit with 1.
+///
+///     $ build/gaisler/ahbctrl/bench/ahbctrl_bench [-v]
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>  // NOLINT(readability/streams)
+#include <string>
+#include <vector>
+
+#include "core/common/systemc.h"
+#include "core/common/ahbmaster.h"
+#include "core/common/ahbslave.h"
+#include "core/common/clkdevice.h"
+#include "gaisler/ahbctrl/ahbctrl.h"
+
+namespace {
+  /// One bus event as seen by a master
+  struct Event {
+    uint64_t time;    ///< sc_time_stamp() in ps
+    uint32_t phase;   ///< 0 - grant (END_REQ), 1 - BEGIN_RESP
+    uint32_t master;
+
+    bool operator<(const Event &other) const {
+      if (time != other.time) {
+        return time < other.time;
+      }
+      if (phase != other.phase) {
+        return phase < other.phase;
+      }
+      return master < other.master;
+    }
+
+    bool operator==(const Event &other) const {
+      return time == other.time && phase == other.phase && master == other.master;
+    }
+  };
+
+  /// One access of a master script, issued gap ns after the previous response
+  struct Step {
+    uint32_t gap;
+    bool write;
+    uint32_t addr;
+    uint32_t length;  ///< 0 ends the script
+  };
+
+  // Back-to-back bursts, separated by idle gaps which are not always
+  // multiples of the clock period.
+  const Step s_script0[] = {
+    {    0, false, 0x40000000, 16 }, {    0, false, 0x40000010, 16 },
+    {    0, true,  0x50000000, 32 }, {    0, false, 0x50000020,  4 },
+    {  480, true,  0x40000100,  8 }, {    0, false, 0x40000100,  8 },
+    { 2000, false, 0x50000000, 32 }, {    0, true,  0x40000200,  4 },
+    {    0, false, 0,           0 }
+  };
+
+  const Step s_script1[] = {
+    {   35, true,  0x40001000, 32 }, {    0, true,  0x40001020, 32 },
+    {  117, false, 0x50001000, 16 }, {    0, false, 0x40001000,  4 },
+    { 1503, true,  0x50001000,  4 }, {    3, false, 0x40001000, 32 },
+    {    0, false, 0,           0 }
+  };
+
+  const Step s_script2[] = {
+    {    0, false, 0x50002000,  4 }, {  733, false, 0x40002000,  4 },
+    {  730, true,  0x40002000, 16 }, { 1999, false, 0x50002000, 16 },
+    {    0, false, 0x40002000, 16 }, {    0, false, 0,           0 }
+  };
+
+  class BenchMaster : public AHBMaster<>, public CLKDevice {
+    public:
+      SC_HAS_PROCESS(BenchMaster);
+
+      BenchMaster(ModuleName nm, uint32_t hindex, const Step *script, std::vector<Event> *log) :
+        AHBMaster<>(nm, hindex, 0x04, 0x000, 0, 0, amba::amba_AT),
+        m_hindex(hindex),
+        m_script(script),
+        m_log(log),
+        m_responses(0) {
+        SC_THREAD(run);
+      }
+
+      void run() {
+        uint32_t issued = 0;
+        for (const Step *step = m_script; step->length; ++step) {
+          wait(sc_core::sc_time(step->gap, sc_core::SC_NS));
+          if (step->write) {
+            memset(m_data, m_hindex, step->length);
+            ahbwrite(step->addr, m_data, step->length);
+          } else {
+            ahbread(step->addr, m_data, step->length);
+          }
+          ++issued;
+          while (m_responses < issued) {
+            wait(m_response_event);
+          }
+        }
+      }
+
+      void response_callback(tlm::tlm_generic_payload *trans) {
+        ++m_responses;
+        m_response_event.notify();
+      }
+
+      tlm::tlm_sync_enum nb_transport_bw(
+          tlm::tlm_generic_payload &payload,    // NOLINT(runtime/references)
+          tlm::tlm_phase &phase,                // NOLINT(runtime/references)
+          sc_core::sc_time &delay) {            // NOLINT(runtime/references)
+        if (phase == tlm::END_REQ || phase == tlm::BEGIN_RESP) {
+          Event event = { (sc_core::sc_time_stamp() + delay).value(), phase == tlm::END_REQ ? 0u : 1u, m_hindex };
+          m_log->push_back(event);
+        }
+        return AHBMaster<>::nb_transport_bw(payload, phase, delay);
+      }
+
+      sc_core::sc_time get_clock() {
+        return clock_cycle;
+      }
+
+    private:
+      uint32_t m_hindex;
+      const Step *m_script;
+      std::vector<Event> *m_log;
+      uint32_t m_responses;
+      sc_core::sc_event m_response_event;
+      unsigned char m_data[32];
+  };
+
+  class BenchSlave : public AHBSlave<>, public CLKDevice {
+    public:
+      BenchSlave(ModuleName nm, uint32_t hindex, uint32_t haddr, uint32_t wait_states) :
+        AHBSlave<>(nm, hindex, 0x01, 0x00E, 0, 0, amba::amba_AT, BAR(AHBMEM, 0xFFF, true, true, haddr)),
+        m_wait_states(wait_states),
+        m_data(1 << 20, 0) {
+      }
+
+      uint32_t exec_func(tlm::tlm_generic_payload &trans, sc_core::sc_time &delay, bool debug) {  // NOLINT(runtime/references)
+        uint32_t addr = get_ahb_bar_relative_addr(0, trans.get_address());
+        uint32_t length = trans.get_data_length();
+        if (trans.is_write()) {
+          memcpy(&m_data[addr], trans.get_data_ptr(), length);
+        } else {
+          memcpy(trans.get_data_ptr(), &m_data[addr], length);
+        }
+        uint32_t words = (length < 4) ? 1 : (length >> 2);
+        delay += clock_cycle * (words + m_wait_states);
+        trans.set_response_status(tlm::TLM_OK_RESPONSE);
+        return length;
+      }
+
+      sc_core::sc_time get_clock() {
+        return clock_cycle;
+      }
+
+    private:
+      uint32_t m_wait_states;
+      std::vector<unsigned char> m_data;
+  };
+
+  /// Three masters, a zero wait state slave at 0x40000000 and a two wait
+  /// state slave at 0x50000000
+  class System : public sc_core::sc_module {
+    public:
+      System(sc_core::sc_module_name mn, bool rrobin, bool idlesleep) :
+        sc_core::sc_module(mn),
+        ahbctrl("ahbctrl", amba::amba_AT, 0xFFF, 0xFFF, 0xFF0, 0xFF0, rrobin),
+        fast("fast", 0, 0x400, 0),
+        slow("slow", 1, 0x500, 2),
+        master0("master0", 0, s_script0, &log),
+        master1("master1", 1, s_script1, &log),
+        master2("master2", 2, s_script2, &log) {
+        gs::cnf::cnf_api *mApi = gs::cnf::GCnf_Api::getApiInstance(NULL);
+        mApi->getPar(std::string(ahbctrl.name()) + ".generics.idlesleep")->setString(idlesleep ? "true" : "false");
+
+        master0.ahb(ahbctrl.ahbIN);
+        master1.ahb(ahbctrl.ahbIN);
+        master2.ahb(ahbctrl.ahbIN);
+        ahbctrl.ahbOUT(fast.ahb);
+        ahbctrl.ahbOUT(slow.ahb);
+
+        ahbctrl.set_clk(10, sc_core::SC_NS);
+        fast.set_clk(10, sc_core::SC_NS);
+        slow.set_clk(10, sc_core::SC_NS);
+        master0.set_clk(10, sc_core::SC_NS);
+        master1.set_clk(10, sc_core::SC_NS);
+        master2.set_clk(10, sc_core::SC_NS);
+      }
+
+      std::vector<Event> log;
+      AHBCtrl ahbctrl;
+      BenchSlave fast;
+      BenchSlave slow;
+      BenchMaster master0;
+      BenchMaster master1;
+      BenchMaster master2;
+  };
+
+  /// Compares the traces of both systems, returns the number of differences
+  uint32_t compare(const char *mode, std::vector<Event> reference, std::vector<Event> sleeping, bool verbose) {
+    // Events of different masters at the same time may be logged in any delta order
+    std::sort(reference.begin(), reference.end());
+    std::sort(sleeping.begin(), sleeping.end());
+
+    uint32_t errors = 0;
+    size_t count = std::max(reference.size(), sleeping.size());
+    for (size_t i = 0; i < count; ++i) {
+      bool has_ref = i < reference.size();
+      bool has_slp = i < sleeping.size();
+      bool equal = has_ref && has_slp && reference[i] == sleeping[i];
+      if (!equal) {
+        ++errors;
+      }
+      if (!equal || verbose) {
+        std::cout << mode << (equal ? "   " : " ! ");
+        if (has_ref) {
+          std::cout << (reference[i].phase ? "BEGIN_RESP" : "END_REQ   ") << " master " << reference[i].master <<
+            " at " << reference[i].time << " ps";
+        } else {
+          std::cout << "(none)";
+        }
+        if (!equal) {
+          std::cout << ", idle sleep: ";
+          if (has_slp) {
+            std::cout << (sleeping[i].phase ? "BEGIN_RESP" : "END_REQ") << " master " << sleeping[i].master <<
+              " at " << sleeping[i].time << " ps";
+          } else {
+            std::cout << "(none)";
+          }
+        }
+        std::cout << std::endl;
+      }
+    }
+    std::cout << mode << ": " << reference.size() << " events, " << errors << " differences" << std::endl;
+    return errors;
+  }
+}  // namespace
+
+int sc_main(int argc, char *argv[]) {
+  bool verbose = argc > 1 && std::string(argv[1]) == "-v";
+  System prio_ref("prio_ref", false, false);
+  System prio_sleep("prio_sleep", false, true);
+  System rrobin_ref("rrobin_ref", true, false);
+  System rrobin_sleep("rrobin_sleep", true, true);
+
+  // The reference arbiters never run out of events, all scripts end well before
+  sc_core::sc_start(20, sc_core::SC_US);
+
+  uint32_t errors = 0;
+  errors += compare("fixed priority", prio_ref.log, prio_sleep.log, verbose);
+  errors += compare("round robin", rrobin_ref.log, rrobin_sleep.log, verbose);
+  if (prio_ref.log.empty() || rrobin_ref.log.empty()) {
+    std::cout << "No bus traffic recorded" << std::endl;
+    ++errors;
+  }
+  return errors ? 1 : 0;
+}
+/// @}
@@ -0,0 +1,368 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup ahbdma
+/// @{
+/// @file ahbdma.cpp
+/// Implementation of the generic AHB DMA engine. Blocks are copied in
+/// bursts of up to g_burst bytes, sources inside memories are read through
+/// DMI in LT mode.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <algorithm>
+#include <cstring>
+
+#include "gaisler/ahbdma/ahbdma.h"
+#include "core/common/sr_report.h"
+#include "core/common/sr_registry.h"
+#include "core/common/vendian.h"
+
+SR_HAS_MODULE(AHBDMA);
+
+/// Constructor
+AHBDMA::AHBDMA(
+  ModuleName name,                             // The SystemC name of the component
+  AbstractionLayer ambaLayer,                  // TLM abstraction layer
+  unsigned int hindex,                         // The master index for registering with the AHB
+  unsigned int pindex,                         // APB bus slave index
+  unsigned int paddr,                          // APB bus slave address
+  unsigned int pmask,                          // APB bus slave mask
+  unsigned int pirq,                           // The number of the IRQ raised on completion
+  unsigned int burst,                          // Maximum length of a burst transaction in bytes
+  bool dmi,                                    // Use DMI to read from memories
+  bool powmon) :                               // Enable power monitoring
+    AHBMaster<APBSlave>(name,                  // SystemC name
+      hindex,                                  // Bus master index
+      0x04,                                    // Vender ID (4 = ESA)
+      0x00,                                    // Device ID (undefined)
+      0,                                       // Version
+      pirq,                                    // IRQ of device
+      ambaLayer),                              // AmbaLayer
+    irq("irq"),                                // Initialize interrupt output
+    g_burst("burst", burst, m_generics),
+    g_dmi("dmi", dmi, m_generics),
+    g_pow_mon("pow_mon", powmon, m_generics),
+    m_descriptors("descriptors", 0ull, m_counters),
+    m_bytes("bytes_copied", 0ull, m_counters),
+    m_dmi_accesses("dmi_accesses", 0ull, m_counters),
+    m_irq(pirq),
+    m_status(0),
+    m_kick(false),
+    m_response_ok(true),
+    m_buffer(NULL) {
+  assert("burst has to be between 4 and 1024 bytes" && burst >= 4 && burst <= 1024);
+
+  init_apb(pindex,
+    0x04,                                      // ven: ESA
+    0x00,                                      // dev: undefined
+    0, pirq,                                   // VER, IRQ
+    APBIO, pmask, false, false, paddr);
+
+  AHBDMA::init_generics();
+  AHBDMA::init_registers();
+
+  if (ambaLayer == amba::amba_LT) {
+    ahb.register_invalidate_direct_mem_ptr(this, &AHBDMA::invalidate_direct_mem_ptr);
+  }
+
+  // Register the ring processing thread
+  SC_THREAD(transfer);
+
+  // Configuration report
+  srInfo()
+    ("hindex", hindex)
+    ("pindex", pindex)
+    ("paddr", paddr)
+    ("pmask", pmask)
+    ("pirq", pirq)
+    ("burst", burst)
+    ("dmi", dmi)
+    ("pow_mon", powmon)
+    ("abstractionLayer", ambaLayer)
+    ("An AHBDMA is created with these generics");
+}
+
+AHBDMA::~AHBDMA() {
+  delete[] m_buffer;
+}
+
+void AHBDMA::init_generics() {
+  g_burst.add_properties()
+    ("name", "Burst Length")
+    ("range", "4..1024")
+    ("Maximum length of a burst transaction in bytes. Bursts never cross a 1 KB boundary.");
+
+  g_dmi.add_properties()
+    ("name", "Direct Memory Interface")
+    ("Read source blocks through DMI if the target grants it (LT only).");
+}
+
+// The burst length may still be changed by the configuration after construction
+void AHBDMA::end_of_elaboration() {
+  assert("burst has to be between 4 and 1024 bytes" && g_burst >= 4 && g_burst <= 1024);
+
+  // Transfer buffer for one burst
+  delete[] m_buffer;
+  m_buffer = new unsigned char[g_burst];
+}
+
+void AHBDMA::init_registers() {
+  r.create_register("ctrl", "Control Register",
+    CTRL,                                       // offset
+    0x00000000,                                 // init value
+    CTRL_EN | CTRL_IE)                          // write mask
+  .callback(SR_POST_WRITE, this, &AHBDMA::ctrl_write);
+
+  r.create_register("status", "Status Register",
+    STATUS,                                     // offset
+    0x00000000,                                 // init value
+    STATUS_DONE | STATUS_ERR)                   // write mask (write one to clear)
+  .callback(SR_PRE_READ, this, &AHBDMA::status_read)
+  .callback(SR_POST_WRITE, this, &AHBDMA::status_write);
+
+  r.create_register("desc", "Descriptor Ring Base Address",
+    DESC,                                       // offset
+    0x00000000,                                 // init value
+    ~(DESC_SIZE - 1))                           // write mask
+  .callback(SR_POST_WRITE, this, &AHBDMA::desc_write);
+
+  r.create_register("curdesc", "Current Descriptor Address",
+    CURDESC,                                    // offset
+    0x00000000,                                 // init value
+    0x00000000);                                // write mask
+}
+
+// Reset handler
+void AHBDMA::dorst() {
+  r[CTRL] = 0;
+  r[STATUS] = 0;
+  r[DESC] = 0;
+  r[CURDESC] = 0;
+  m_status = 0;
+  m_kick = false;
+}
+
+void AHBDMA::ctrl_write() {
+  if (r[CTRL] & CTRL_EN) {
+    m_kick = true;
+    e_start.notify();
+  }
+}
+
+void AHBDMA::status_read() {
+  r[STATUS] = m_status;
+}
+
+void AHBDMA::status_write() {
+  m_status &= ~(r[STATUS] & (STATUS_DONE | STATUS_ERR));
+  r[STATUS] = m_status;
+}
+
+void AHBDMA::desc_write() {
+  r[CURDESC] = r[DESC];
+}
+
+// Walks the descriptor ring. A descriptor belongs to the engine while its
+// EN bit is set, the engine clears it after the copy. The ring ends at the
+// first descriptor without EN, software restarts it by writing CTRL.EN again.
+void AHBDMA::transfer() {
+  uint32_t desc[DESC_SIZE / 4];
+
+  while (1) {
+    if (!(r[CTRL] & CTRL_EN)) {
+      wait(e_start);
+      continue;
+    }
+    m_status |= STATUS_ACTIVE;
+    m_kick = false;
+
+    // Fetch the descriptor in one burst
+    uint32_t addr = r[CURDESC];
+    if (!bus_read(addr, reinterpret_cast<unsigned char *>(desc), DESC_SIZE)) {
+      srWarn()("addr", addr)("Bus error reading descriptor");
+      m_status = (m_status & ~STATUS_ACTIVE) | STATUS_ERR;
+      r[CTRL] = r[CTRL] & ~CTRL_EN;
+      if (r[CTRL] & CTRL_IE) {
+        raise_irq();
+      }
+      continue;
+    }
+    for (uint32_t i = 0; i < DESC_SIZE / 4; i++) {
+      swap_Endianess(desc[i]);
+    }
+
+    if (!(desc[0] & DESC_EN)) {
+      // End of the ring, wait for software unless it was restarted meanwhile
+      m_status &= ~STATUS_ACTIVE;
+      if (!m_kick) {
+        wait(e_start);
+      }
+      continue;
+    }
+
+    uint32_t length = desc[0] & DESC_LEN;
+    V_LOG(m_verbosity, v::debug) << name() << "Descriptor " << v::uint32 << addr << ": copy " << v::dec << length
+                                 << " bytes from " << v::uint32 << desc[1] << " to " << v::uint32 << desc[2] << v::endl;
+    bool ok = copy(desc[1], desc[2], length);
+
+    // Hand the descriptor back to software
+    uint32_t ctrl = desc[0] & ~DESC_EN;
+    if (!ok) {
+      ctrl |= DESC_ERR;
+    }
+    swap_Endianess(ctrl);
+    if (!bus_write(addr, reinterpret_cast<unsigned char *>(&ctrl), 4)) {
+      ok = false;
+    }
+    r[CURDESC] = (desc[0] & DESC_WRAP) ? r[DESC] : addr + DESC_SIZE;
+    m_descriptors++;
+
+    if (!ok) {
+      srWarn()("addr", addr)("Bus error during transfer");
+      m_status = (m_status & ~STATUS_ACTIVE) | STATUS_ERR;
+      r[CTRL] = r[CTRL] & ~CTRL_EN;
+      if (r[CTRL] & CTRL_IE) {
+        raise_irq();
+      }
+    } else if (desc[0] & DESC_IE) {
+      m_status |= STATUS_DONE;
+      if (r[CTRL] & CTRL_IE) {
+        raise_irq();
+      }
+    }
+  }
+}
+
+// Copies the block in bursts. AHB bursts must not cross a 1 KB boundary,
+// which also keeps every burst inside one slave.
+bool AHBDMA::copy(uint32_t src, uint32_t dst, uint32_t length) {
+  const uint32_t burst = g_burst;
+
+  while (length) {
+    uint32_t chunk = std::min(length, burst);
+    chunk = std::min(chunk, 0x400 - (src & 0x3FF));
+    chunk = std::min(chunk, 0x400 - (dst & 0x3FF));
+
+    if (!dmi_read(src, m_buffer, chunk) && !bus_read(src, m_buffer, chunk)) {
+      return false;
+    }
+    // Writes always use the bus, so the AHBCtrl snoops them for the caches
+    if (!bus_write(dst, m_buffer, chunk)) {
+      return false;
+    }
+    src += chunk;
+    dst += chunk;
+    length -= chunk;
+    m_bytes += chunk;
+  }
+  return true;
+}
+
+bool AHBDMA::bus_read(uint32_t addr, unsigned char *data, uint32_t length) {
+  sc_core::sc_time delay = SC_ZERO_TIME;
+  tlm::tlm_response_status response;
+  bool cacheable;
+
+  ahbread(addr, data, length, delay, cacheable, response);
+  // In AT mode the data phase completes after ahbread returned
+  if (m_ambaLayer == amba::amba_AT) {
+    wait(e_response);
+  }
+  return m_response_ok;
+}
+
+bool AHBDMA::bus_write(uint32_t addr, unsigned char *data, uint32_t length) {
+  sc_core::sc_time delay = SC_ZERO_TIME;
+  tlm::tlm_response_status response;
+
+  ahbwrite(addr, data, length, delay, response);
+  // In AT mode the response status is known after the data phase
+  if (m_ambaLayer == amba::amba_AT) {
+    wait(e_response);
+    return m_response_ok;
+  }
+  return response == tlm::TLM_OK_RESPONSE;
+}
+
+// Called for every read, in LT mode before ahbread returns.
+// In AT mode it is called for writes as well.
+void AHBDMA::response_callback(tlm::tlm_generic_payload *trans) {
+  m_response_ok = trans->is_response_ok();
+  e_response.notify();
+}
+
+// Serves a read from a DMI region. Regions are requested once per 1 MB area,
+// areas of slaves refusing DMI are remembered.
+bool AHBDMA::dmi_read(uint32_t addr, unsigned char *data, uint32_t length) {
+  if (!g_dmi || (m_ambaLayer != amba::amba_LT)) {
+    return false;
+  }
+
+  for (std::vector<tlm::tlm_dmi>::iterator region = m_dmi_regions.begin(); region != m_dmi_regions.end(); ++region) {
+    if ((addr >= region->get_start_address()) && (addr + length - 1 <= region->get_end_address())) {
+      memcpy(data, region->get_dmi_ptr() + (addr - region->get_start_address()), length);
+      wait(region->get_read_latency() + (1 + ((length - 1) >> 2)) * clock_cycle);
+      m_reads += length;
+      m_dmi_accesses++;
+      return true;
+    }
+  }
+
+  if (m_dmi_denied.count(addr >> 20)) {
+    return false;
+  }
+
+  tlm::tlm_generic_payload gp;
+  tlm::tlm_dmi dmi;
+  gp.set_command(tlm::TLM_READ_COMMAND);
+  gp.set_address(addr);
+  gp.set_data_length(length);
+  dmi.init();
+
+  if (ahb->get_direct_mem_ptr(gp, dmi) && dmi.is_read_allowed() &&
+      (addr >= dmi.get_start_address()) && (addr + length - 1 <= dmi.get_end_address())) {
+    m_dmi_regions.push_back(dmi);
+    V_LOG(m_verbosity, v::debug) << name() << "Acquired DMI region " << v::uint64 << dmi.get_start_address()
+                                 << " - " << v::uint64 << dmi.get_end_address() << v::endl;
+    return dmi_read(addr, data, length);
+  }
+  m_dmi_denied.insert(addr >> 20);
+  return false;
+}
+
+void AHBDMA::invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range) {
+  std::vector<tlm::tlm_dmi>::iterator region = m_dmi_regions.begin();
+  while (region != m_dmi_regions.end()) {
+    if ((region->get_start_address() <= end_range) && (region->get_end_address() >= start_range)) {
+      region = m_dmi_regions.erase(region);
+    } else {
+      ++region;
+    }
+  }
+
+  // The memory map may have changed
+  m_dmi_denied.clear();
+}
+
+// Notify the CPU by a pulse of one clock cycle
+void AHBDMA::raise_irq() {
+  irq.write(std::pair<uint32_t, bool>(1 << m_irq, true));
+  wait(clock_cycle);
+  irq.write(std::pair<uint32_t, bool>(1 << m_irq, false));
+}
+
+// Helper for setting clock cycle latency using a value-time_unit pair
+void AHBDMA::clkcng() {
+  // nothing to do
+}
+
+sc_core::sc_time AHBDMA::get_clock() {
+  return clock_cycle;
+}
+
+/// @}
@@ -0,0 +1,184 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup ahbdma AHB DMA Engine
+/// @{
+/// @file ahbdma.h
+/// Class definition of a generic AHB DMA engine. The engine walks a ring of
+/// descriptors in memory and copies each described block in burst
+/// transactions of g_burst bytes. It is programmed over APB and raises an
+/// interrupt after descriptors which request it.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef MODELS_AHBDMA_AHBDMA_H_
+#define MODELS_AHBDMA_AHBDMA_H_
+
+#include <tlm.h>
+#include <set>
+#include <vector>
+
+#include "core/common/ahbmaster.h"
+#include "core/common/apbslave.h"
+#include "core/common/clkdevice.h"
+#include "core/common/sr_param.h"
+#include "core/common/sr_signal.h"
+#include "core/common/verbose.h"
+
+/// Definition of class AHBDMA
+class AHBDMA : public AHBMaster<APBSlave>, public CLKDevice {
+  public:
+    SC_HAS_PROCESS(AHBDMA);
+    SR_HAS_SIGNALS(AHBDMA);
+
+    /// SignalKit interrupt output
+    signal<std::pair<uint32_t, bool> >::out irq;
+
+    /// Constructor
+    AHBDMA(
+      ModuleName name,             ///< The SystemC name of the component
+      AbstractionLayer ambaLayer = amba::amba_LT,  ///< TLM abstraction layer
+      unsigned int hindex = 0,     ///< The master index for registering with the AHB
+      unsigned int pindex = 0,     ///< APB bus slave index
+      unsigned int paddr = 0,      ///< APB bus slave address
+      unsigned int pmask = 0xFFF,  ///< APB bus slave mask
+      unsigned int pirq = 0,       ///< The number of the IRQ raised on completion
+      unsigned int burst = 1024,   ///< Maximum length of a burst transaction in bytes
+      bool dmi = true,             ///< Use DMI to read from memories (LT only)
+      bool powmon = false          ///< Enable power monitoring
+    );
+
+    /// Free the transfer buffer
+    ~AHBDMA();
+
+    /// Initialize the generics with meta data
+    void init_generics();
+
+    /// Initialize the register file
+    void init_registers();
+
+    /// Allocates the transfer buffer for the final burst length
+    void end_of_elaboration();
+
+    /// Processes the descriptor ring while the engine is enabled
+    void transfer();
+
+    /// Register callback, starts the engine
+    void ctrl_write();
+
+    /// Register callback, updates the status before reads
+    void status_read();
+
+    /// Register callback, clears the written status bits
+    void status_write();
+
+    /// Register callback, restarts the ring at its base address
+    void desc_write();
+
+    /// Notifies the transfer thread about AT responses
+    void response_callback(tlm::tlm_generic_payload *trans);
+
+    /// Drops cached DMI regions overlapping the given range
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range);
+
+    /// Reset function
+    void dorst();
+
+    /// Deal with clock changes
+    void clkcng();
+
+    sc_core::sc_time get_clock();
+
+    /// Register offsets
+    static const uint32_t CTRL           = 0x00;
+    static const uint32_t STATUS         = 0x04;
+    static const uint32_t DESC           = 0x08;
+    static const uint32_t CURDESC        = 0x0C;
+
+    /// Control register bits
+    static const uint32_t CTRL_EN        = 0x00000001;
+    static const uint32_t CTRL_IE        = 0x00000002;
+
+    /// Status register bits
+    static const uint32_t STATUS_ACTIVE  = 0x00000001;
+    static const uint32_t STATUS_DONE    = 0x00000002;
+    static const uint32_t STATUS_ERR     = 0x00000004;
+
+    /// Descriptor control word: owned by the engine, irq, wrap, error, length
+    static const uint32_t DESC_EN        = 0x80000000;
+    static const uint32_t DESC_IE        = 0x40000000;
+    static const uint32_t DESC_WRAP      = 0x20000000;
+    static const uint32_t DESC_ERR       = 0x10000000;
+    static const uint32_t DESC_LEN       = 0x00FFFFFF;
+
+    /// Descriptor size in bytes (ctrl, source, destination, reserved)
+    static const uint32_t DESC_SIZE      = 16;
+
+  private:
+    /// Copies one block, returns false on a bus error
+    bool copy(uint32_t src, uint32_t dst, uint32_t length);
+
+    /// Blocking bus read, waits for the data in AT mode as well
+    bool bus_read(uint32_t addr, unsigned char *data, uint32_t length);
+
+    /// Blocking bus write, waits for the response in AT mode as well
+    bool bus_write(uint32_t addr, unsigned char *data, uint32_t length);
+
+    /// Reads from a DMI region, returns false if the bus has to be used
+    bool dmi_read(uint32_t addr, unsigned char *data, uint32_t length);
+
+    /// Raise the completion interrupt for one clock cycle
+    void raise_irq();
+
+    /// Maximum length of a burst transaction in bytes
+    sr_param<uint32_t> g_burst;
+
+    /// Use direct memory access for source reads (LT only)
+    sr_param<bool> g_dmi;
+
+    /// Enable power monitoring
+    sr_param<bool> g_pow_mon;
+
+    /// Number of descriptors completed
+    sr_param<uint64_t> m_descriptors;
+
+    /// Number of bytes copied
+    sr_param<uint64_t> m_bytes;
+
+    /// Number of bursts read through DMI
+    sr_param<uint64_t> m_dmi_accesses;
+
+    /// IRQ number
+    const uint32_t m_irq;
+
+    /// Status bits (STATUS register)
+    uint32_t m_status;
+
+    /// The engine was started while it was reading a descriptor
+    bool m_kick;
+
+    /// Result of the last access, set by response_callback
+    bool m_response_ok;
+
+    /// Transfer buffer of g_burst bytes
+    unsigned char *m_buffer;
+
+    /// Notified by the register callbacks to (re)start the ring
+    sc_event e_start;
+
+    /// Notified when an AT response arrived
+    sc_event e_response;
+
+    /// DMI regions acquired from the bus
+    std::vector<tlm::tlm_dmi> m_dmi_regions;
+
+    /// 1 MB AHB areas, which refused DMI
+    std::set<uint32_t> m_dmi_denied;
+};
+
+#endif  // MODELS_AHBDMA_AHBDMA_H_
+/// @}
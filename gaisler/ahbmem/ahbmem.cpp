@@ -17,7 +17,9 @@
 /// a correct slave select but exceeding the memory region due to their length
 /// are reported as warning and executed anyhow.
 
+#include <algorithm>
 #include <fstream>
+#include <vector>
 
 #include "gaisler/ahbmem/ahbmem.h"
 #include "core/common/sr_report.h"
@@ -193,7 +195,7 @@ void AHBMem::init_generics() {
 
   g_storage_type.add_properties()
     ("name", "Memory Storage Type")
-    ("enum", "ArrayStorage, MapStorage")
+    ("enum", "ArrayStorage, MapStorage, PagedStorage")
     ("Defines the type of memory used as a backend implementation");
 }
 
@@ -281,10 +283,13 @@ sc_core::sc_time AHBMem::get_clock() {
 
 bool AHBMem::get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data) {
   // access to ROM adress space
+  uint32_t start = 0;
+  uint32_t end = 0;
+  uint8_t *ptr = m_storage->get_dmi_range(get_ahb_bar_relative_addr(0, trans.get_address()), start, end);
   dmi_data.allow_read_write();
-  dmi_data.set_dmi_ptr(m_storage->get_dmi_ptr());
-  dmi_data.set_start_address(0);
-  dmi_data.set_end_address(get_ahb_bar_size(0));
+  dmi_data.set_dmi_ptr(ptr);
+  dmi_data.set_start_address(get_ahb_base_addr() + start);
+  dmi_data.set_end_address(get_ahb_base_addr() + end);
   dmi_data.set_read_latency(SC_ZERO_TIME);
   dmi_data.set_write_latency(SC_ZERO_TIME);
   v::info << name() << "allow_dmi_rw is: " << v::uint32 << m_storage->allow_dmi_rw() << v::endl;
@@ -299,6 +304,65 @@ void AHBMem::end_of_elaboration() {
   set_storage(g_storage_type, get_ahb_bar_size(0));
 }
 
+// Save the storage content in 4 kB blocks, only blocks with non-zero bytes
+// are put into the archive. Same layout as Memory::checkpoint_save.
+void AHBMem::checkpoint_save(CheckpointArchive &ar) {
+  static const uint32_t block = 4096;
+  uint32_t size = get_ahb_bar_size(0);
+  std::vector<uint32_t> offsets;
+  std::vector<uint8_t> data;
+  std::vector<uint8_t> buffer(block);
+
+  for (uint64_t offset = 0; offset < size; offset += block) {
+    uint32_t len = std::min<uint64_t>(block, size - offset);
+    read_block_dbg(offset, &buffer[0], len);
+    for (uint32_t i = 0; i < len; ++i) {
+      if (buffer[i]) {
+        offsets.push_back(offset);
+        data.insert(data.end(), buffer.begin(), buffer.begin() + len);
+        break;
+      }
+    }
+  }
+
+  ar.put("size", size);
+  ar.put("offsets", offsets.empty() ? NULL : &offsets[0], offsets.size() * sizeof(uint32_t));
+  ar.put("data", data.empty() ? NULL : &data[0], data.size());
+}
+
+// Restore the storage content saved by checkpoint_save
+void AHBMem::checkpoint_restore(const CheckpointArchive &ar) {
+  static const uint32_t block = 4096;
+  uint32_t size = get_ahb_bar_size(0);
+  uint32_t saved_size = 0;
+
+  if (!ar.get("size", saved_size) || saved_size != size) {
+    srWarn()
+      ("size", size)
+      ("saved_size", saved_size)
+      ("Memory size differs from checkpoint, content not restored");
+    return;
+  }
+
+  std::vector<uint8_t> offsets;
+  std::vector<uint8_t> data;
+  if (!ar.get("offsets", offsets) || !ar.get("data", data)) {
+    return;
+  }
+
+  erase_dbg(0, size);
+  const uint32_t *offset = reinterpret_cast<const uint32_t *>(offsets.empty() ? NULL : &offsets[0]);
+  uint64_t pos = 0;
+  for (uint32_t i = 0; i < offsets.size() / sizeof(uint32_t); ++i) {
+    uint32_t len = std::min<uint64_t>(block, size - offset[i]);
+    if (pos + len > data.size()) {
+      break;
+    }
+    write_block_dbg(offset[i], &data[pos], len);
+    pos += len;
+  }
+}
+
 // Automatically called at the beginning of the simulation
 void AHBMem::start_of_simulation() {
   // Initialize power model
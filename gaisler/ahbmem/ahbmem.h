@@ -33,8 +33,9 @@
 #include "core/common/clkdevice.h"
 #include "gaisler/memory/basememory.h"
 #include "core/common/msclogger.h"
+#include "core/common/checkpoint.h"
 
-class AHBMem : public AHBSlave<>, public CLKDevice, public BaseMemory{
+class AHBMem : public AHBSlave<>, public CLKDevice, public BaseMemory, public Checkpointable {
   public:
     GC_HAS_CALLBACKS();
     SC_HAS_PROCESS(AHBMem);
@@ -124,6 +125,12 @@ class AHBMem : public AHBSlave<>, public CLKDevice, public BaseMemory{
     /// Generates execution statistic at end of simulation
     void end_of_simulation();
 
+    /// Save the non-zero parts of the memory content
+    void checkpoint_save(CheckpointArchive &ar);  // NOLINT(runtime/references)
+
+    /// Restore the memory content saved by checkpoint_save
+    void checkpoint_restore(const CheckpointArchive &ar);
+
     const char* get_name() const {
       return this->name();
     }
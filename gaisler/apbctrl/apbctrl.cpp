@@ -12,10 +12,12 @@
 /// @author Thomas Schuster
 ///
 
+#include <cstring>
 #include <map>
 #include <utility>
 
 #include "gaisler/apbctrl/apbctrl.h"
+#include "core/common/apbslave.h"
 #include "core/common/vendian.h"
 #include "core/common/verbose.h"
 #include "core/common/sr_report.h"
@@ -75,12 +77,9 @@ APBCtrl::APBCtrl(
     ("ambaLayer", ambaLayer)
     ("Created an APBCtrl with this parameters");
 
-  // initialize the slave_map_cache with some bogus numbers which will trigger MISS
-  slave_info_t tmp;
-  tmp.pindex = 0;
-  tmp.pmask  = ~0;
-  tmp.binding = ~0;
-  slave_map_cache = std::pair<uint32_t, slave_info_t>(~0, tmp);
+  // Nothing is mapped before start_of_simulation
+  memset(m_decode, -1, sizeof(m_decode));
+  memset(m_burst, 0, sizeof(m_burst));
 }
 
 // Reset handler
@@ -115,31 +114,29 @@ void APBCtrl::setAddressMap(const uint32_t binding, const uint32_t pindex, const
   slave_map.insert(std::pair<uint32_t, slave_info_t>(paddr, tmp));
 }
 
+/// Expands slave_map into the flat decoder table.
+/// Slaves are applied in ascending address order, so in case of an
+/// overlap the slave with the higher BAR address wins like in the map lookup.
+void APBCtrl::build_decoder() {
+  memset(m_decode, -1, sizeof(m_decode));
+  for (std::map<uint32_t, slave_info_t>::iterator it = slave_map.begin(); it != slave_map.end(); ++it) {
+    for (uint32_t segment = 0; segment < 4096; segment++) {
+      // APB: Device == BAR
+      if (!((segment ^ it->first) & it->second.pmask)) {
+        m_decode[segment] = static_cast<int8_t>(it->second.binding);
+      }
+    }
+  }
+}
+
 /// Find slave index by address
 int APBCtrl::get_index(const uint32_t address) {
   // Use 12 bit segment address for decoding
-  uint32_t addr = (address >> 8) & 0xfff;
-
-  slave_info_t info = slave_map_cache.second;
-  if ( ! ((addr ^ slave_map_cache.first) & info.pmask) ) {
-    // APB: Device == BAR)
+  int index = m_decode[(address >> 8) & 0xfff];
+  if (index >= 0) {
     m_right_transactions++;
-    return slave_map_cache.second.binding;
   }
-
-  std::map<uint32_t, slave_info_t>::iterator it = --(slave_map.upper_bound( addr ));
-  info = it->second;
-  if ( ! ((addr ^ it->first) & info.pmask) ) {
-    // MISS in the cache: update cache
-    slave_map_cache = *it;
-    
-    // APB: Device == BAR)
-    m_right_transactions++;
-    return it->second.binding;
-  }
-
-  // no slave found
-  return -1;
+  return index;
 }
 
 // Returns a PNP register from the APB configuration area (upper 4kb of address space)
@@ -208,24 +205,40 @@ uint32_t APBCtrl::exec_func(
     return ahb_gp.get_data_length();
   }
 
-  // Split up transaction into multiple 32bit APB accesses
-  for (i = 0;i < length; i+=4) {
+  // Find slave by address / returns slave index or -1 for not mapped
+  int index = get_index(addr);
+
+  // Accesses which stay within one register bank are forwarded as a single
+  // transaction, all others are split up into multiple 32bit APB accesses.
+  uint32_t step = 4;
+  if ((length > 4) && (index >= 0) && m_burst[index] && !(addr & 0x3) && !(length & 0x3)) {
+    step = length;
+    for (uint32_t segment = (addr >> 8) + 1; segment <= ((addr + length - 1) >> 8); segment++) {
+      if (m_decode[segment & 0xfff] != index) {
+        step = 4;
+        break;
+      }
+    }
+  }
 
-    // Find slave by address / returns slave index or -1 for not mapped
-    int index = get_index(addr+i);  
+  for (i = 0; i < length; i += step) {
+
+    if (i) {
+      index = get_index(addr + i);
+    }
 
     // For valid slave index
     if(index >= 0) {
 
-      // -- For Debug only --
-      uint32_t a = 0;
-      socket_t *other_socket = apb.get_other_side(index, a);
-      sc_core::sc_object *obj = other_socket->get_parent();
+      V_IF(m_verbosity, v::debug) {
+        uint32_t a = 0;
+        socket_t *other_socket = apb.get_other_side(index, a);
+        sc_core::sc_object *obj = other_socket->get_parent();
 
-      v::debug << name() << "Forwarding request to APB slave:" << obj->name()
-         << "@0x" << hex << v::setfill('0') << v::setw(8)
-         << ((ahb_gp.get_address() & 0x000fffff)+i) << endl;
-      // --------------------
+        v::unfiltered(v::debug) << name() << "Forwarding request to APB slave:" << obj->name()
+           << "@0x" << hex << v::setfill('0') << v::setw(8)
+           << ((ahb_gp.get_address() & 0x000fffff)+i) << endl;
+      }
 
       // Take APB transaction from pool
       apb_gp = apb.get_transaction();
@@ -239,7 +252,7 @@ uint32_t APBCtrl::exec_func(
       apb_gp->set_command(ahb_gp.get_command());
       // Substract the base address of the bridge
       apb_gp->set_address((ahb_gp.get_address() & 0x000fffff)+i);
-      apb_gp->set_data_length(( length <=4 ) ? length : 4); 
+      apb_gp->set_data_length((step < length) ? 4 : length);
       apb_gp->set_byte_enable_ptr(ahb_gp.get_byte_enable_ptr());
       apb_gp->set_data_ptr(ahb_gp.get_data_ptr()+i);
 
@@ -252,8 +265,8 @@ uint32_t APBCtrl::exec_func(
 
         apb[index]->b_transport(*apb_gp, delay);
 
-        // Add delay for APB setup cycle
-        delay += clock_cycle;
+        // Add delay for APB setup cycle (one per word)
+        delay += clock_cycle * ((apb_gp->get_data_length() + 3) >> 2);
 
         // Power Calculation
         if (g_pow_mon) {
@@ -346,6 +359,9 @@ void APBCtrl::start_of_simulation() {
         // insert slave region into memory map
         setAddressMap(i, sbusid, addr, mask);
       }
+
+      // Register banks of APBSlave handle word blocks in one transaction
+      m_burst[i] = dynamic_cast<APBSlave *>(obj) != NULL;
     } else {
       v::warn << name() << "Slave bound to socket 'apb' is not a valid APBDevice." << v::endl;
       assert(0);
@@ -355,6 +371,8 @@ void APBCtrl::start_of_simulation() {
   // End of decoder initialization
   v::info << name() << "******************************************************************************* " << v::endl;
 
+  build_decoder();
+
   // Check memory map for overlaps
   if (g_mcheck) {
     checkMemMap();
@@ -132,7 +132,16 @@ class APBCtrl : public AHBSlave<>, public CLKDevice {
 
     /// Address decoder table (slave index, (bar addr, mask))
     std::map<uint32_t, slave_info_t> slave_map;
-    std::pair<uint32_t, slave_info_t> slave_map_cache;
+
+    /// Flat decoder built from slave_map: binding for each 256 byte
+    /// segment of the bridge (address bits 19:8), -1 if unmapped
+    int8_t m_decode[4096];
+
+    /// Bindings which accept multi-word transactions (sr_register banks)
+    bool m_burst[16];
+
+    /// Fill m_decode from slave_map
+    void build_decoder();
 
     // Event queue for AT mode
     tlm_utils::peq_with_get<tlm::tlm_generic_payload> m_AcceptPEQ;
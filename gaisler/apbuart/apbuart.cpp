@@ -35,7 +35,13 @@ APBUART::APBUART(ModuleName name,
   g_backend("backend", uart_backend, m_generics),
   powermon(powmon) {
   SC_THREAD(send_irq);
-  SC_THREAD(uart_ticks);
+  SC_THREAD(uart_receive);
+  SC_METHOD(uart_transmit);
+  sensitive << e_tx;
+  dont_initialize();
+  SC_METHOD(uart_flush);
+  sensitive << e_flush;
+  dont_initialize();
   send_buffer = 0;
   recv_buffer_start = 0;
   recv_buffer_end = 0;
@@ -104,8 +110,8 @@ void APBUART::data_read() {
   uint32_t reg = 0;
   if ((recv_buffer_level > 0) && ((r[CONTROL] & 1) == 1)) {  // CONTROL receiver enable
     recv_buffer_level -= 1;
-    reg = (uint32_t)recv_buffer[recv_buffer_end];
-    inc_fifo_level(&recv_buffer_end);
+    reg = (uint32_t)recv_buffer[recv_buffer_start];
+    inc_fifo_level(&recv_buffer_start);
     r[DATA] = reg;
     //v::info << name() << "Received char: " << reg << v::endl;
     if (((r[CONTROL] & (1<<2)) != 0) && (recv_buffer_level > 0)) {    // CONTROL receiver interrupt enable
@@ -121,12 +127,16 @@ void APBUART::data_write() {
   reg = r[DATA];
   c = static_cast<char>(reg & 0xFF);
   //v::info << name() << "write to data: " << c << v::endl;
+  e_flush.cancel();
   if (((r[CONTROL] & (1<<1)) != 0)) {
     if (send_buffer >= fifosize) {
       overrun = true;
       //v::info << name() << "missed char due to overrun" << v::endl;
     } else {
       m_backend->sendChar(c);
+      if (send_buffer == 0) {
+        e_tx.notify(char_time());
+      }
       send_buffer += 1;
       update_level_int();
       //v::info << name() << "sent char to backend" << v::endl;
@@ -134,6 +144,7 @@ void APBUART::data_write() {
   } else {
       // print even if transmitter disabled
       m_backend->sendChar(c);
+      e_flush.notify(char_time() * fifosize);
   }
 }
 
@@ -163,6 +174,9 @@ void APBUART::status_read() {
 
 void APBUART::control_write() {
   //v::info << name() << "Control write: " << v::uint32 << uint32_t(r[CONTROL]) << v::endl;
+  if (receive_enabled()) {
+    e_rx.notify();
+  }
 }
 
 void APBUART::control_read() {
@@ -181,27 +195,62 @@ void APBUART::send_irq() {
   }
 }
 
-void APBUART::uart_ticks() {
-  bool trigger_irq = false;
+sc_core::sc_time APBUART::char_time() {
+  uint32_t wait_value = 10000;
+  if (r[SCALER] != 0) {
+    wait_value = r[SCALER] * 8;
+  }
+  return clock_cycle * wait_value;
+}
+
+bool APBUART::receive_enabled() {
+  return m_backend && m_backend->canReceive() && ((r[CONTROL] & (1<<2)) != 0);
+}
+
+// Only scheduled while characters are in the transmit FIFO
+void APBUART::uart_transmit() {
+  if (send_buffer == 0) {
+    return;
+  }
+  if (((r[CONTROL] & (1<<3)) != 0) && (send_buffer == 1)) {
+    e_irq.notify();
+    //v::info << name() << "trigger interrupt because send and fifo empty" << v::endl;
+  }
+  send_buffer -= 1;
+  //v::info << name() << "virtually sent char" << v::endl;
+  update_level_int();
+  if (send_buffer > 0) {
+    e_tx.notify(char_time());
+  } else {
+    // Write out when the software did not send more for a while
+    e_flush.notify(char_time() * fifosize);
+  }
+}
+
+void APBUART::uart_flush() {
+  m_backend->flush();
+}
+
+void APBUART::uart_receive() {
+  // Character times between two polls, grows while the host sends nothing
+  uint32_t idle = 1;
   while (true) {
-    uint32_t wait_value = 10000;
-    if (r[SCALER] != 0) {
-      wait_value = r[SCALER] * 8;
+    if (!receive_enabled()) {
+      wait(e_rx);
+      idle = 1;
+      continue;
     }
-    wait(clock_cycle * wait_value);
-    trigger_irq = false;
-    if (send_buffer > 0) {
-      if (((r[CONTROL] & (1<<3)) != 0) && (send_buffer == 1)) {
-        trigger_irq = true;
-        //v::info << name() << "trigger interrupt because send and fifo empty" << v::endl;
+    wait(char_time() * idle);
+    if (m_backend->receivedChars() == 0) {
+      if (idle < fifosize) {
+        idle <<= 1;
       }
-      send_buffer -= 1;
-      //v::info << name() << "virtually sent char" << v::endl;
-      update_level_int();
+      continue;
     }
-    if ((m_backend->receivedChars() > 0) && (recv_buffer_level < fifosize) && ((r[CONTROL] & (1<<2)) != 0)) {
+    idle = 1;
+    if ((recv_buffer_level < fifosize) && receive_enabled()) {
       if (recv_buffer_level == 0) {
-        trigger_irq = true;
+        e_irq.notify();
         //v::info << name() << "trigger interrupt, received char and fifo was empty" << v::endl;
       }
       recv_buffer_level += 1;
@@ -209,12 +258,7 @@ void APBUART::uart_ticks() {
       inc_fifo_level(&recv_buffer_end);
       //v::info << name() << "put char in recv-fifo" << v::endl;
     }
-    if (trigger_irq) {
-      e_irq.notify();
-      //v::info << name() << "triggered interrupt"  << v::endl;
-    }
   }
-
 }
 
 void APBUART::update_level_int() {
@@ -233,7 +277,7 @@ void APBUART::update_level_int() {
 }
 
 void APBUART::inc_fifo_level(uint32_t *counter) {
-  if (*counter < fifosize) {
+  if (*counter < fifosize - 1) {
     *counter += 1;
   } else {
     *counter = 0;
@@ -243,6 +287,39 @@ void APBUART::inc_fifo_level(uint32_t *counter) {
 void APBUART::dorst() {
 }
 
+void APBUART::checkpoint_save(CheckpointArchive &ar) {
+  ar.put("data", r[DATA].read());
+  ar.put("control", r[CONTROL].read());
+  ar.put("scaler", r[SCALER].read());
+  ar.put("overrun", overrun);
+  ar.put("send_buffer", send_buffer);
+  ar.put("recv_buffer_level", recv_buffer_level);
+  ar.put("recv_buffer_start", recv_buffer_start);
+  ar.put("recv_buffer_end", recv_buffer_end);
+  ar.put("recv_buffer", recv_buffer, sizeof(recv_buffer));
+}
+
+void APBUART::checkpoint_restore(const CheckpointArchive &ar) {
+  uint32_t value = 0;
+  if (ar.get("data", value)) r[DATA] = value;
+  if (ar.get("control", value)) r[CONTROL] = value;
+  if (ar.get("scaler", value)) r[SCALER] = value;
+  ar.get("overrun", overrun);
+  ar.get("send_buffer", send_buffer);
+  ar.get("recv_buffer_level", recv_buffer_level);
+  ar.get("recv_buffer_start", recv_buffer_start);
+  ar.get("recv_buffer_end", recv_buffer_end);
+  ar.get("recv_buffer", recv_buffer, sizeof(recv_buffer));
+  // Drive the transmitter level interrupt for the restored fill level
+  update_level_int();
+  if (send_buffer > 0) {
+    e_tx.notify(char_time());
+  }
+  if (receive_enabled()) {
+    e_rx.notify();
+  }
+}
+
 void APBUART::before_end_of_elaboration() {
   sc_core::sc_object *obj = SrModuleRegistry::create_object_by_name("UARTBackend", g_backend, "backend");
   m_backend = dynamic_cast<io_if *>(obj);
@@ -253,4 +330,11 @@ void APBUART::before_end_of_elaboration() {
   }
 }
 
+// Output without a trailing newline would stay in the backend otherwise
+void APBUART::end_of_simulation() {
+  if (m_backend) {
+    m_backend->flush();
+  }
+}
+
 /// @}
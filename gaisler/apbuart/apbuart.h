@@ -27,10 +27,11 @@
 #include "core/common/sr_signal.h"
 #include "core/common/verbose.h"
 #include "core/common/apbslave.h"
+#include "core/common/checkpoint.h"
 
 /// @brief This class is a TLM 2.0 Model of the Aeroflex Gaisler GRLIB APBUART.
 /// Further informations to the original VHDL Modle are available in the GRLIB IP Core User's Manual Section 16
-class APBUART : public APBSlave, public CLKDevice {
+class APBUART : public APBSlave, public CLKDevice, public Checkpointable {
   public:
     SC_HAS_PROCESS(APBUART);
     SR_HAS_SIGNALS(APBUART);
@@ -40,6 +41,9 @@ class APBUART : public APBSlave, public CLKDevice {
 
     sc_event e_irq;
     sc_event s_irq; // trigger interrupt when send buffer empty
+    sc_event e_tx;  // the character at the head of the transmit FIFO is sent
+    sc_event e_rx;  // the receiver was enabled
+    sc_event e_flush;  // the transmitter was idle long enough to flush the backend
 
     io_if *m_backend;
     uint32_t g_pirq;
@@ -71,15 +75,39 @@ class APBUART : public APBSlave, public CLKDevice {
 
     // SCTHREADS
     void send_irq();
-    void uart_ticks();
+
+    /// Polls the backend, only while the receiver is enabled and
+    /// the backend can deliver characters
+    void uart_receive();
+
+    // SCMETHODS
+    /// Removes a sent character from the transmit FIFO
+    void uart_transmit();
+
+    /// Lets a buffering backend write its output
+    void uart_flush();
+
+    /// Time to transfer one character, derived from the scaler
+    sc_core::sc_time char_time();
+
+    /// True if the receiver takes characters from the backend
+    bool receive_enabled();
 
     void inc_fifo_level(uint32_t *counter);
 
     // Signal Callbacks
     virtual void dorst();
 
+    // Checkpoints: registers and FIFO state, the backend is not saved
+    void checkpoint_save(CheckpointArchive &ar);
+
+    void checkpoint_restore(const CheckpointArchive &ar);
+
     void before_end_of_elaboration();
 
+    /// Writes out what a buffering backend still holds
+    void end_of_simulation();
+
     const uint32_t powermon;
 
     static const uint32_t DATA            = 0x00000000;
@@ -0,0 +1,77 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup apbuart
+/// @{
+/// @file consoleio.cpp
+///
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include "gaisler/apbuart/consoleio.h"
+
+SR_HAS_UARTBACKEND(ConsoleIO);
+
+ConsoleIO::ConsoleIO(sc_core::sc_module_name nm) :
+  BaseModule<DefaultBase>(nm),
+  g_file("file", "", m_generics),
+  g_buffer("buffer", 4096, m_generics),
+  m_file(NULL) {
+}
+
+ConsoleIO::~ConsoleIO() {
+  flush();
+  if (m_file && m_file != stdout) {
+    fclose(m_file);
+  }
+}
+
+uint32_t ConsoleIO::receivedChars() {
+  return 0;
+}
+
+void ConsoleIO::getReceivedChar(char *toRecv) {
+}
+
+bool ConsoleIO::canReceive() {
+  return false;
+}
+
+void ConsoleIO::sendChar(char toSend) {
+  m_output += toSend;
+  if (toSend == '\n' && m_output.size() >= g_buffer) {
+    flush();
+  }
+}
+
+void ConsoleIO::flush() {
+  if (m_output.empty()) {
+    return;
+  }
+  if (!m_file) {
+    std::string file = g_file;
+    if (file.empty()) {
+      m_file = stdout;
+    } else {
+      m_file = fopen(file.c_str(), "w");
+      if (!m_file) {
+        srWarn()
+          ("file", file)
+          ("Could not open UART output file, using the console");
+        m_file = stdout;
+      }
+    }
+  }
+  fwrite(m_output.data(), 1, m_output.size(), m_file);
+  fflush(m_file);
+  m_output.clear();
+}
+
+void ConsoleIO::end_of_simulation() {
+  flush();
+}
+/// @}
@@ -0,0 +1,65 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup apbuart
+/// @{
+/// @file consoleio.h
+/// UART backend writing the output line-buffered to the console or a file.
+///
+/// The characters are collected in memory and written with one call per
+/// block of lines, so verbose boot consoles do not cost a report or a
+/// system call per character. Pending output is written when the UART
+/// transmitter was idle for a while, at a line end once g_buffer bytes
+/// are collected and at the end of the simulation. The backend has no input.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef MODELS_APBUART_CONSOLEIO_H_
+#define MODELS_APBUART_CONSOLEIO_H_
+
+#include <cstdio>
+#include <string>
+
+#include "gaisler/apbuart/io_if.h"
+#include "core/common/systemc.h"
+#include "core/common/base.h"
+#include "core/common/sr_report.h"
+
+class ConsoleIO : public BaseModule<DefaultBase>, public io_if {
+  public:
+    ConsoleIO(sc_core::sc_module_name nm);
+
+    ~ConsoleIO();
+
+    uint32_t receivedChars();
+
+    void getReceivedChar(char *toRecv);
+
+    /// Collects a character
+    void sendChar(char toSend);
+
+    /// The console has no input
+    bool canReceive();
+
+    /// Writes all collected characters
+    void flush();
+
+    void end_of_simulation();
+
+    /// Output file, the console (stdout) if empty
+    sr_param<std::string> g_file;
+
+    /// Collected bytes after which the output is written at the next line end
+    sr_param<uint32_t> g_buffer;
+
+  private:
+    std::string m_output;
+    FILE *m_file;
+};
+
+#endif  // MODELS_APBUART_CONSOLEIO_H_
+/// @}
@@ -38,6 +38,16 @@ class io_if {
     virtual uint32_t receivedChars() = 0;
     virtual void getReceivedChar(char *toRecv) = 0;
     virtual void sendChar(char toSend) = 0;
+
+    /// False if the backend never delivers characters.
+    /// The UART does not poll such a backend at all.
+    virtual bool canReceive() {
+      return true;
+    }
+
+    /// Called when the UART transmitter was idle for a while.
+    /// Buffering backends write out their pending output.
+    virtual void flush() {}
 };
 
 #endif  // MODELS_APBUART_IO_IF_H_
@@ -40,6 +40,10 @@ uint32_t ReportIO::receivedChars() {
 void ReportIO::getReceivedChar(char *toRecv) {
 }
 
+bool ReportIO::canReceive() {
+  return false;
+}
+
 /// Sends a character on the communication channel
 void ReportIO::sendChar(char toSend) {
   if (g_lines) {
@@ -35,6 +35,9 @@ class ReportIO : public BaseModule<DefaultBase>, public io_if {
     /// Sends a character on the communication channel
     void sendChar(char toSend);
 
+    /// The reporter has no input
+    bool canReceive();
+
     /// Creates a connection
     void makeConnection();
 
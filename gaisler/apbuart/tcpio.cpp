@@ -86,7 +86,19 @@ void TcpIO::getReceivedChar(char *toRecv) {
 
 /// Sends a character on the communication channel
 void TcpIO::sendChar(char toSend) {
+  m_output += toSend;
+  if (toSend == '\n' || m_output.size() >= 1024) {
+    flush();
+  }
+}
+
+/// Writes the collected characters to the socket
+void TcpIO::flush() {
+  if (m_output.empty()) {
+    return;
+  }
   boost::system::error_code asioError;
-  boost::asio::write(*this->socket, boost::asio::buffer(&toSend, 1), boost::asio::transfer_all(), asioError);
+  boost::asio::write(*this->socket, boost::asio::buffer(m_output.data(), m_output.size()), boost::asio::transfer_all(), asioError);
+  m_output.clear();
 }
 /// @}
@@ -32,6 +32,9 @@ class TcpIO : public BaseModule<DefaultBase>, public io_if {
     /// The port on which the connection takes place;
     sr_param<unsigned int> g_port;
 
+    /// Characters not yet written to the socket
+    std::string m_output;
+
   public:
     /// Opens a new socket connection on the specified port
     TcpIO(ModuleName mn, unsigned int port = 2000, bool test = false);
@@ -45,9 +48,13 @@ class TcpIO : public BaseModule<DefaultBase>, public io_if {
     uint32_t receivedChars();
     void getReceivedChar(char *toRecv);
 
-    /// Sends a character on the communication channel
+    /// Sends a character on the communication channel.
+    /// The characters are collected and written per line or on flush().
     void sendChar(char toSend);
 
+    /// Writes the collected characters to the socket
+    void flush();
+
     /// Creates a connection
     void makeConnection();
 
@@ -275,6 +275,57 @@ void GPTimer::dorst() {
     }
 }
 
+// Save the prescaler and the current counter values
+void GPTimer::checkpoint_save(CheckpointArchive &ar) {
+    std::vector<uint32_t> regs(5 * counter.size());
+    scaler_read();
+    ar.put("scaler", r[SCALER].read());
+    ar.put("screload", r[SCRELOAD].read());
+    ar.put("conf", r[CONF].read());
+    for (size_t i = 0; i < counter.size(); i++) {
+        counter[i]->value_read();
+        counter[i]->ctrl_read();
+        regs[5 * i + 0] = r[VALUE(i)].read();
+        regs[5 * i + 1] = r[RELOAD(i)].read();
+        regs[5 * i + 2] = r[CTRL(i)].read();
+        regs[5 * i + 3] = counter[i]->stopped;
+        regs[5 * i + 4] = counter[i]->chain_run;
+    }
+    ar.put("counters", &regs[0], regs.size() * sizeof(uint32_t));
+}
+
+// Restore the prescaler and the counters, the saved values are known at the current time
+void GPTimer::checkpoint_restore(const CheckpointArchive &ar) {
+    std::vector<uint32_t> regs(5 * counter.size());
+    uint32_t value = 0;
+    if (ar.get("screload", value)) r[SCRELOAD] = value;
+    if (ar.get("conf", value)) r[CONF] = value;
+    if (ar.get("scaler", value)) r[SCALER] = value;
+    lasttime = sc_core::sc_time_stamp();
+    lastvalue = r[SCALER];
+
+    if (!ar.get("counters", &regs[0], regs.size() * sizeof(uint32_t))) {
+        srWarn()
+          ("counters", counter.size())
+          ("Number of counters differs from checkpoint, counters not restored");
+        return;
+    }
+    for (size_t i = 0; i < counter.size(); i++) {
+        GPCounter *c = counter[i];
+        c->stop();
+        r[VALUE(i)] = regs[5 * i + 0];
+        r[RELOAD(i)] = regs[5 * i + 1];
+        r[CTRL(i)] = regs[5 * i + 2] & ~(1 << CTRL_LD);
+        c->m_pirq = r[CTRL(i)].bit(CTRL_IP);
+        c->chain_run = regs[5 * i + 4];
+        c->lastvalue = regs[5 * i + 0];
+        c->lasttime = lasttime;
+        if (!regs[5 * i + 3]) {
+            c->start();
+        }
+    }
+}
+
 // Prescaler value relative to the current value.
 int64_t GPTimer::valueof(sc_core::sc_time t, int64_t offset, sc_core::sc_time cycletime) const {
     return static_cast<int64_t>(lastvalue - int64_t(sc_core::sc_time(t - lasttime - (1 + offset) * cycletime) / cycletime) + 1);
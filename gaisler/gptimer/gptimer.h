@@ -26,6 +26,7 @@
 #include "core/common/apbslave.h"
 #include "core/common/clkdevice.h"
 #include "core/common/sr_signal.h"
+#include "core/common/checkpoint.h"
 
 #include "core/common/verbose.h"
 #include "core/common/sr_param.h"
@@ -34,7 +35,7 @@
 
 /// @brief This class is a TLM 2.0 Model of the Aeroflex Gaisler GRLIB GPTimer.
 /// Further informations to the original VHDL Modle are available in the GRLIB IP Core User's Manual Section 37
-class GPTimer : public APBSlave, public CLKDevice {
+class GPTimer : public APBSlave, public CLKDevice, public Checkpointable {
  public:
   SC_HAS_PROCESS(GPTimer);
   SR_HAS_SIGNALS(GPTimer);
@@ -147,6 +148,15 @@ class GPTimer : public APBSlave, public CLKDevice {
   /// @param time A possible delay. Which means the reset might be performed in the future (Not used for resets!).
   virtual void dorst();
 
+  /// Save the prescaler and the current counter values.
+  void checkpoint_save(CheckpointArchive &ar);
+
+  /// Restore the prescaler and the counters.
+  ///
+  /// The saved values are taken as known values at the current simulation time,
+  /// running counters are started again from there.
+  void checkpoint_restore(const CheckpointArchive &ar);
+
   // Functions
   /// The time to value function of the prescaler or the counters.
   ///
@@ -14,6 +14,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gaisler/irqmp/irqmp.h"
 #include "core/common/verbose.h"
@@ -251,6 +252,49 @@ void Irqmp::dorst() {
   cpu_rst.write(1, true);
 }
 
+// Save the interrupt registers
+void Irqmp::checkpoint_save(CheckpointArchive &ar) {
+  std::vector<uint32_t> cpuregs(4 * g_ncpu);
+  ar.put("level", r[IR_LEVEL].read());
+  ar.put("pending", r[IR_PENDING].read());
+  ar.put("force", r[IR_FORCE].read());
+  ar.put("broadcast", r[BROADCAST].read());
+  ar.put("mpstat", r[MP_STAT].read());
+  for (int cpu = 0; cpu < g_ncpu; cpu++) {
+    cpuregs[4 * cpu + 0] = r[PROC_IR_MASK(cpu)].read();
+    cpuregs[4 * cpu + 1] = r[PROC_IR_FORCE(cpu)].read();
+    cpuregs[4 * cpu + 2] = r[PROC_EXTIR_ID(cpu)].read();
+    cpuregs[4 * cpu + 3] = forcereg[cpu];
+  }
+  ar.put("cpu", &cpuregs[0], cpuregs.size() * sizeof(uint32_t));
+}
+
+// Restore the interrupt registers without triggering the register callbacks
+void Irqmp::checkpoint_restore(const CheckpointArchive &ar) {
+  std::vector<uint32_t> cpuregs(4 * g_ncpu);
+  uint32_t value = 0;
+  if (ar.get("level", value)) r[IR_LEVEL] = value;
+  if (ar.get("pending", value)) r[IR_PENDING] = value;
+  if (ar.get("force", value)) r[IR_FORCE] = value;
+  if (ar.get("broadcast", value)) r[BROADCAST] = value;
+  // The power-down bits follow the restored processor run state on the next read
+  if (ar.get("mpstat", value)) r[MP_STAT] = value;
+  if (ar.get("cpu", &cpuregs[0], cpuregs.size() * sizeof(uint32_t))) {
+    for (int cpu = 0; cpu < g_ncpu; cpu++) {
+      r[PROC_IR_MASK(cpu)]  = cpuregs[4 * cpu + 0];
+      r[PROC_IR_FORCE(cpu)] = cpuregs[4 * cpu + 1];
+      r[PROC_EXTIR_ID(cpu)] = cpuregs[4 * cpu + 2];
+      forcereg[cpu] = cpuregs[4 * cpu + 3];
+    }
+  } else {
+    srWarn()
+      ("ncpu", g_ncpu.getValue())
+      ("Number of processors differs from checkpoint, interrupt masks not restored");
+  }
+  // Recalculate the processor interrupt lines
+  e_signal.notify(1 * clock_cycle);
+}
+
 //  - watch interrupt bus signals (apbi.pirq)
 //  - write incoming interrupts into pending or force registers
 //
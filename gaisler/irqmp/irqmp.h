@@ -24,8 +24,9 @@
 #include "core/common/apbslave.h"
 #include "core/common/clkdevice.h"
 #include "core/common/sr_signal.h"
+#include "core/common/checkpoint.h"
 
-class Irqmp : public APBSlave, public CLKDevice {
+class Irqmp : public APBSlave, public CLKDevice, public Checkpointable {
   public:
     SC_HAS_PROCESS(Irqmp);
     SR_HAS_SIGNALS(Irqmp);
@@ -143,6 +144,13 @@ class Irqmp : public APBSlave, public CLKDevice {
     /// @param time  Delay to the current simulation time. Is not used in this callback.
     void dorst();
 
+    /// Save the interrupt registers
+    void checkpoint_save(CheckpointArchive &ar);
+
+    /// Restore the interrupt registers and resend the pending interrupts.
+    ///  The multiprocessor status is not restored, it reflects the state of the processors.
+    void checkpoint_restore(const CheckpointArchive &ar);
+
     /// Incomming interrupts
     ///
     ///  This Callback is registert to the interrupt input signal.
@@ -43,194 +43,208 @@
 
 using namespace leon3_funclt_trap;
 void leon3_funclt_trap::Alias::immediateWrite( const unsigned int & value ) throw(){
-    this->reg->immediateWrite(value);
+    this->target().immediateWrite(value);
 }
 
 unsigned int leon3_funclt_trap::Alias::readNewValue() throw(){
-    return this->reg->readNewValue();
+    return this->target().readNewValue();
 }
 
 unsigned int leon3_funclt_trap::Alias::operator ~() throw(){
-    return ~(*this->reg + this->offset);
+    return ~(this->target() + this->offset);
 }
 
 unsigned int leon3_funclt_trap::Alias::operator +( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) + *other.reg);
+    return ((this->target() + this->offset) + other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator -( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) - *other.reg);
+    return ((this->target() + this->offset) - other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator *( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) * *other.reg);
+    return ((this->target() + this->offset) * other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator /( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) / *other.reg);
+    return ((this->target() + this->offset) / other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator |( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) | *other.reg);
+    return ((this->target() + this->offset) | other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator &( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) & *other.reg);
+    return ((this->target() + this->offset) & other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator ^( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) ^ *other.reg);
+    return ((this->target() + this->offset) ^ other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator <<( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) << *other.reg);
+    return ((this->target() + this->offset) << other.target());
 }
 
 unsigned int leon3_funclt_trap::Alias::operator >>( const Alias & other ) const throw(){
-    return ((*this->reg + this->offset) >> *other.reg);
+    return ((this->target() + this->offset) >> other.target());
 }
 
 Alias & leon3_funclt_trap::Alias::operator =( const Alias & other ) throw(){
-    *this->reg = *other.reg;
+    this->target() = other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator +=( const Alias & other ) throw(){
-    *this->reg += *other.reg;
+    this->target() += other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator -=( const Alias & other ) throw(){
-    *this->reg -= *other.reg;
+    this->target() -= other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator *=( const Alias & other ) throw(){
-    *this->reg *= *other.reg;
+    this->target() *= other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator /=( const Alias & other ) throw(){
-    *this->reg /= *other.reg;
+    this->target() /= other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator |=( const Alias & other ) throw(){
-    *this->reg |= *other.reg;
+    this->target() |= other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator &=( const Alias & other ) throw(){
-    *this->reg &= *other.reg;
+    this->target() &= other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator ^=( const Alias & other ) throw(){
-    *this->reg ^= *other.reg;
+    this->target() ^= other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator <<=( const Alias & other ) throw(){
-    *this->reg <<= *other.reg;
+    this->target() <<= other.target();
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator >>=( const Alias & other ) throw(){
-    *this->reg >>= *other.reg;
+    this->target() >>= other.target();
     return *this;
 }
 
 bool leon3_funclt_trap::Alias::operator <( const Register & other ) const throw(){
-    return ((*this->reg + this->offset) < other);
+    return ((this->target() + this->offset) < other);
 }
 
 bool leon3_funclt_trap::Alias::operator >( const Register & other ) const throw(){
-    return ((*this->reg + this->offset) > other);
+    return ((this->target() + this->offset) > other);
 }
 
 bool leon3_funclt_trap::Alias::operator <=( const Register & other ) const throw(){
-    return ((*this->reg + this->offset) <= other);
+    return ((this->target() + this->offset) <= other);
 }
 
 bool leon3_funclt_trap::Alias::operator >=( const Register & other ) const throw(){
-    return ((*this->reg + this->offset) >= other);
+    return ((this->target() + this->offset) >= other);
 }
 
 bool leon3_funclt_trap::Alias::operator ==( const Register & other ) const throw(){
-    return ((*this->reg + this->offset) == other);
+    return ((this->target() + this->offset) == other);
 }
 
 bool leon3_funclt_trap::Alias::operator !=( const Register & other ) const throw(){
-    return ((*this->reg + this->offset) != other);
+    return ((this->target() + this->offset) != other);
 }
 
 Alias & leon3_funclt_trap::Alias::operator =( const Register & other ) throw(){
-    *this->reg = other;
+    this->target() = other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator +=( const Register & other ) throw(){
-    *this->reg += other;
+    this->target() += other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator -=( const Register & other ) throw(){
-    *this->reg -= other;
+    this->target() -= other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator *=( const Register & other ) throw(){
-    *this->reg *= other;
+    this->target() *= other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator /=( const Register & other ) throw(){
-    *this->reg /= other;
+    this->target() /= other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator |=( const Register & other ) throw(){
-    *this->reg |= other;
+    this->target() |= other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator &=( const Register & other ) throw(){
-    *this->reg &= other;
+    this->target() &= other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator ^=( const Register & other ) throw(){
-    *this->reg ^= other;
+    this->target() ^= other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator <<=( const Register & other ) throw(){
-    *this->reg <<= other;
+    this->target() <<= other;
     return *this;
 }
 
 Alias & leon3_funclt_trap::Alias::operator >>=( const Register & other ) throw(){
-    *this->reg >>= other;
+    this->target() >>= other;
     return *this;
 }
 
 std::ostream & leon3_funclt_trap::Alias::operator <<( std::ostream & stream ) const \
     throw(){
-    stream << *this->reg + this->offset;
+    stream << this->target() + this->offset;
     return stream;
 }
 
 void leon3_funclt_trap::Alias::directSetAlias( Alias & newAlias ) throw(){
+    if(newAlias.windows != NULL){
+        // Windowed registers are never rewired: no need to be notified
+        this->setWindowed(*newAlias.windows, newAlias.windowIndex);
+        this->offset = newAlias.offset;
+        return;
+    }
+    this->windows = NULL;
     this->reg = newAlias.reg;
     this->offset = newAlias.offset;
     if(this->referringAliases != NULL){
         this->referringAliases->referredAliases.remove(this);
     }
+    if(newAlias.fixed){
+        // Neither are the globals: the block cache copies of the
+        // instructions would otherwise make every flush quadratic
+        this->referringAliases = NULL;
+        return;
+    }
     this->referringAliases = &newAlias;
     newAlias.referredAliases.push_back(this);
 }
 
 void leon3_funclt_trap::Alias::directSetAlias( Register & newAlias ) throw(){
+    this->windows = NULL;
     this->reg = &newAlias;
     if(this->referringAliases != NULL){
         this->referringAliases->referredAliases.remove(this);
@@ -239,20 +253,56 @@ void leon3_funclt_trap::Alias::directSetAlias( Register & newAlias ) throw(){
 }
 
 leon3_funclt_trap::Alias::Alias( Register * reg, unsigned int offset ) : reg(reg), \
-    offset(offset), defaultOffset(0){
+    offset(offset), defaultOffset(0), windows(NULL), windowIndex(0), fixed(false){
     this->referringAliases = NULL;
 }
 
-leon3_funclt_trap::Alias::Alias() : offset(0), defaultOffset(0){
+leon3_funclt_trap::Alias::Alias() : reg(NULL), offset(0), defaultOffset(0), windows(NULL), \
+    windowIndex(0), fixed(false){
     this->referringAliases = NULL;
 }
 
 leon3_funclt_trap::Alias::Alias( Alias * initAlias, unsigned int offset ) : reg(initAlias->reg), \
-    offset(initAlias->offset + offset), defaultOffset(offset){
+    offset(initAlias->offset + offset), defaultOffset(offset), windows(initAlias->windows), \
+    windowIndex(initAlias->windowIndex), fixed(false){
     initAlias->referredAliases.push_back(this);
     this->referringAliases = initAlias;
 }
 
+void leon3_funclt_trap::Alias::setWindowed( RegisterWindows & windows, unsigned int \
+    windowIndex ) throw(){
+    this->windows = &windows;
+    this->windowIndex = windowIndex;
+    if(this->referringAliases != NULL){
+        this->referringAliases->referredAliases.remove(this);
+    }
+    this->referringAliases = NULL;
+    // The aliases referring to this one resolve through the windows as well
+    std::list<Alias *> referred;
+    referred.swap(this->referredAliases);
+    std::list<Alias *>::iterator referredIter, referredEnd;
+    for(referredIter = referred.begin(), referredEnd = referred.end(); referredIter != \
+        referredEnd; referredIter++){
+        (*referredIter)->referringAliases = NULL;
+        (*referredIter)->setWindowed(windows, windowIndex);
+        (*referredIter)->offset = this->offset + (*referredIter)->defaultOffset;
+    }
+}
+
+leon3_funclt_trap::RegisterWindows::RegisterWindows(){
+    for(unsigned int i = 0; i < NUM_WINDOWS*16 + 8; i++){
+        this->flat[i] = NULL;
+    }
+    this->window = this->flat;
+}
+
+void leon3_funclt_trap::RegisterWindows::init( Reg32_3 * WINREGS ) throw(){
+    for(unsigned int i = 0; i < NUM_WINDOWS*16 + 8; i++){
+        this->flat[i] = &WINREGS[i % (NUM_WINDOWS*16)];
+    }
+    this->window = this->flat;
+}
+
 leon3_funclt_trap::Alias::~Alias(){
     std::list<Alias *>::iterator referredIter, referredEnd;
     for(referredIter = this->referredAliases.begin(), referredEnd = this->referredAliases.end(); \
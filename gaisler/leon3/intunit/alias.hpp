@@ -44,6 +44,33 @@
 
 #define FUNC_MODEL
 #define LT_IF
+namespace leon3_funclt_trap{
+
+    /// Flat view of the windowed registers. Entry cwp*16 + i - 8 refers to
+    /// register i (8 to 31) of window cwp; the entries past the last window
+    /// wrap around to the first one, so no modulo is needed on access.
+    /// Changing window is a single pointer update.
+    class RegisterWindows{
+        public:
+        static const unsigned int NUM_WINDOWS = 8;
+
+        private:
+        Reg32_3 * flat[NUM_WINDOWS*16 + 8];
+        Reg32_3 * const * window;
+
+        public:
+        RegisterWindows();
+        void init( Reg32_3 * WINREGS ) throw();
+        inline void setCwp( unsigned int cwp ) throw(){
+            this->window = this->flat + cwp*16;
+        }
+        inline Reg32_3 & operator []( unsigned int index ) const throw(){
+            return *this->window[index];
+        }
+    };
+
+};
+
 namespace leon3_funclt_trap{
 
     class Alias{
@@ -53,6 +80,15 @@ namespace leon3_funclt_trap{
         unsigned int defaultOffset;
         std::list< Alias * > referredAliases;
         Alias * referringAliases;
+        RegisterWindows * windows;
+        unsigned int windowIndex;
+        bool fixed;
+        inline Register & target() const throw(){
+            if(this->windows != NULL){
+                return (*this->windows)[this->windowIndex];
+            }
+            return *this->reg;
+        }
 
         public:
         ~Alias();
@@ -60,52 +96,56 @@ namespace leon3_funclt_trap{
         Alias();
         Alias( Register * reg, unsigned int offset = 0 );
         inline InnerField & operator []( int bitField ) throw(){
-            return (*this->reg)[bitField];
+            return this->target()[bitField];
         }
         void immediateWrite( const unsigned int & value ) throw();
         unsigned int readNewValue() throw();
         inline Register * getReg() const throw(){
-            return this->reg;
+            return &this->target();
         }
         unsigned int operator ~() throw();
         inline Alias & operator =( const unsigned int & other ) throw(){
+            if(this->windows != NULL){
+                (*this->windows)[this->windowIndex].Reg32_3::operator =(other);
+                return *this;
+            }
             *this->reg = other;
             return *this;
         }
         inline Alias & operator +=( const unsigned int & other ) throw(){
-            *this->reg += other;
+            this->target() += other;
             return *this;
         }
         inline Alias & operator -=( const unsigned int & other ) throw(){
-            *this->reg -= other;
+            this->target() -= other;
             return *this;
         }
         inline Alias & operator *=( const unsigned int & other ) throw(){
-            *this->reg *= other;
+            this->target() *= other;
             return *this;
         }
         inline Alias & operator /=( const unsigned int & other ) throw(){
-            *this->reg /= other;
+            this->target() /= other;
             return *this;
         }
         inline Alias & operator |=( const unsigned int & other ) throw(){
-            *this->reg |= other;
+            this->target() |= other;
             return *this;
         }
         inline Alias & operator &=( const unsigned int & other ) throw(){
-            *this->reg &= other;
+            this->target() &= other;
             return *this;
         }
         inline Alias & operator ^=( const unsigned int & other ) throw(){
-            *this->reg ^= other;
+            this->target() ^= other;
             return *this;
         }
         inline Alias & operator <<=( const unsigned int & other ) throw(){
-            *this->reg <<= other;
+            this->target() <<= other;
             return *this;
         }
         inline Alias & operator >>=( const unsigned int & other ) throw(){
-            *this->reg >>= other;
+            this->target() >>= other;
             return *this;
         }
         unsigned int operator +( const Alias & other ) const throw();
@@ -128,31 +168,31 @@ namespace leon3_funclt_trap{
         Alias & operator <<=( const Alias & other ) throw();
         Alias & operator >>=( const Alias & other ) throw();
         inline unsigned int operator +( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) + other);
+            return ((this->target() + this->offset) + other);
         }
         inline unsigned int operator -( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) - other);
+            return ((this->target() + this->offset) - other);
         }
         inline unsigned int operator *( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) * other);
+            return ((this->target() + this->offset) * other);
         }
         inline unsigned int operator /( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) / other);
+            return ((this->target() + this->offset) / other);
         }
         inline unsigned int operator |( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) | other);
+            return ((this->target() + this->offset) | other);
         }
         inline unsigned int operator &( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) & other);
+            return ((this->target() + this->offset) & other);
         }
         inline unsigned int operator ^( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) ^ other);
+            return ((this->target() + this->offset) ^ other);
         }
         inline unsigned int operator <<( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) << other);
+            return ((this->target() + this->offset) << other);
         }
         inline unsigned int operator >>( const Register & other ) const throw(){
-            return ((*this->reg + this->offset) >> other);
+            return ((this->target() + this->offset) >> other);
         }
         bool operator <( const Register & other ) const throw();
         bool operator >( const Register & other ) const throw();
@@ -171,10 +211,20 @@ namespace leon3_funclt_trap{
         Alias & operator <<=( const Register & other ) throw();
         Alias & operator >>=( const Register & other ) throw();
         inline operator unsigned int() const throw(){
+            if(this->windows != NULL){
+                return (*this->windows)[this->windowIndex].Reg32_3::operator unsigned int() + this->offset;
+            }
             return *this->reg + this->offset;
         }
         std::ostream & operator <<( std::ostream & stream ) const throw();
         inline void updateAlias( Alias & newAlias, unsigned int newOffset ) throw(){
+            if(newAlias.windows != NULL){
+                this->setWindowed(*newAlias.windows, newAlias.windowIndex);
+                this->offset = newAlias.offset + newOffset;
+                this->defaultOffset = newOffset;
+                return;
+            }
+            this->windows = NULL;
             this->reg = newAlias.reg;
             this->offset = newAlias.offset + newOffset;
             this->defaultOffset = newOffset;
@@ -190,6 +240,13 @@ namespace leon3_funclt_trap{
             newAlias.referredAliases.push_back(this);
         }
         inline void updateAlias( Alias & newAlias ) throw(){
+            if(newAlias.windows != NULL){
+                this->setWindowed(*newAlias.windows, newAlias.windowIndex);
+                this->offset = newAlias.offset;
+                this->defaultOffset = 0;
+                return;
+            }
+            this->windows = NULL;
             this->offset = newAlias.offset;
             this->defaultOffset = 0;
             this->reg = newAlias.reg;
@@ -205,6 +262,7 @@ namespace leon3_funclt_trap{
             newAlias.referredAliases.push_back(this);
         }
         inline void updateAlias( Register & newAlias, unsigned int newOffset ) throw(){
+            this->windows = NULL;
             this->reg = &newAlias;
             this->offset = newOffset;
             this->defaultOffset = 0;
@@ -219,6 +277,7 @@ namespace leon3_funclt_trap{
             this->referringAliases = NULL;
         }
         inline void updateAlias( Register & newAlias ) throw(){
+            this->windows = NULL;
             this->offset = 0;
             this->defaultOffset = 0;
             this->reg = &newAlias;
@@ -234,7 +293,17 @@ namespace leon3_funclt_trap{
         }
         void directSetAlias( Alias & newAlias ) throw();
         void directSetAlias( Register & newAlias ) throw();
+        void setWindowed( RegisterWindows & windows, unsigned int windowIndex ) throw();
+        inline RegisterWindows * getWindows() const throw(){
+            return this->windows;
+        }
+        /// Marks an alias which is never rewired after elaboration (the
+        /// globals); aliases set from it do not register as referrers
+        inline void setFixed() throw(){
+            this->fixed = true;
+        }
         inline void newReferredAlias( Register * newAlias, unsigned int newOffset ) throw(){
+            this->windows = NULL;
             this->reg = newAlias;
             this->offset = newOffset + this->defaultOffset;
             std::list<Alias *>::iterator referredIter, referredEnd;
@@ -244,6 +313,7 @@ namespace leon3_funclt_trap{
             }
         }
         inline void newReferredAlias( Register * newAlias ) throw(){
+            this->windows = NULL;
             this->offset = this->defaultOffset;
             this->reg = newAlias;
             std::list<Alias *>::iterator referredIter, referredEnd;
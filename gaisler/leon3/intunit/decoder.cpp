@@ -49,6 +49,23 @@ leon3_funclt_trap::CacheElem::CacheElem() : instr(NULL), count(1){
 
 }
 
+leon3_funclt_trap::BlockCacheElem::BlockCacheElem( unsigned int startPC ) : startPC(startPC), \
+    execCount(0), closed(false){
+
+}
+
+leon3_funclt_trap::BlockCacheElem::~BlockCacheElem(){
+    for(unsigned int i = 0; i < this->instrs.size(); i++){
+        delete this->instrs[i];
+    }
+}
+
+void leon3_funclt_trap::BlockCacheElem::append( unsigned int bitString, Instruction \
+    * instr ){
+    this->bitStrings.push_back(bitString);
+    this->instrs.push_back(instr);
+}
+
 int leon3_funclt_trap::Decoder::decode( unsigned int instrCode ) const throw(){
     switch(instrCode & 0x1c00000){
         case 0x0:{
@@ -39,6 +39,8 @@
 #define LT_DECODER_HPP
 
 #include "gaisler/leon3/intunit/instructions.hpp"
+#include "gaisler/leon3/intunit/translator.hpp"
+#include <vector>
 
 #define FUNC_MODEL
 #define LT_IF
@@ -55,6 +57,30 @@ namespace leon3_funclt_trap{
 
 };
 
+namespace leon3_funclt_trap{
+
+    /// Basic block of already decoded instructions at consecutive addresses.
+    /// The block is keyed by the address of its first instruction; each entry
+    /// keeps the fetched encoding so that the main loop can check it against
+    /// the word returned by the memory interface before reusing the decoded
+    /// instance. Once the block gets hot its instructions are also
+    /// translated to threaded code (see Translator).
+    class BlockCacheElem{
+
+        public:
+        BlockCacheElem( unsigned int startPC );
+        ~BlockCacheElem();
+        void append( unsigned int bitString, Instruction * instr );
+        unsigned int startPC;
+        std::vector< unsigned int > bitStrings;
+        std::vector< Instruction * > instrs;
+        std::vector< TranslatedOp > ops;
+        unsigned int execCount;
+        bool closed;
+    };
+
+};
+
 namespace leon3_funclt_trap{
 
     class Decoder{
@@ -38,6 +38,7 @@
 #include "core/common/trapgen/utils/trap_utils.hpp"
 #include "core/common/sr_report.h"
 #include "core/common/verbose.h"
+#include "core/common/hostquantum.h"
 
 using namespace leon3_funclt_trap;
 
@@ -59,7 +60,26 @@ void leon3_funclt_trap::PinTLM_out_32::on_run(const bool &run, const sc_time &de
 
 
 
+namespace {
+  /// Interrupt acknowledge of a processor running on a host thread
+  class PinCall : public HostQuantum::Call {
+    public:
+      PinCall(PinTLM_out_32 &pin, unsigned int value) : pin(pin), value(value) {}
+      void serve() {
+        pin.send_pin_req(value);
+      }
+      PinTLM_out_32 &pin;
+      unsigned int value;
+  };
+}  // namespace
+
 void leon3_funclt_trap::PinTLM_out_32::send_pin_req(const unsigned int &value) throw() {
+  // The interrupt controller has to be called from the SystemC kernel
+  if(HostQuantum::in_worker()) {
+    PinCall request(*this, value);
+    HostQuantum::instance().call(request);
+    return;
+  }
   initSignal = value;
   v::debug << name() << "InterruptACK " << value << v::endl;
 }
@@ -67,10 +87,10 @@ void leon3_funclt_trap::PinTLM_out_32::send_pin_req(const unsigned int &value) t
 leon3_funclt_trap::PinTLM_out_32::PinTLM_out_32(sc_module_name portName) : sc_module(portName),
   // In stand-alone mode do not wait for run-bit to be set
   #ifdef LEON3_STANDALONE
-    initSignal("ack"), status("status"), run(&leon3_funclt_trap::PinTLM_out_32::on_run, "run"), stopped(false) {
+    initSignal("ack"), status("status"), run(&leon3_funclt_trap::PinTLM_out_32::on_run, "run"), stopped(false), powerdown(false) {
     status.write(true);
   #else
-    initSignal("ack"), status("status"), run(&leon3_funclt_trap::PinTLM_out_32::on_run, "run"), stopped(true) {
+    initSignal("ack"), status("status"), run(&leon3_funclt_trap::PinTLM_out_32::on_run, "run"), stopped(true), powerdown(false) {
     status.write(false);
   #endif
   end_module();
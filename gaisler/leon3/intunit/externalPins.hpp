@@ -68,6 +68,9 @@ namespace leon3_funclt_trap{
 
         /// Needed to start the main processor loop
         sc_event start;
+        /// Set by a write to %asr19, the processor powers down until
+        /// the next interrupt
+        bool powerdown;
     };
 };
 
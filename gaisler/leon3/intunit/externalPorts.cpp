@@ -58,6 +58,9 @@ sc_dt::uint64 leon3_funclt_trap::TLMMemory::read_dword( const unsigned int & add
 							const unsigned int lock) throw(){
 
     sc_dt::uint64 datum = 0;
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(datum));
+    }
     if (this->dmi_ptr_valid){
         if(address + this->dmi_data.get_start_address() > this->dmi_data.get_end_address()){
             SC_REPORT_ERROR("TLM-2", "Error in reading memory data through DMI: address out of \
@@ -132,6 +135,9 @@ unsigned short int leon3_funclt_trap::TLMMemory::read_half( const unsigned int &
 							    const unsigned int lock) throw(){
 
     unsigned short int datum = 0;
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(datum));
+    }
     if (this->dmi_ptr_valid){
         if(address + this->dmi_data.get_start_address() > this->dmi_data.get_end_address()){
             SC_REPORT_ERROR("TLM-2", "Error in reading memory data through DMI: address out of \
@@ -207,6 +213,9 @@ unsigned char leon3_funclt_trap::TLMMemory::read_byte( const unsigned int & addr
 						       const unsigned int lock) throw(){
 
     unsigned char datum = 0;
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(datum));
+    }
     if (this->dmi_ptr_valid){
         if(address + this->dmi_data.get_start_address() > this->dmi_data.get_end_address()){
             SC_REPORT_ERROR("TLM-2", "Error in reading memory data through DMI: address out of \
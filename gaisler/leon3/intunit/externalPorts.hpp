@@ -78,6 +78,9 @@ namespace leon3_funclt_trap{
 				       const unsigned int lock) throw(){
 
             unsigned int datum = 0;
+            if(this->debugger != NULL){
+                this->debugger->notifyRead(address, sizeof(datum));
+            }
             if(this->dmi_ptr_valid) {
                 v::debug << name() << "DMI Access" << endl;
                 if(address + this->dmi_data.get_start_address() > this->dmi_data.get_end_address()){
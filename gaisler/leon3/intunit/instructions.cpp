@@ -59,10 +59,9 @@ bool leon3_funclt_trap::Instruction::IncrementRegWindow() throw(){
         }
         PSR = (PSR & 0xFFFFFFE0) | newCwp;
         #ifndef ACC_MODEL
-        //Functional model: we simply immediately update the alias
-        for(int i = 8; i < 32; i++){
-            REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) & 0x7f]);
-        }
+        //Functional model: the windowed aliases resolve through the flat register
+        //file, moving the window is a single pointer update
+        this->setWindow(newCwp);
         #else
         //Cycle accurate model: we have to update the alias using the pipeline register
         //We update the aliases for this stage and for all the preceding ones (we are in the
@@ -86,10 +85,9 @@ bool leon3_funclt_trap::Instruction::DecrementRegWindow() throw(){
         }
         PSR = (PSR & 0xFFFFFFE0) | newCwp;
         #ifndef ACC_MODEL
-        //Functional model: we simply immediately update the alias
-        for(int i = 8; i < 32; i++){
-            REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) & 0x7f]);
-        }
+        //Functional model: the windowed aliases resolve through the flat register
+        //file, moving the window is a single pointer update
+        this->setWindow(newCwp);
         #else
         //Cycle accurate model: we have to update the alias using the pipeline register
         //We update the aliases for this stage and for all the preceding ones (we are in the
@@ -137,10 +135,9 @@ void leon3_funclt_trap::Instruction::RaiseException( unsigned int pcounter, unsi
         curPSR &= 0xffffffdf;
         unsigned int newCwp = ((unsigned int)(PSR[key_CWP] - 1)) % NUM_REG_WIN;
         #ifndef ACC_MODEL
-        //Functional model: we simply immediately update the alias
-        for(int i = 8; i < 32; i++){
-            REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) & 0x7f]);
-        }
+        //Functional model: the windowed aliases resolve through the flat register
+        //file, moving the window is a single pointer update
+        this->setWindow(newCwp);
         #else
         //Cycle accurate model: we have to update the alias using the pipeline register
         //We update the aliases for this stage and for all the preceding ones (we are in the
@@ -331,6 +328,7 @@ leon3_funclt_trap::Instruction::Instruction( Reg32_0 & PSR, Reg32_1 & WIM, Reg32
     FP(FP), LR(LR), SP(SP), PCR(PCR), REGS(REGS), instrMem(instrMem), dataMem(dataMem), \
     irqAck(irqAck), NUM_REG_WIN(8), PIPELINED_MULT(false){
     this->totalInstrCycles = 0;
+    this->annulled = false;
 }
 
 leon3_funclt_trap::Instruction::~Instruction(){
@@ -784,10 +782,9 @@ unsigned int leon3_funclt_trap::WRITEpsr_imm::behavior(){
         PSR = result;
         int newCwp = result & 0x0000001f;
         #ifndef ACC_MODEL
-        //Functional model: we simply immediately update the alias
-        for(int i = 8; i < 32; i++){
-            REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) & 0x7f]);
-        }
+        //Functional model: the windowed aliases resolve through the flat register
+        //file, moving the window is a single pointer update
+        this->setWindow(newCwp);
         #else
         //Cycle accurate model: we have to update the alias using the pipeline register
         //We update the aliases for this stage and for all the preceding ones (we are in the
@@ -802,6 +799,7 @@ unsigned int leon3_funclt_trap::WRITEpsr_imm::behavior(){
 
     if(supervisorException){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(illegalCWP){
         RaiseException(pcounter, npcounter, ILLEGAL_INSTR);
@@ -975,6 +973,7 @@ unsigned int leon3_funclt_trap::READpsr::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     rd = psr_temp;
@@ -1226,6 +1225,7 @@ unsigned int leon3_funclt_trap::LDSBA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -1299,6 +1299,7 @@ unsigned int leon3_funclt_trap::LDUH_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -1375,9 +1376,11 @@ unsigned int leon3_funclt_trap::STA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -1516,9 +1519,11 @@ unsigned int leon3_funclt_trap::LDSHA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -1599,6 +1604,7 @@ unsigned int leon3_funclt_trap::STBA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -1676,6 +1682,7 @@ unsigned int leon3_funclt_trap::ST_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -1735,6 +1742,7 @@ unsigned int leon3_funclt_trap::READtbr::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     rd = tbr_temp;
@@ -1810,6 +1818,7 @@ unsigned int leon3_funclt_trap::UDIVcc_imm::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -1888,9 +1897,11 @@ unsigned int leon3_funclt_trap::SWAPA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -2154,6 +2165,7 @@ unsigned int leon3_funclt_trap::STH_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -2269,6 +2281,10 @@ unsigned int leon3_funclt_trap::WRITEasr_imm::behavior(){
     Y = result;
 
     ASR[rd] = result;
+    if(rd == 19){
+        // Power-down until the next interrupt
+        irqAck.powerdown = true;
+    }
     return this->totalInstrCycles;
 }
 
@@ -2571,6 +2587,10 @@ unsigned int leon3_funclt_trap::WRITEasr_reg::behavior(){
     Y = result;
 
     ASR[rd] = result;
+    if(rd == 19){
+        // Power-down until the next interrupt
+        irqAck.powerdown = true;
+    }
     return this->totalInstrCycles;
 }
 
@@ -2637,6 +2657,7 @@ unsigned int leon3_funclt_trap::LD_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -2714,6 +2735,7 @@ unsigned int leon3_funclt_trap::ST_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -2857,6 +2879,7 @@ unsigned int leon3_funclt_trap::LDD_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     if(rd_bit % 2 == 0){
@@ -2996,6 +3019,7 @@ unsigned int leon3_funclt_trap::LDUH_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -3144,6 +3168,7 @@ unsigned int leon3_funclt_trap::SAVE_imm::behavior(){
 
     if(!okNewWin){
         RaiseException(pcounter, npcounter, WINDOW_OVERFLOW);
+        return this->totalInstrCycles;
     }
 
     if(okNewWin){
@@ -3363,6 +3388,7 @@ unsigned int leon3_funclt_trap::STD_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -3564,6 +3590,7 @@ unsigned int leon3_funclt_trap::SWAP_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -3919,6 +3946,7 @@ unsigned int leon3_funclt_trap::STH_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -3978,6 +4006,7 @@ unsigned int leon3_funclt_trap::WRITEwim_imm::behavior(){
 
     if(raiseException){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     if(!raiseException){
@@ -4062,6 +4091,7 @@ unsigned int leon3_funclt_trap::LDD_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     if(rd_bit % 2 == 0){
@@ -4206,9 +4236,11 @@ unsigned int leon3_funclt_trap::LDUHA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -4429,6 +4461,7 @@ unsigned int leon3_funclt_trap::SDIV_imm::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -4498,6 +4531,7 @@ unsigned int leon3_funclt_trap::TSUBccTV_imm::behavior(){
 
     if(temp_V){
         RaiseException(pcounter, npcounter, TAG_OVERFLOW);
+        return this->totalInstrCycles;
     }
     this->WB_tv(this->rd, this->rd_bit, this->result, this->temp_V);
     return this->totalInstrCycles;
@@ -4706,9 +4740,11 @@ unsigned int leon3_funclt_trap::RETT_imm::behavior(){
     if(exceptionEnabled){
         if(supervisor){
             RaiseException(pcounter, npcounter, ILLEGAL_INSTR);
+            return this->totalInstrCycles;
         }
         else{
             RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+            return this->totalInstrCycles;
         }
     }
     else if(!supervisor || invalidWin || notAligned){
@@ -4718,10 +4754,9 @@ unsigned int leon3_funclt_trap::RETT_imm::behavior(){
     }
     else{
         #ifndef ACC_MODEL
-        //Functional model: we simply immediately update the alias
-        for(int i = 8; i < 32; i++){
-            REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) & 0x7f]);
-        }
+        //Functional model: the windowed aliases resolve through the flat register
+        //file, moving the window is a single pointer update
+        this->setWindow(newCwp);
         #else
         //Cycle accurate model: we have to update the alias using the pipeline register
         //We update the aliases for this stage and for all the preceding ones (we are in the
@@ -4823,6 +4858,7 @@ unsigned int leon3_funclt_trap::SDIVcc_reg::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -5095,6 +5131,7 @@ unsigned int leon3_funclt_trap::WRITEtbr_imm::behavior(){
 
     if(raiseException){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     if(!raiseException){
@@ -5241,6 +5278,7 @@ unsigned int leon3_funclt_trap::RESTORE_reg::behavior(){
 
     if(!okNewWin){
         RaiseException(pcounter, npcounter, WINDOW_UNDERFLOW);
+        return this->totalInstrCycles;
     }
 
     if(okNewWin){
@@ -5670,6 +5708,7 @@ unsigned int leon3_funclt_trap::READwim::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     rd = wim_temp;
@@ -5969,6 +6008,7 @@ unsigned int leon3_funclt_trap::TSUBccTV_reg::behavior(){
 
     if(temp_V){
         RaiseException(pcounter, npcounter, TAG_OVERFLOW);
+        return this->totalInstrCycles;
     }
     this->WB_tv(this->rd, this->rd_bit, this->result, this->temp_V);
     return this->totalInstrCycles;
@@ -6153,6 +6193,7 @@ unsigned int leon3_funclt_trap::LDSH_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -6236,6 +6277,7 @@ unsigned int leon3_funclt_trap::UDIVcc_reg::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -6374,6 +6416,7 @@ unsigned int leon3_funclt_trap::STD_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -6501,6 +6544,7 @@ unsigned int leon3_funclt_trap::TADDccTV_imm::behavior(){
 
     if(temp_V){
         RaiseException(pcounter, npcounter, TAG_OVERFLOW);
+        return this->totalInstrCycles;
     }
     this->WB_tv(this->rd, this->rd_bit, this->result, this->temp_V);
     return this->totalInstrCycles;
@@ -6564,6 +6608,7 @@ unsigned int leon3_funclt_trap::WRITEtbr_reg::behavior(){
 
     if(raiseException){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     if(!raiseException){
@@ -6764,6 +6809,7 @@ unsigned int leon3_funclt_trap::UDIV_imm::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -6840,6 +6886,7 @@ unsigned int leon3_funclt_trap::LDSH_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -6962,6 +7009,7 @@ unsigned int leon3_funclt_trap::LDSTUBA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -7348,6 +7396,7 @@ unsigned int leon3_funclt_trap::WRITEwim_reg::behavior(){
 
     if(raiseException){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     if(!raiseException){
@@ -8042,6 +8091,7 @@ unsigned int leon3_funclt_trap::TADDccTV_reg::behavior(){
 
     if(temp_V){
         RaiseException(pcounter, npcounter, TAG_OVERFLOW);
+        return this->totalInstrCycles;
     }
     this->WB_tv(this->rd, this->rd_bit, this->result, this->temp_V);
     return this->totalInstrCycles;
@@ -8131,6 +8181,7 @@ unsigned int leon3_funclt_trap::SDIV_reg::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -8272,6 +8323,7 @@ unsigned int leon3_funclt_trap::SWAP_reg::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -8416,9 +8468,11 @@ unsigned int leon3_funclt_trap::STDA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -8560,6 +8614,7 @@ unsigned int leon3_funclt_trap::JUMP_imm::behavior(){
 
     if(trapNotAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     if(!trapNotAligned){
@@ -8818,6 +8873,7 @@ unsigned int leon3_funclt_trap::LDUBA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -8897,6 +8953,7 @@ unsigned int leon3_funclt_trap::JUMP_reg::behavior(){
 
     if(trapNotAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     if(!trapNotAligned){
@@ -9044,6 +9101,7 @@ unsigned int leon3_funclt_trap::UDIV_reg::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -9227,9 +9285,11 @@ unsigned int leon3_funclt_trap::LDA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -9310,9 +9370,11 @@ unsigned int leon3_funclt_trap::STHA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
     this->IncrementPC();
     return this->totalInstrCycles;
@@ -9397,9 +9459,11 @@ unsigned int leon3_funclt_trap::LDDA_reg::behavior(){
 
     if(!supervisor){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     if(rd_bit % 2 == 0){
@@ -9560,6 +9624,7 @@ unsigned int leon3_funclt_trap::RESTORE_imm::behavior(){
 
     if(!okNewWin){
         RaiseException(pcounter, npcounter, WINDOW_UNDERFLOW);
+        return this->totalInstrCycles;
     }
 
     if(okNewWin){
@@ -9634,6 +9699,7 @@ unsigned int leon3_funclt_trap::LD_imm::behavior(){
 
     if(notAligned){
         RaiseException(pcounter, npcounter, MEM_ADDR_NOT_ALIGNED);
+        return this->totalInstrCycles;
     }
 
     rd = readValue;
@@ -9732,6 +9798,7 @@ unsigned int leon3_funclt_trap::TRAP_reg::behavior(){
     if(raiseException){
         stall(4);
         RaiseException(pcounter, npcounter, TRAP_INSTRUCTION, (rs1 + rs2) & 0x0000007F);
+        return this->totalInstrCycles;
     }
     #ifndef ACC_MODEL // review!
     else{
@@ -9937,9 +10004,11 @@ unsigned int leon3_funclt_trap::RETT_reg::behavior(){
     if(exceptionEnabled){
         if(supervisor){
             RaiseException(pcounter, npcounter, ILLEGAL_INSTR);
+            return this->totalInstrCycles;
         }
         else{
             RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+            return this->totalInstrCycles;
         }
     }
     else if(!supervisor || invalidWin || notAligned){
@@ -9949,10 +10018,9 @@ unsigned int leon3_funclt_trap::RETT_reg::behavior(){
     }
     else{
         #ifndef ACC_MODEL
-        //Functional model: we simply immediately update the alias
-        for(int i = 8; i < 32; i++){
-            REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) & 0x7f]);
-        }
+        //Functional model: the windowed aliases resolve through the flat register
+        //file, moving the window is a single pointer update
+        this->setWindow(newCwp);
         #else
         //Cycle accurate model: we have to update the alias using the pipeline register
         //We update the aliases for this stage and for all the preceding ones (we are in the
@@ -10055,6 +10123,7 @@ unsigned int leon3_funclt_trap::SDIVcc_imm::behavior(){
 
     if(exception){
         RaiseException(pcounter, npcounter, DIV_ZERO);
+        return this->totalInstrCycles;
     }
     this->WB_plain(this->rd, this->rd_bit, this->result);
     return this->totalInstrCycles;
@@ -10144,6 +10213,7 @@ unsigned int leon3_funclt_trap::SAVE_reg::behavior(){
 
     if(!okNewWin){
         RaiseException(pcounter, npcounter, WINDOW_OVERFLOW);
+        return this->totalInstrCycles;
     }
 
     if(okNewWin){
@@ -10385,10 +10455,9 @@ unsigned int leon3_funclt_trap::WRITEpsr_reg::behavior(){
         PSR = result;
         int newCwp = result & 0x0000001f;
         #ifndef ACC_MODEL
-        //Functional model: we simply immediately update the alias
-        for(int i = 8; i < 32; i++){
-            REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) & 0x7f]);
-        }
+        //Functional model: the windowed aliases resolve through the flat register
+        //file, moving the window is a single pointer update
+        this->setWindow(newCwp);
         #else
         //Cycle accurate model: we have to update the alias using the pipeline register
         //We update the aliases for this stage and for all the preceding ones (we are in the
@@ -10403,6 +10472,7 @@ unsigned int leon3_funclt_trap::WRITEpsr_reg::behavior(){
 
     if(supervisorException){
         RaiseException(pcounter, npcounter, PRIVILEDGE_INSTR);
+        return this->totalInstrCycles;
     }
     if(illegalCWP){
         RaiseException(pcounter, npcounter, ILLEGAL_INSTR);
@@ -133,8 +133,13 @@ namespace leon3_funclt_trap{
         virtual std::string getInstructionName() const throw() = 0;
         virtual std::string getMnemonic() const throw() = 0;
         virtual unsigned int getId() const throw() = 0;
-        inline void annull(){
-            throw annull_exception();
+        /// Marks the instruction as annulled; behavior() returns right
+        /// after and the main loop discards its cycles and clears the flag
+        inline void annull() throw(){
+            this->annulled = true;
+        }
+        inline void setWindow( unsigned int newCwp ) throw(){
+            this->REGS[8].getWindows()->setCwp(newCwp);
         }
         inline void flush(){
 
@@ -150,6 +155,7 @@ namespace leon3_funclt_trap{
         bool checkIncrementWin() const throw();
         bool checkDecrementWin() const throw();
         unsigned int totalInstrCycles;
+        bool annulled;
         virtual ~Instruction();
     };
 
@@ -73,10 +73,8 @@ void leon3_funclt_trap::LEON3_ABIIf::preCall() throw(){
     unsigned int newCwp = ((unsigned int)(PSR[key_CWP] - 1)) % 8;
     PSR.immediateWrite((PSR & 0xFFFFFFE0) | newCwp);
 
-    //ABI model: we simply immediately update the alias
-    for(int i = 8; i < 32; i++){
-        REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) % (128)]);
-    }
+    //ABI model: the windowed aliases resolve through the flat register file
+    REGS[8].getWindows()->setCwp(newCwp);
 }
 
 void leon3_funclt_trap::LEON3_ABIIf::postCall() throw(){
@@ -84,10 +82,8 @@ void leon3_funclt_trap::LEON3_ABIIf::postCall() throw(){
     unsigned int newCwp = ((unsigned int)(PSR[key_CWP] + 1)) % 8;
     PSR.immediateWrite((PSR & 0xFFFFFFE0) | newCwp);
 
-    //ABI model: we simply immediately update the alias
-    for(int i = 8; i < 32; i++){
-        REGS[i].updateAlias(WINREGS[(newCwp*16 + i - 8) % (128)]);
-    }
+    //ABI model: the windowed aliases resolve through the flat register file
+    REGS[8].getWindows()->setCwp(newCwp);
 }
 
 void leon3_funclt_trap::LEON3_ABIIf::returnFromCall() throw(){
@@ -1201,6 +1197,23 @@ void leon3_funclt_trap::LEON3_ABIIf::writeCharMem( const unsigned int & address,
     this->dataMem.write_byte_dbg(address, datum);
 }
 
+void leon3_funclt_trap::LEON3_ABIIf::readMemBlock( const unsigned int & address, \
+    unsigned char * data, unsigned int length ){
+    this->dataMem.read_block_dbg(address, data, length);
+}
+
+void leon3_funclt_trap::LEON3_ABIIf::writeMemBlock( const unsigned int & address, \
+    const unsigned char * data, unsigned int length ){
+    this->dataMem.write_block_dbg(address, data, length);
+}
+
+std::string leon3_funclt_trap::LEON3_ABIIf::getGDBTargetDescription() const{
+    //GDB uses its SPARC V8 register layout, which matches the GDB registers above
+    return "<?xml version=\"1.0\"?>"
+        "<!DOCTYPE target SYSTEM \"gdb-target.dtd\">"
+        "<target><architecture>sparc</architecture></target>";
+}
+
 
 leon3_funclt_trap::LEON3_ABIIf::~LEON3_ABIIf(){
 
@@ -119,6 +119,9 @@ namespace leon3_funclt_trap{
         unsigned char readCharMem( const unsigned int & address );
         void writeMem( const unsigned int & address, unsigned int datum );
         void writeCharMem( const unsigned int & address, unsigned char datum );
+        void readMemBlock( const unsigned int & address, unsigned char * data, unsigned int length );
+        void writeMemBlock( const unsigned int & address, const unsigned char * data, unsigned int length );
+        std::string getGDBTargetDescription() const;
         MemoryInterface& get_data_memory();
         virtual ~LEON3_ABIIf();
     };
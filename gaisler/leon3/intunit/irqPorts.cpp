@@ -47,6 +47,13 @@
 using namespace leon3_funclt_trap;
 
 void leon3_funclt_trap::IntrTLMPort_32::callbackMethod( const std::pair<unsigned int, bool>& value, const sc_time & delay ){
+    if(this->deferred){
+        // The processor runs on a host thread, it latches the level at
+        // the next quantum boundary or interrupt acknowledge
+        boost::mutex::scoped_lock lock(this->pendingMutex);
+        this->pending = value.second? value.first : -1;
+        return;
+    }
     if(!value.second){
         //Lower the interrupt
         this->irqSignal = -1;
@@ -54,12 +61,18 @@ void leon3_funclt_trap::IntrTLMPort_32::callbackMethod( const std::pair<unsigned
     else{
         //Raise the interrupt
         this->irqSignal = value.first;
+        this->irqEvent.notify();
         v::debug << name() << "InterruptIN " << value.first << v::endl;
     }
 }
 
+void leon3_funclt_trap::IntrTLMPort_32::latch(){
+    boost::mutex::scoped_lock lock(this->pendingMutex);
+    this->irqSignal = this->pending;
+}
+
 leon3_funclt_trap::IntrTLMPort_32::IntrTLMPort_32( sc_module_name portName, unsigned \
-    int & irqSignal ) : sc_module(portName), irqSignal(irqSignal),
-    irq_signal(&IntrTLMPort_32::callbackMethod, "irq"){
+    int & irqSignal ) : sc_module(portName), irqSignal(irqSignal), deferred(false),
+    irq_signal(&IntrTLMPort_32::callbackMethod, "irq"), pending(-1){
     end_module();
 }
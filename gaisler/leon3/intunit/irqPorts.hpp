@@ -43,6 +43,7 @@
 #include "core/common/trapgen/utils/trap_utils.hpp"
 
 #include "core/common/sr_signal.h"
+#include <boost/thread/mutex.hpp>
 
 #define FUNC_MODEL
 #define LT_IF
@@ -55,9 +56,21 @@ namespace leon3_funclt_trap{
 
         void callbackMethod( const std::pair<unsigned int, bool>& value, const sc_time & delay );
 
+        /// Take over the interrupt level received while deferred
+        void latch();
+
         unsigned int & irqSignal;
+        /// Notified when an interrupt is raised (not in deferred mode)
+        sc_event irqEvent;
+
+        /// Keep incoming levels in pending until latch() (host thread slices)
+        bool deferred;
 
         signal< std::pair<unsigned int, bool> >::in irq_signal;
+
+        private:
+        unsigned int pending;
+        boost::mutex pendingMutex;
     };
 
 };
@@ -277,12 +277,15 @@ int sc_main( int argc, char * * argv ){
         return -1;
     }
     ExecLoader loader(vm["application"].as<std::string>());
-    //Lets copy the binary code into memory
-    unsigned char * programData = loader.getProgData();
+    //Lets copy the binary code into memory, segment by segment
     unsigned int programDim = loader.getProgDim();
     unsigned int progDataStart = loader.getDataStart();
-    for(unsigned int i = 0; i < programDim; i++){
-        mem.write_byte_dbg(progDataStart + i, programData[i]);
+    const std::vector<ELFSegmentLoader::Segment> &segments = loader.getSegments();
+    for(unsigned int s = 0; s < segments.size(); s++){
+        mem.write_block_dbg(segments[s].address, segments[s].data, segments[s].fileSize);
+        if(segments[s].memSize > segments[s].fileSize){
+            mem.erase_dbg(segments[s].address + segments[s].fileSize, segments[s].memSize - segments[s].fileSize);
+        }
     }
     if(vm.count("disassembler") != 0){
         std:cout << "Entry Point: " << std::hex << std::showbase << loader.getProgStart() \
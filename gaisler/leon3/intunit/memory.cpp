@@ -100,6 +100,9 @@ sc_dt::uint64 leon3_funclt_trap::LocalMemory::read_dword( const unsigned int & a
     if(address >= this->size){
         THROW_ERROR("Address " << std::hex << std::showbase << address << " out of memory");
     }
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(sc_dt::uint64));
+    }
 
     sc_dt::uint64 datum = *(sc_dt::uint64 *)(this->memory + (unsigned long)address);
     #ifdef LITTLE_ENDIAN_BO
@@ -120,6 +123,9 @@ unsigned short int leon3_funclt_trap::LocalMemory::read_half( const unsigned int
     if(address >= this->size){
         THROW_ERROR("Address " << std::hex << std::showbase << address << " out of memory");
     }
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(unsigned short int));
+    }
 
     unsigned short int datum = *(unsigned short int *)(this->memory + (unsigned long)address);
     //Now the code for endianess conversion: the processor is always modeled
@@ -139,6 +145,9 @@ unsigned char leon3_funclt_trap::LocalMemory::read_byte( const unsigned int & ad
     if(address >= this->size){
         THROW_ERROR("Address " << std::hex << std::showbase << address << " out of memory");
     }
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(unsigned char));
+    }
 
     unsigned char datum = *(unsigned char *)(this->memory + (unsigned long)address);
 
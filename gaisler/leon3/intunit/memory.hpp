@@ -67,6 +67,9 @@ namespace leon3_funclt_trap{
             if(address >= this->size){
                 THROW_ERROR("Address " << std::hex << std::showbase << address << " out of memory");
             }
+            if(this->debugger != NULL){
+                this->debugger->notifyRead(address, sizeof(unsigned int));
+            }
 
             unsigned int datum = *(unsigned int *)(this->memory + (unsigned long)address);
             //Now the code for endianess conversion: the processor is always modeled
@@ -63,19 +63,17 @@ void leon3_funclt_trap::Processor_leon3_funclt::mainLoop() {
     wait(SC_ZERO_TIME); // wait for SystemC infrastructure.
                         // if you don't wait the register callbacks will crash
 
-    bool startMet = false;
-    vmap< unsigned int, CacheElem >::iterator instrCacheEnd = this->instrCache.end();
-
     unsigned int firstPC = this->PC + 0;
     unsigned int firstbitString = this->instrMem.read_instr(firstPC, 0x8 | (PSR[key_S]? 1 : 0), 0);
     int firstinstrId = this->decoder.decode(firstbitString);
     Instruction *firstinstr = this->INSTRUCTIONS[firstinstrId];
     raisedException = 0;
     while(true) {
-        unsigned int numCycles = 0;
-        this->instrExecuting = true;
-
         if(irqAck.stopped) {
+          // A halted core does not take part in the parallel quanta
+          if(this->host) {
+              HostQuantum::instance().leave(this->host);
+          }
           while(irqAck.stopped) {
             //if(sc_time_stamp()>sc_time(0, SC_NS)) {
               //wait(irqAck.start);
@@ -85,102 +83,374 @@ void leon3_funclt_trap::Processor_leon3_funclt::mainLoop() {
           }
           v::info << name() << "Starting ... " << v::endl;
           resetOp();
+          if(this->host) {
+              HostQuantum::instance().join(this->host);
+          }
         }
 
-        // Log instruction count for power monitoring
-        if (m_pow_mon) {
-            dyn_instr++;
+        // Host thread mode: a whole quantum runs on the worker of this core
+        if(this->host) {
+            HostQuantum::instance().run(this->host);
+            if (m_pow_mon) {
+                dyn_instr += this->sliceInstructions;
+            }
+            this->numInstructions += this->sliceInstructions;
+            this->instrEndEvent.notify();
+            this->quantKeeper.sync();
+            continue;
         }
 
-        if((IRQ != 0xFFFFFFFF) && (PSR[key_ET] && (IRQ == 15 || IRQ > PSR[key_PIL]))){
-            this->IRQ_irqInstr->setInterruptValue(IRQ);
-            try{
-                numCycles = this->IRQ_irqInstr->behavior();
-                //this->IRQ_irqInstr->behavior(); // Replacement for ^^
+        this->instrExecuting = true;
+        unsigned int executed = 0;
+
+        // Run recorded basic blocks back to back; single instructions are
+        // only executed on control-flow changes, interrupts, quantum
+        // boundaries or when no closed block starts at the current PC
+        if(this->blockCacheEnabled && !this->historyEnabled && !this->tracer) {
+            vmap< unsigned int, BlockCacheElem * >::iterator block = this->blockCache.find(this->PC + 0);
+            if(block != this->blockCache.end() && block->second->closed) {
+                executed = this->runBlock(block->second);
             }
-            catch(annull_exception &etc){
-              numCycles = 0;
+        }
+        if(!executed) {
+            this->quantKeeper.inc((this->executeInstr() + 1)*this->latency);
+            executed = 1;
+        }
+        // Only a power-down or a jump back to the same or the previous
+        // instruction can be an idle loop
+        if(this->irqAck.powerdown || this->PC == curPC || this->PC + 4 == curPC) {
+            if(this->idleSkipEnabled && this->isIdle()) {
+                this->waitIdle();
             }
+            this->irqAck.powerdown = false;
+        }
+        if (this->quantKeeper.need_sync()){
+            this->quantKeeper.sync();
+        }
 
-        } else {
-            try {
-                curPC = this->PC + 0;
-                if(!startMet && curPC == this->profStartAddr){
-                    this->profTimeStart = sc_time_stamp();
-                } else if(startMet && curPC == this->profEndAddr){
-                    this->profTimeEnd = sc_time_stamp();
-                }
+        // Log instruction count for power monitoring
+        if (m_pow_mon) {
+            dyn_instr += executed;
+        }
+        this->numInstructions += executed;
+        this->instrExecuting = false;
+        this->instrEndEvent.notify();
+    }
+}
 
-                int instrId = 0;
-                unsigned int bitString = this->instrMem.read_instr(curPC, 0x8 | (PSR[key_S]? 1 : 0),0);
-                if(raisedException) {
-                    unsigned int exception = raisedException;
-                    raisedException = 0;
-                    curInstrPtr->RaiseException(raisedExceptionPC, raisedExceptionNPC, exception);
-                }
-                vmap< unsigned int, CacheElem >::iterator cachedInstr = this->instrCache.find(bitString);
-                unsigned int *curCount = NULL;
-                if(cachedInstr != instrCacheEnd) {
-                    curInstrPtr = cachedInstr->second.instr;
-                    // I can call the instruction, I have found it
-                    if(curInstrPtr == NULL) {
-                        curCount = &cachedInstr->second.count;
-                        instrId = this->decoder.decode(bitString);
-                        curInstrPtr = this->INSTRUCTIONS[instrId];
-                        curInstrPtr->setParams(bitString);
-                    }
-                } else {
-                    // The current instruction is not present in the cache:
-                    // I have to perform the normal decoding phase ...
+unsigned int leon3_funclt_trap::Processor_leon3_funclt::executeInstr(){
+    unsigned int numCycles = 0;
+    vmap< unsigned int, CacheElem >::iterator instrCacheEnd = this->instrCache.end();
+
+    if((IRQ != 0xFFFFFFFF) && (PSR[key_ET] && (IRQ == 15 || IRQ > PSR[key_PIL]))){
+        this->IRQ_irqInstr->setInterruptValue(IRQ);
+        numCycles = this->IRQ_irqInstr->behavior();
+        //this->IRQ_irqInstr->behavior(); // Replacement for ^^
+        if(this->IRQ_irqInstr->annulled){
+            this->IRQ_irqInstr->annulled = false;
+            numCycles = 0;
+        }
+        // The acknowledge changed the level seen by this core
+        if(this->inSlice) {
+            this->IRQ_port.latch();
+        }
+
+    } else {
+        curPC = this->PC + 0;
+        if(curPC == this->profStartAddr){
+            this->profTimeStart = sc_time_stamp();
+        }
+
+        int instrId = 0;
+        unsigned int bitString = this->instrMem.read_instr(curPC, 0x8 | (PSR[key_S]? 1 : 0),0);
+        bool trapped = false;
+        if(raisedException) {
+            unsigned int exception = raisedException;
+            raisedException = 0;
+            curInstrPtr->RaiseException(raisedExceptionPC, raisedExceptionNPC, exception);
+            // When the deferred exception is taken the fetched
+            // instruction is discarded
+            trapped = curInstrPtr->annulled;
+            curInstrPtr->annulled = false;
+        }
+        if(!trapped) {
+            vmap< unsigned int, CacheElem >::iterator cachedInstr = this->instrCache.find(bitString);
+            unsigned int *curCount = NULL;
+            if(cachedInstr != instrCacheEnd) {
+                curInstrPtr = cachedInstr->second.instr;
+                // I can call the instruction, I have found it
+                if(curInstrPtr == NULL) {
+                    curCount = &cachedInstr->second.count;
                     instrId = this->decoder.decode(bitString);
                     curInstrPtr = this->INSTRUCTIONS[instrId];
                     curInstrPtr->setParams(bitString);
                 }
-                if (this->historyEnabled) {
-                    srInfo()
-                        ("Address",curPC)
-                        ("Name",curInstrPtr->getInstructionName())
-                        ("Mnemonic",curInstrPtr->getMnemonic())
-                        ("Instruction History");
-                }
-                try {
-                    #ifndef DISABLE_TOOLS
-                    if (!(this->toolManager.newIssue(curPC, curInstrPtr))) {
-                        #endif
-                        numCycles = curInstrPtr->behavior();
-                        //curInstrPtr->behavior(); // Replacement for ^^
-                        #ifndef DISABLE_TOOLS
-                    }
-                    #endif
-                } catch (annull_exception &etc) {
-                    numCycles = 0;
-                }
-                if (cachedInstr != instrCacheEnd) {
-                    if (curCount && *curCount < 256) {
+            } else {
+                // The current instruction is not present in the cache:
+                // I have to perform the normal decoding phase ...
+                instrId = this->decoder.decode(bitString);
+                curInstrPtr = this->INSTRUCTIONS[instrId];
+                curInstrPtr->setParams(bitString);
+            }
+            if (this->historyEnabled) {
+                srInfo()
+                    ("Address",curPC)
+                    ("Name",curInstrPtr->getInstructionName())
+                    ("Mnemonic",curInstrPtr->getMnemonic())
+                    ("Instruction History");
+            }
+            if (this->tracer) {
+                sc_time now = sc_time_stamp() + this->quantKeeper.get_local_time();
+                this->tracer->record(TRACE_INSTR, now.value(), curPC, bitString, 4, curInstrPtr->getId());
+            }
+            if (this->blockCacheEnabled) {
+                this->recordBlockInstr(curPC, bitString, curInstrPtr->getId());
+            }
+            #ifndef DISABLE_TOOLS
+            if (!(this->issueTools(curPC, curInstrPtr))) {
+                #endif
+                numCycles = this->execute(curInstrPtr);
+                //curInstrPtr->behavior(); // Replacement for ^^
+                #ifndef DISABLE_TOOLS
+            }
+            #endif
+            // Annulled by a trap: the instruction does not account cycles
+            if (curInstrPtr->annulled) {
+                curInstrPtr->annulled = false;
+                numCycles = 0;
+            }
+            if (cachedInstr != instrCacheEnd) {
+                if (curCount && *curCount < 256) {
 //                        *curCount++; // ????
-                    } else if (curCount) {
-                        // ... and then add the instruction to the cache
-                        cachedInstr->second.instr = curInstrPtr;
-                        this->INSTRUCTIONS[instrId] = curInstrPtr->replicate();
-                    }
+                } else if (curCount) {
+                    // ... and then add the instruction to the cache
+                    cachedInstr->second.instr = curInstrPtr;
+                    this->INSTRUCTIONS[instrId] = curInstrPtr->replicate();
+                }
+            } else {
+                this->instrCache.insert(std::pair< unsigned int, CacheElem >(bitString, CacheElem()));
+            }
+        }
+    }
+    return numCycles;
+}
+
+void leon3_funclt_trap::Processor_leon3_funclt::beginSlice(){
+    this->IRQ_port.latch();
+    this->sliceEnd = this->quantKeeper.get_local_time() + tlm_utils::tlm_quantumkeeper::get_global_quantum();
+    this->sliceInstructions = 0;
+}
+
+void leon3_funclt_trap::Processor_leon3_funclt::runSlice(){
+    unsigned int executed = 0;
+    this->inSlice = true;
+    while(!irqAck.stopped && this->quantKeeper.get_local_time() < this->sliceEnd) {
+        unsigned int blockExecuted = 0;
+        if(this->blockCacheEnabled && !this->tracer) {
+            vmap< unsigned int, BlockCacheElem * >::iterator block = this->blockCache.find(this->PC + 0);
+            if(block != this->blockCache.end() && block->second->closed) {
+                blockExecuted = this->runBlock(block->second);
+            }
+        }
+        if(blockExecuted) {
+            executed += blockExecuted;
+        } else {
+            this->quantKeeper.inc((this->executeInstr() + 1)*this->latency);
+            executed++;
+        }
+    }
+    this->inSlice = false;
+    this->sliceInstructions = executed;
+}
+
+namespace {
+    /// Tool hit (e.g. an intrinsic) of a core running on a host thread
+    class ToolsCall : public HostQuantum::Call {
+      public:
+        ToolsCall(ToolsManager< unsigned int > &tools, unsigned int pc, Instruction *instr) :
+            tools(tools), pc(pc), instr(instr), skip(false) {}
+        void serve() {
+            skip = tools.newIssue(pc, instr);
+        }
+        ToolsManager< unsigned int > &tools;
+        unsigned int pc;
+        Instruction *instr;
+        bool skip;
+    };
+}
+
+bool leon3_funclt_trap::Processor_leon3_funclt::issueToolsHost( unsigned int curPC, \
+    Instruction *instr ){
+    ToolsCall request(this->toolManager, curPC, instr);
+    HostQuantum::instance().call(request);
+    return request.skip;
+}
+
+unsigned int leon3_funclt_trap::Processor_leon3_funclt::runBlock( BlockCacheElem *block ){
+    unsigned int executed = 0;
+    bool stale = false;
+    if(this->translationEnabled && block->ops.empty() && ++block->execCount >= BLOCK_TRANSLATE_THRESHOLD) {
+        this->translateBlock(block);
+    }
+    bool translated = this->translationEnabled && !block->ops.empty();
+    for(unsigned int i = 0; i < block->instrs.size(); i++) {
+        // Leave the block as soon as the control flow does not follow it or
+        // the general loop has to serve the core state
+        if(this->PC != block->startPC + 4*i || irqAck.stopped ||
+            ((IRQ != 0xFFFFFFFF) && (PSR[key_ET] && (IRQ == 15 || IRQ > PSR[key_PIL])))) {
+            break;
+        }
+        unsigned int numCycles = 0;
+        bool leave = false;
+        curPC = this->PC + 0;
+        if(curPC == this->profStartAddr){
+            this->profTimeStart = sc_time_stamp();
+        }
+        // The fetch is kept: it drives the cache and MMU timing and the
+        // returned word validates the decoded instance
+        unsigned int bitString = this->instrMem.read_instr(curPC, 0x8 | (PSR[key_S]? 1 : 0), 0);
+        if(raisedException) {
+            unsigned int exception = raisedException;
+            raisedException = 0;
+            curInstrPtr->RaiseException(raisedExceptionPC, raisedExceptionNPC, exception);
+            leave = curInstrPtr->annulled;
+            curInstrPtr->annulled = false;
+        }
+        if(!leave) {
+            if(bitString == block->bitStrings[i]) {
+                curInstrPtr = block->instrs[i];
+            } else {
+                // Code was modified or remapped since recording
+                curInstrPtr = this->INSTRUCTIONS[this->decoder.decode(bitString)];
+                curInstrPtr->setParams(bitString);
+                stale = true;
+                leave = true;
+            }
+            #ifndef DISABLE_TOOLS
+            if (!(this->issueTools(curPC, curInstrPtr))) {
+                #endif
+                if(translated && !leave && block->ops[i].handler != NULL) {
+                    numCycles = block->ops[i].handler(block->ops[i], this->PC, this->NPC);
                 } else {
-                    this->instrCache.insert(std::pair< unsigned int, CacheElem >(bitString, CacheElem()));
-                    instrCacheEnd = this->instrCache.end();
+                    numCycles = this->execute(curInstrPtr);
                 }
-            } catch (annull_exception &etc) {
+                #ifndef DISABLE_TOOLS
+            }
+            #endif
+            if(curInstrPtr->annulled) {
+                curInstrPtr->annulled = false;
                 numCycles = 0;
+                leave = true;
             }
         }
+        executed++;
         this->quantKeeper.inc((numCycles + 1)*this->latency);
-        if (this->quantKeeper.need_sync()){
-            this->quantKeeper.sync();
+        // The caller synchronizes at the quantum boundary
+        if (this->inSlice ? this->quantKeeper.get_local_time() >= this->sliceEnd : this->quantKeeper.need_sync()){
+            leave = true;
         }
-        this->instrExecuting = false;
-        this->instrEndEvent.notify();
-        this->numInstructions++;
+        if(leave) {
+            break;
+        }
+    }
+    if(stale) {
+        this->invalidateBlock(block->startPC);
+    }
+    return executed;
+}
+
+void leon3_funclt_trap::Processor_leon3_funclt::translateBlock( BlockCacheElem *block ){
+    block->ops.resize(block->instrs.size());
+    for(unsigned int i = 0; i < block->instrs.size(); i++) {
+        this->translator.translate(block->bitStrings[i], block->instrs[i]->getId(), this->REGS, block->ops[i]);
+    }
+}
+
+bool leon3_funclt_trap::Processor_leon3_funclt::isBlockEnd( int instrId ) const throw(){
+    // BRANCH, CALL, JUMP, RETT and TRAP change the control flow; UNIMP and
+    // invalid instructions always trap; WRITEasr may power the core down
+    return (instrId >= 117 && instrId <= 124) || instrId == 132 || instrId == 133 || instrId == 141 || instrId == 144;
+}
+
+bool leon3_funclt_trap::Processor_leon3_funclt::isIdle(){
+    if(this->irqAck.powerdown){
+        return true;
+    }
+    // A Bicc with displacement 0 branches to itself; it spins either
+    // annulled (ba,a .) or with a nop in the delay slot (ba . ; nop)
+    // without changing any state
+    if((this->instrMem.read_word_dbg(this->PC) & 0xC1FFFFFF) != 0x00800000){
+        return false;
+    }
+    if(this->PC == curPC){
+        return true;
+    }
+    return this->NPC == this->PC + 4 && this->instrMem.read_word_dbg(curPC) == 0x01000000;
+}
+
+void leon3_funclt_trap::Processor_leon3_funclt::waitIdle(){
+    bool powerdown = this->irqAck.powerdown;
+    this->quantKeeper.sync();
+    // The events of timers, UARTs, ... raise the interrupt which ends the
+    // wait, so simulated time jumps from one event to the next. A power-down
+    // ends with any pending interrupt, the idle loop with one it takes.
+    while(!irqAck.stopped && (powerdown? IRQ == 0xFFFFFFFF :
+        !((IRQ != 0xFFFFFFFF) && (PSR[key_ET] && (IRQ == 15 || IRQ > PSR[key_PIL]))))) {
+        wait(this->IRQ_port.irqEvent);
+    }
+}
+
+bool leon3_funclt_trap::Processor_leon3_funclt::isAtomic( int instrId ) const throw(){
+    // LDSTUB, LDSTUBA, SWAP and SWAPA
+    return instrId >= 30 && instrId <= 35;
+}
+
+void leon3_funclt_trap::Processor_leon3_funclt::recordBlockInstr( unsigned int curPC, \
+    unsigned int bitString, int instrId ){
+    if(this->curBlock != NULL && curPC != this->curBlock->startPC + 4*this->curBlock->instrs.size()){
+        // The control flow left the block being recorded
+        this->curBlock->closed = true;
+        this->curBlock = NULL;
+    }
+    if(this->curBlock == NULL){
+        if(this->blockCache.find(curPC) != this->blockCache.end()){
+            return;
+        }
+        if(this->blockCache.size() >= BLOCK_CACHE_MAX_BLOCKS){
+            this->flushBlockCache();
+        }
+        this->curBlock = new BlockCacheElem(curPC);
+        this->blockCache[curPC] = this->curBlock;
+    }
+    Instruction *instr = this->INSTRUCTIONS[instrId]->replicate();
+    instr->setParams(bitString);
+    this->curBlock->append(bitString, instr);
+    if(this->isBlockEnd(instrId) || this->curBlock->instrs.size() >= BLOCK_MAX_INSTRS){
+        this->curBlock->closed = true;
+        this->curBlock = NULL;
     }
 }
 
+void leon3_funclt_trap::Processor_leon3_funclt::invalidateBlock( unsigned int startPC ){
+    vmap< unsigned int, BlockCacheElem * >::iterator block = this->blockCache.find(startPC);
+    if(block != this->blockCache.end()){
+        if(this->curBlock == block->second){
+            this->curBlock = NULL;
+        }
+        delete block->second;
+        this->blockCache.erase(block);
+    }
+}
+
+void leon3_funclt_trap::Processor_leon3_funclt::flushBlockCache(){
+    vmap< unsigned int, BlockCacheElem * >::iterator block, blockEnd;
+    for(block = this->blockCache.begin(), blockEnd = this->blockCache.end(); block != blockEnd; block++){
+        delete block->second;
+    }
+    this->blockCache.clear();
+    this->curBlock = NULL;
+}
+
 void leon3_funclt_trap::Processor_leon3_funclt::triggerException(unsigned int exception) {
     raisedException = exception;
     raisedExceptionPC = this->PC;
@@ -302,6 +572,76 @@ void leon3_funclt_trap::Processor_leon3_funclt::end_of_simulation() {
     v::report << name() << " ******************************************** " << v::endl;
 }
 
+void leon3_funclt_trap::Processor_leon3_funclt::checkpoint_save(CheckpointArchive &ar){
+    unsigned int regs[128];
+
+    ar.put("psr", this->PSR.readNewValue());
+    ar.put("wim", this->WIM.readNewValue());
+    ar.put("tbr", this->TBR.readNewValue());
+    ar.put("y", this->Y.readNewValue());
+    ar.put("pc", this->PC.readNewValue());
+    ar.put("npc", this->NPC.readNewValue());
+    for(int i = 0; i < 8; i++){
+        regs[i] = this->GLOBAL[i].readNewValue();
+    }
+    ar.put("global", regs, 8 * sizeof(unsigned int));
+    for(int i = 0; i < 128; i++){
+        regs[i] = this->WINREGS[i].readNewValue();
+    }
+    ar.put("winregs", regs, 128 * sizeof(unsigned int));
+    for(int i = 0; i < 32; i++){
+        regs[i] = this->ASR[i].readNewValue();
+    }
+    ar.put("asr", regs, 32 * sizeof(unsigned int));
+    ar.put("stopped", this->irqAck.stopped);
+    ar.put("instructions", this->numInstructions.getValue());
+}
+
+void leon3_funclt_trap::Processor_leon3_funclt::checkpoint_restore(const CheckpointArchive &ar){
+    unsigned int value = 0;
+    unsigned int regs[128];
+    bool stopped = false;
+    uint64_t instructions = 0;
+
+    if(!ar.get("psr", value)){
+        v::warn << name() << "No processor state in checkpoint, keeping reset state" << v::endl;
+        return;
+    }
+    this->PSR.immediateWrite(value);
+    // The windowed aliases follow the restored CWP
+    this->windows.setCwp(value & 0x1f);
+    if(ar.get("wim", value)) this->WIM.immediateWrite(value);
+    if(ar.get("tbr", value)) this->TBR.immediateWrite(value);
+    if(ar.get("y", value)) this->Y.immediateWrite(value);
+    if(ar.get("pc", value)) this->PC.immediateWrite(value);
+    if(ar.get("npc", value)) this->NPC.immediateWrite(value);
+    if(ar.get("global", regs, 8 * sizeof(unsigned int))){
+        for(int i = 0; i < 8; i++){
+            this->GLOBAL[i].immediateWrite(regs[i]);
+        }
+    }
+    if(ar.get("winregs", regs, 128 * sizeof(unsigned int))){
+        for(int i = 0; i < 128; i++){
+            this->WINREGS[i].immediateWrite(regs[i]);
+        }
+    }
+    if(ar.get("asr", regs, 32 * sizeof(unsigned int))){
+        for(int i = 0; i < 32; i++){
+            this->ASR[i].immediateWrite(regs[i]);
+        }
+    }
+    // A running core must not take the "Starting ..." path, it would reset the registers
+    if(ar.get("stopped", stopped)){
+        this->irqAck.stopped = stopped;
+        this->irqAck.status = !stopped;
+    }
+    if(ar.get("instructions", instructions)){
+        this->numInstructions = instructions;
+    }
+    // Recorded blocks are keyed by PC and belong to the old memory image
+    this->flushBlockCache();
+}
+
 void leon3_funclt_trap::Processor_leon3_funclt::end_of_elaboration(){
     if(!this->resetCalled){
         this->resetOp();
@@ -407,6 +747,9 @@ leon3_funclt_trap::Processor_leon3_funclt::Processor_leon3_funclt(
       IRQ_port("IRQ_port", IRQ),
       irqAck("irqAck"),
       historyEnabled("historyEnabled", false),
+      blockCacheEnabled("blockCacheEnabled", true),
+      translationEnabled("translationEnabled", false),
+      idleSkipEnabled("idleSkipEnabled", true),
       m_pow_mon(pow_mon),
       sta_power_norm("power.leon3.sta_power_norm", 5.27e+8, true), // norm. static power
       int_power_norm("power.leon3.int_power_norm", 5.497e-6, true), // norm. dynamic power
@@ -421,6 +764,11 @@ leon3_funclt_trap::Processor_leon3_funclt::Processor_leon3_funclt(
       numInstructions("instruction_count", 0ull)
 {
     this->resetCalled = false;
+    this->curBlock = NULL;
+    this->host = NULL;
+    this->inSlice = false;
+    this->tracer = NULL;
+    this->sliceInstructions = 0;
     Processor_leon3_funclt::numInstances++;
     // Initialization of the array holding the initial instance of the instructions
     this->INSTRUCTIONS = new Instruction *[145];
@@ -738,30 +1086,14 @@ leon3_funclt_trap::Processor_leon3_funclt::Processor_leon3_funclt(
     this->REGS[5].updateAlias(this->GLOBAL[5]);
     this->REGS[6].updateAlias(this->GLOBAL[6]);
     this->REGS[7].updateAlias(this->GLOBAL[7]);
-    this->REGS[8].updateAlias(this->WINREGS[0]);
-    this->REGS[9].updateAlias(this->WINREGS[1]);
-    this->REGS[10].updateAlias(this->WINREGS[2]);
-    this->REGS[11].updateAlias(this->WINREGS[3]);
-    this->REGS[12].updateAlias(this->WINREGS[4]);
-    this->REGS[13].updateAlias(this->WINREGS[5]);
-    this->REGS[14].updateAlias(this->WINREGS[6]);
-    this->REGS[15].updateAlias(this->WINREGS[7]);
-    this->REGS[16].updateAlias(this->WINREGS[8]);
-    this->REGS[17].updateAlias(this->WINREGS[9]);
-    this->REGS[18].updateAlias(this->WINREGS[10]);
-    this->REGS[19].updateAlias(this->WINREGS[11]);
-    this->REGS[20].updateAlias(this->WINREGS[12]);
-    this->REGS[21].updateAlias(this->WINREGS[13]);
-    this->REGS[22].updateAlias(this->WINREGS[14]);
-    this->REGS[23].updateAlias(this->WINREGS[15]);
-    this->REGS[24].updateAlias(this->WINREGS[16]);
-    this->REGS[25].updateAlias(this->WINREGS[17]);
-    this->REGS[26].updateAlias(this->WINREGS[18]);
-    this->REGS[27].updateAlias(this->WINREGS[19]);
-    this->REGS[28].updateAlias(this->WINREGS[20]);
-    this->REGS[29].updateAlias(this->WINREGS[21]);
-    this->REGS[30].updateAlias(this->WINREGS[22]);
-    this->REGS[31].updateAlias(this->WINREGS[23]);
+    for(int i = 0; i < 8; i++){
+        this->REGS[i].setFixed();
+    }
+    // The windowed registers are reached through a flat view indexed by CWP
+    this->windows.init(this->WINREGS);
+    for(int i = 8; i < 32; i++){
+        this->REGS[i].setWindowed(this->windows, i - 8);
+    }
     this->FP.updateAlias(this->REGS[30], 0);
     this->LR.updateAlias(this->REGS[31], 0);
     this->PCR.updateAlias(this->ASR[17], 0);
@@ -807,6 +1139,7 @@ leon3_funclt_trap::Processor_leon3_funclt::~Processor_leon3_funclt(){
         != cacheEnd; cacheIter++){
         delete cacheIter->second.instr;
     }
+    this->flushBlockCache();
     delete this->abiIf;
     delete this->IRQ_irqInstr;
 }
@@ -39,9 +39,11 @@
 #define LT_PROCESSOR_HPP
 
 #include "core/common/sr_param.h"
+#include "core/common/checkpoint.h"
 #include "core/common/trapgen/utils/customExceptions.hpp"
 #include "gaisler/leon3/intunit/instructions.hpp"
 #include "gaisler/leon3/intunit/decoder.hpp"
+#include "gaisler/leon3/intunit/translator.hpp"
 #include "gaisler/leon3/intunit/interface.hpp"
 #include "core/common/trapgen/ToolsIf.hpp"
 #include <tlm_utils/tlm_quantumkeeper.h>
@@ -58,13 +60,15 @@
 #include "gaisler/leon3/intunit/externalPins.hpp"
 #include <string>
 #include "core/common/systemc.h"
+#include "core/common/hostquantum.h"
+#include "core/common/tracewriter.h"
 
 #define FUNC_MODEL
 #define LT_IF
 using namespace trap;
 namespace leon3_funclt_trap{
 
-    class Processor_leon3_funclt : public sc_module{
+    class Processor_leon3_funclt : public sc_module, public Checkpointable{
       private:
         bool resetCalled;
         void beginOp();
@@ -80,6 +84,42 @@ namespace leon3_funclt_trap{
         unsigned int raisedExceptionPC;
         unsigned int raisedExceptionNPC;
         vmap<unsigned int, CacheElem> instrCache;
+        vmap<unsigned int, BlockCacheElem *> blockCache;
+        BlockCacheElem *curBlock;
+        static const unsigned int BLOCK_MAX_INSTRS = 64;
+        static const unsigned int BLOCK_CACHE_MAX_BLOCKS = 65536;
+        static const unsigned int BLOCK_TRANSLATE_THRESHOLD = 16;
+        Translator translator;
+        void translateBlock( BlockCacheElem * block );
+        bool isBlockEnd( int instrId ) const throw();
+        void recordBlockInstr( unsigned int curPC, unsigned int bitString, int instrId );
+        unsigned int runBlock( BlockCacheElem *block );
+        unsigned int executeInstr();
+        bool isAtomic( int instrId ) const throw();
+        /// True if the core powered down or spins in a branch to itself
+        bool isIdle();
+        /// Let simulated time pass until an interrupt ends the idle state
+        void waitIdle();
+        bool issueToolsHost( unsigned int curPC, Instruction *instr );
+        /// Activate the tools; on a host thread only tool hits go to the kernel
+        inline bool issueTools( unsigned int curPC, Instruction *instr ){
+            if(this->inSlice){
+                return this->toolManager.emptyPipeline(curPC) && this->issueToolsHost(curPC, instr);
+            }
+            return this->toolManager.newIssue(curPC, instr);
+        }
+        /// Atomic instructions of host thread slices are serialized between the cores
+        inline unsigned int execute( Instruction *instr ){
+            if(this->inSlice && this->isAtomic(instr->getId())){
+                boost::mutex::scoped_lock lock(HostQuantum::instance().atomic_mutex());
+                return instr->behavior();
+            }
+            return instr->behavior();
+        }
+        sc_time sliceEnd;
+        unsigned int sliceInstructions;
+        void invalidateBlock( unsigned int startPC );
+        void flushBlockCache();
         static int numInstances;
         unsigned int IRQ;
 
@@ -88,9 +128,17 @@ namespace leon3_funclt_trap{
         SC_HAS_PROCESS(Processor_leon3_funclt);
         Processor_leon3_funclt(sc_module_name name, MemoryInterface *memory = NULL, sc_time latency = sc_time(10, sc_core::SC_NS), bool pow_mon = false);
         void mainLoop();
+        /// Prepare a host thread slice of one quantum (SystemC context)
+        void beginSlice();
+        /// Execute instructions until the slice is used up (host thread)
+        void runSlice();
         void resetOp();
         void start_of_simulation();
         void end_of_simulation();
+        /// Save registers, register windows and the run state
+        void checkpoint_save(CheckpointArchive &ar);
+        /// Restore registers, register windows and the run state and drop the recorded blocks
+        void checkpoint_restore(const CheckpointArchive &ar);
         void power_model();
         void triggerException(unsigned int exception);
         tlm_utils::tlm_quantumkeeper quantKeeper;
@@ -115,6 +163,7 @@ namespace leon3_funclt_trap{
         Alias LR;
         Alias SP;
         Alias PCR;
+        RegisterWindows windows;
         Alias REGS[32];
         MemoryInterface *mem;
         MemoryInterface &instrMem;
@@ -131,7 +180,21 @@ namespace leon3_funclt_trap{
         IntrTLMPort_32 IRQ_port;
         PinTLM_out_32 irqAck;
         sr_param<bool> historyEnabled;
+        /// Execute recorded basic blocks of pre-decoded instructions
+        sr_param<bool> blockCacheEnabled;
+        /// Run hot blocks as threaded code (requires blockCacheEnabled)
+        sr_param<bool> translationEnabled;
+        /// Skip power-down and idle loops up to the next interrupt
+        sr_param<bool> idleSkipEnabled;
         bool m_pow_mon;
+        /// Host thread client running the quanta of this core, NULL runs
+        /// on the SystemC thread (set by the owning Leon3)
+        HostQuantum::Client *host;
+        /// Set while a slice executes on the host thread
+        bool inSlice;
+        /// Binary trace of the executed instructions, NULL disables it
+        /// (set by the owning Leon3)
+        TraceWriter::Channel *tracer;
         void setProfilingRange( unsigned int startAddr, unsigned int endAddr );
         IRQ_IRQ_Instruction * IRQ_irqInstr;
         ~Processor_leon3_funclt();
@@ -0,0 +1,140 @@
+/***************************************************************************\
+ *
+ *   
+ *         _/        _/_/_/_/    _/_/    _/      _/   _/_/_/
+ *        _/        _/        _/    _/  _/_/    _/         _/
+ *       _/        _/_/_/    _/    _/  _/  _/  _/     _/_/
+ *      _/        _/        _/    _/  _/    _/_/         _/
+ *     _/_/_/_/  _/_/_/_/    _/_/    _/      _/   _/_/_/
+ *   
+ *
+ *
+ *   
+ *   This file is part of LEON3.
+ *   
+ *   LEON3 is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *   
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *   or see <http://www.gnu.org/licenses/>.
+ *   
+ *
+ *
+ *   (c) agent, 2026
+ *
+\***************************************************************************/
+
+
+
+
+#include "gaisler/leon3/intunit/translator.hpp"
+#include "gaisler/leon3/intunit/registers.hpp"
+#include "gaisler/leon3/intunit/alias.hpp"
+
+using namespace leon3_funclt_trap;
+
+// The handlers mirror the behavior() of the corresponding instruction
+// classes: IncrementPC, compute, WB_plain, zero additional cycles
+#define TRANSLATED_OP(name, expr) \
+    static unsigned int name( const TranslatedOp & op, Reg32_3 & PC, Reg32_3 & NPC ){ \
+        unsigned int rs1_op = *op.rs1; \
+        PC = NPC; \
+        NPC += 4; \
+        *op.rd = (expr); \
+        return 0; \
+    }
+
+TRANSLATED_OP(and_imm, rs1_op & op.imm)
+TRANSLATED_OP(and_reg, rs1_op & (unsigned int)*op.rs2)
+TRANSLATED_OP(andn_imm, rs1_op & ~op.imm)
+TRANSLATED_OP(andn_reg, rs1_op & ~(unsigned int)*op.rs2)
+TRANSLATED_OP(or_imm, rs1_op | op.imm)
+TRANSLATED_OP(or_reg, rs1_op | (unsigned int)*op.rs2)
+TRANSLATED_OP(orn_imm, rs1_op | ~op.imm)
+TRANSLATED_OP(orn_reg, rs1_op | ~(unsigned int)*op.rs2)
+TRANSLATED_OP(xor_imm, rs1_op ^ op.imm)
+TRANSLATED_OP(xor_reg, rs1_op ^ (unsigned int)*op.rs2)
+TRANSLATED_OP(xnor_imm, rs1_op ^ ~op.imm)
+TRANSLATED_OP(xnor_reg, rs1_op ^ ~(unsigned int)*op.rs2)
+TRANSLATED_OP(sll_imm, rs1_op << op.imm)
+TRANSLATED_OP(sll_reg, rs1_op << ((unsigned int)*op.rs2 & 0x0000001f))
+TRANSLATED_OP(srl_imm, rs1_op >> op.imm)
+TRANSLATED_OP(srl_reg, rs1_op >> ((unsigned int)*op.rs2 & 0x0000001f))
+TRANSLATED_OP(sra_imm, (unsigned int)(((int)rs1_op) >> op.imm))
+TRANSLATED_OP(sra_reg, (unsigned int)(((int)rs1_op) >> ((unsigned int)*op.rs2 & 0x0000001f)))
+TRANSLATED_OP(add_imm, rs1_op + op.imm)
+TRANSLATED_OP(add_reg, rs1_op + (unsigned int)*op.rs2)
+TRANSLATED_OP(sub_imm, rs1_op - op.imm)
+TRANSLATED_OP(sub_reg, rs1_op - (unsigned int)*op.rs2)
+
+static unsigned int sethi( const TranslatedOp & op, Reg32_3 & PC, Reg32_3 & NPC ){
+    PC = NPC;
+    NPC += 4;
+    *op.rd = op.imm;
+    return 0;
+}
+
+leon3_funclt_trap::TranslatedOp::TranslatedOp() : handler(NULL), rd(NULL), rs1(NULL), \
+    rs2(NULL), imm(0){
+
+}
+
+bool leon3_funclt_trap::Translator::translate( unsigned int bitString, int instrId, \
+    Alias * REGS, TranslatedOp & op ) const throw(){
+    // Same field extraction as the setParams of the instruction classes
+    op.handler = NULL;
+    op.rd = &REGS[(bitString & 0x3e000000) >> 25];
+    op.rs1 = &REGS[(bitString & 0x7c000) >> 14];
+    op.rs2 = &REGS[bitString & 0x1f];
+    op.imm = (unsigned int)(((int)((bitString & 0x1fff) << 19)) >> 19);
+
+    switch(instrId){
+        case 36:
+            op.imm = 0xfffffc00 & ((bitString & 0x3fffff) << 10);
+            op.handler = sethi;
+        break;
+        case 37: op.handler = and_imm; break;
+        case 38: op.handler = and_reg; break;
+        case 41: op.handler = andn_imm; break;
+        case 42: op.handler = andn_reg; break;
+        case 45: op.handler = or_imm; break;
+        case 46: op.handler = or_reg; break;
+        case 49: op.handler = orn_imm; break;
+        case 50: op.handler = orn_reg; break;
+        case 53: op.handler = xor_imm; break;
+        case 54: op.handler = xor_reg; break;
+        case 57: op.handler = xnor_imm; break;
+        case 58: op.handler = xnor_reg; break;
+        case 61:
+        case 63:
+        case 65:
+            // The interpreter shifts by the whole simm13 field; only the
+            // encodings where this equals the 5 bit shift count are taken
+            op.imm = bitString & 0x1fff;
+            if(op.imm > 31){
+                return false;
+            }
+            op.handler = (instrId == 61)? sll_imm : ((instrId == 63)? srl_imm : sra_imm);
+        break;
+        case 62: op.handler = sll_reg; break;
+        case 64: op.handler = srl_reg; break;
+        case 66: op.handler = sra_reg; break;
+        case 67: op.handler = add_imm; break;
+        case 68: op.handler = add_reg; break;
+        case 79: op.handler = sub_imm; break;
+        case 80: op.handler = sub_reg; break;
+        default:
+        break;
+    }
+    return op.handler != NULL;
+}
@@ -0,0 +1,93 @@
+/***************************************************************************\
+ *
+ *   
+ *         _/        _/_/_/_/    _/_/    _/      _/   _/_/_/
+ *        _/        _/        _/    _/  _/_/    _/         _/
+ *       _/        _/_/_/    _/    _/  _/  _/  _/     _/_/
+ *      _/        _/        _/    _/  _/    _/_/         _/
+ *     _/_/_/_/  _/_/_/_/    _/_/    _/      _/   _/_/_/
+ *   
+ *
+ *
+ *   
+ *   This file is part of LEON3.
+ *   
+ *   LEON3 is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *   
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *   
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the
+ *   Free Software Foundation, Inc.,
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *   or see <http://www.gnu.org/licenses/>.
+ *   
+ *
+ *
+ *   (c) agent, 2026
+ *
+\***************************************************************************/
+
+
+
+#ifndef LT_TRANSLATOR_HPP
+#define LT_TRANSLATOR_HPP
+
+#include "gaisler/leon3/intunit/registers.hpp"
+#include "gaisler/leon3/intunit/alias.hpp"
+
+#define FUNC_MODEL
+#define LT_IF
+namespace leon3_funclt_trap{
+
+    class TranslatedOp;
+
+    typedef unsigned int (*TranslatedHandler)( const TranslatedOp & op, Reg32_3 & PC, \
+        Reg32_3 & NPC );
+
+};
+
+namespace leon3_funclt_trap{
+
+    /// Threaded-code form of one instruction: a direct call to a handler
+    /// with the operands already bound to the register aliases. A NULL
+    /// handler means that the instruction has to be run through its
+    /// interpreter class.
+    class TranslatedOp{
+
+        public:
+        TranslatedOp();
+        TranslatedHandler handler;
+        Alias * rd;
+        Alias * rs1;
+        Alias * rs2;
+        unsigned int imm;
+    };
+
+};
+
+namespace leon3_funclt_trap{
+
+    /// Translates the plain integer instructions (logic, shift, ADD/SUB
+    /// without condition codes and SETHI) to threaded code. Everything
+    /// that touches the condition codes, the memory, the ASIs, the windows
+    /// or the control flow is left to the interpreter, so that a block can
+    /// freely mix translated and interpreted instructions.
+    class Translator{
+
+        public:
+        bool translate( unsigned int bitString, int instrId, Alias * REGS, TranslatedOp \
+            & op ) const throw();
+    };
+
+};
+
+
+
+#endif
@@ -22,6 +22,8 @@
 
 SR_HAS_MODULE(Leon3);
 
+std::vector<Leon3 *> Leon3::s_parallel;
+
 /// Constructor
 Leon3::Leon3(
       ModuleName name,
@@ -89,6 +91,9 @@ Leon3::Leon3(
   debugger(NULL),
   m_intrinsics("intrinsics", *(cpu.abiIf)),
   g_gdb("gdb", 0, m_generics),
+  g_parallel("parallel", false, m_generics),
+  g_quantum("quantum", 10000, m_generics),
+  g_trace("trace", false, m_generics),
   g_icen("icen", icen, m_generics),
   g_irepl("irepl", irepl, m_generics),
   g_isets("isets", isets, m_generics),
@@ -192,6 +197,52 @@ void Leon3::start_of_simulation() {
   cpu.ENTRY_POINT   = 0x0;
   cpu.MPROC_ID      = (g_hindex) << 28;
   g_args_callback(g_args, gs::cnf::no_callback);
+
+  if (g_trace) {
+    if (TraceWriter::instance().is_open()) {
+      cpu.tracer = TraceWriter::instance().channel(cpu.name());
+      m_tracer = TraceWriter::instance().channel(name());
+    } else {
+      v::warn << name() << "Tracing enabled but no trace file is open" << v::endl;
+    }
+  }
+
+  if (g_parallel) {
+    // The debugger and the history log need the SystemC thread
+    if (debugger || cpu.historyEnabled) {
+      v::warn << name() << "Parallel mode is not available with gdb or history, running on the SystemC thread" << v::endl;
+    } else {
+      tlm_utils::tlm_quantumkeeper::set_global_quantum(sc_core::sc_time(static_cast<double>(g_quantum), SC_NS));
+      cpu.quantKeeper.reset();
+      cpu.host = this;
+      cpu.IRQ_port.deferred = true;
+      s_parallel.push_back(this);
+      HostQuantum::instance().attach(this);
+    }
+  }
+}
+
+void Leon3::slice_begin() {
+  m_defer_snoops = true;
+  cpu.beginSlice();
+}
+
+void Leon3::slice_run() {
+  cpu.runSlice();
+}
+
+void Leon3::slice_end() {
+  m_defer_snoops = false;
+  apply_deferred_snoops();
+  for (std::vector<Leon3 *>::iterator other = s_parallel.begin(); other != s_parallel.end(); ++other) {
+    if (*other == this) {
+      continue;
+    }
+    for (std::vector<t_snoop>::iterator store = m_dmi_stores.begin(); store != m_dmi_stores.end(); ++store) {
+      (*other)->snoopingCallBack(*store, SC_ZERO_TIME);
+    }
+  }
+  m_dmi_stores.clear();
 }
 
 void Leon3::clkcng() {
@@ -205,6 +256,9 @@ gs::cnf::callback_return_type Leon3::g_gdb_callback(gs::gs_param_base& changed_p
   if(port) {
     debugger = new GDBStub<uint32_t>(*(cpu.abiIf));
     cpu.toolManager.addTool(*debugger);
+    // The debugger relies on instrEndEvent after every single instruction
+    cpu.blockCacheEnabled = false;
+    cpu.idleSkipEnabled = false;
     debugger->initialize(port);
   } else {
     //delete debugger;
@@ -238,7 +292,7 @@ unsigned int Leon3::read_instr(const unsigned int & address, const unsigned int
 
     //Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
 //std::cout << "Quantum (external) sync" << std::endl;
       this->cpu.quantKeeper.sync();
     }
@@ -246,7 +300,7 @@ unsigned int Leon3::read_instr(const unsigned int & address, const unsigned int
     //with the host endianess; in case they are different, the endianess
     //is turned
     swapEndianess(datum);
-    v::debug << name() << "Read word:0x" << hex << v::setw(8) << v::setfill('0')
+    V_LOG(m_verbosity, v::debug) << name() << "Read word:0x" << hex << v::setw(8) << v::setfill('0')
              << datum << ", from:0x" << hex << v::setw(8) << v::setfill('0')
              << address << endl;
     return datum;
@@ -260,6 +314,9 @@ sc_dt::uint64 Leon3::read_dword(
     const uint32_t lock) throw() {
 
     sc_dt::uint64 datum = 0;
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(datum));
+    }
     sc_time delay = this->cpu.quantKeeper.get_local_time();
     uint32_t debug = 0;
     tlm::tlm_response_status response = tlm::TLM_INCOMPLETE_RESPONSE;
@@ -279,7 +336,7 @@ sc_dt::uint64 Leon3::read_dword(
 
     //Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
         this->cpu.quantKeeper.sync();
     }
 
@@ -302,6 +359,9 @@ uint32_t Leon3::read_word(
     const uint32_t lock) throw() {
 
     uint32_t datum = 0;
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(datum));
+    }
     sc_time delay = this->cpu.quantKeeper.get_local_time();
     uint32_t debug = 0;
     tlm::tlm_response_status response = tlm::TLM_INCOMPLETE_RESPONSE;
@@ -321,7 +381,7 @@ uint32_t Leon3::read_word(
 
     //Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
       this->cpu.quantKeeper.sync();
     }
     //Now the code for endianess conversion: the processor is always modeled
@@ -330,7 +390,7 @@ uint32_t Leon3::read_word(
     #ifdef LITTLE_ENDIAN_BO
     swapEndianess(datum);
     #endif
-    v::debug << name() << "Read word:0x" << hex << v::setw(8) << v::setfill('0')
+    V_LOG(m_verbosity, v::debug) << name() << "Read word:0x" << hex << v::setw(8) << v::setfill('0')
              << datum << ", from:0x" << hex << v::setw(8) << v::setfill('0')
              << address << endl;
 
@@ -345,6 +405,9 @@ uint16_t Leon3::read_half(
     const uint32_t lock) throw() {
 
     uint16_t datum = 0;
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(datum));
+    }
     sc_time delay = this->cpu.quantKeeper.get_local_time();
     uint32_t debug = 0;
     tlm::tlm_response_status response = tlm::TLM_INCOMPLETE_RESPONSE;
@@ -364,7 +427,7 @@ uint16_t Leon3::read_half(
 
     //Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
         this->cpu.quantKeeper.sync();
     }
 
@@ -383,6 +446,9 @@ uint8_t Leon3::read_byte(
     const uint32_t lock) throw() {
 
     uint8_t datum = 0;
+    if(this->debugger != NULL){
+        this->debugger->notifyRead(address, sizeof(datum));
+    }
     sc_time delay = this->cpu.quantKeeper.get_local_time();
     uint32_t debug = 0;
     tlm::tlm_response_status response = tlm::TLM_INCOMPLETE_RESPONSE;
@@ -402,7 +468,7 @@ uint8_t Leon3::read_byte(
 
     // Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
         this->cpu.quantKeeper.sync();
     }
 
@@ -445,7 +511,7 @@ void Leon3::write_dword(
 
     //Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
         this->cpu.quantKeeper.sync();
     }
 }
@@ -462,7 +528,7 @@ void Leon3::write_word(
     //is turned
     swapEndianess(datum);
     if(this->debugger != NULL){
-        v::debug << name() << "Debugger" << endl;
+        V_LOG(m_verbosity, v::debug) << name() << "Debugger" << endl;
         this->debugger->notifyAddress(address, sizeof(datum));
     }
     sc_time delay = this->cpu.quantKeeper.get_local_time();
@@ -482,13 +548,13 @@ void Leon3::write_word(
         false,
         response);
 
-    v::debug << name() << "Wrote word:0x" << hex << v::setw(8) << v::setfill('0')
+    V_LOG(m_verbosity, v::debug) << name() << "Wrote word:0x" << hex << v::setw(8) << v::setfill('0')
              << datum << ", at:0x" << hex << v::setw(8) << v::setfill('0')
              << address << endl;
 
     //Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
       this->cpu.quantKeeper.sync();
     }
 }
@@ -528,7 +594,7 @@ void Leon3::write_half(
 
     // Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
         this->cpu.quantKeeper.sync();
     }
 }
@@ -563,7 +629,7 @@ void Leon3::write_byte(
 
     //Now lets keep track of time
     this->cpu.quantKeeper.set(delay);
-    if(this->cpu.quantKeeper.need_sync()){
+    if(!this->cpu.inSlice && this->cpu.quantKeeper.need_sync()){
         this->cpu.quantKeeper.sync();
     }
 }
@@ -763,6 +829,69 @@ void Leon3::write_byte_dbg(const uint32_t &address, uint8_t datum) throw() {
         response);
 }
 
+// Debug reads bypass the caches, so a block is read with one transport per
+// MMU page instead of one per byte. The bytes arrive in target order.
+void Leon3::read_block_dbg(const uint32_t &address, uint8_t *data, uint32_t len) throw() {
+    uint32_t debug = 0;
+    sc_time delay = this->cpu.quantKeeper.get_local_time();
+    tlm::tlm_response_status response = tlm::TLM_INCOMPLETE_RESPONSE;
+
+    uint32_t done = 0;
+    while(done < len) {
+        uint32_t addr = address + done;
+        uint32_t chunk = 0x1000 - (addr & 0xfff);
+        if(chunk > len - done) {
+            chunk = len - done;
+        }
+
+        exec_data(
+            tlm::TLM_READ_COMMAND,
+            addr,
+            data + done,
+            chunk,
+            8,
+            &debug,
+            0,
+            0,
+            delay,
+            true,
+            response);
+
+        done += chunk;
+    }
+}
+
+// Debug writes update hitting cache lines, so the block is written in
+// aligned words (bytes at unaligned ends).
+void Leon3::write_block_dbg(const uint32_t &address, const uint8_t *data, uint32_t len) throw() {
+    uint32_t debug = 0;
+    sc_time delay = this->cpu.quantKeeper.get_local_time();
+    tlm::tlm_response_status response = tlm::TLM_INCOMPLETE_RESPONSE;
+
+    uint32_t done = 0;
+    while(done < len) {
+        uint32_t addr = address + done;
+        uint32_t chunk = ((addr & 0x3) || (len - done < 4)) ? 1 : 4;
+        uint8_t buf[4];
+        memcpy(buf, data + done, chunk);
+
+        exec_data(
+            tlm::TLM_WRITE_COMMAND,
+            addr,
+            buf,
+            chunk,
+            8,
+            &debug,
+            0,
+            0,
+            delay,
+            true,
+            response);
+
+        done += chunk;
+    }
+}
+
 void Leon3::lock() {
 
 }
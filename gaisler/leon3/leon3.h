@@ -29,6 +29,7 @@
 #include "core/common/sr_signal.h"
 #include "core/common/ahbmaster.h"
 #include "core/common/clkdevice.h"
+#include "core/common/hostquantum.h"
 
 #include "core/common/verbose.h"
 #include "gaisler/leon3/mmucache/mmu_cache_base.h"
@@ -46,7 +47,8 @@
 /// Top-level class of the memory sub-system for the TrapGen LEON3 simulator
 class Leon3 :
   public mmu_cache_base,
-  public leon3_funclt_trap::MemoryInterface {
+  public leon3_funclt_trap::MemoryInterface,
+  public HostQuantum::Client {
 
   typedef leon3_funclt_trap::Processor_leon3_funclt LEON3;
 
@@ -118,15 +120,33 @@ class Leon3 :
       virtual void write_word_dbg( const unsigned int & address, unsigned int datum ) throw();
       virtual void write_half_dbg( const unsigned int & address, unsigned short int datum ) throw();
       virtual void write_byte_dbg( const unsigned int & address, unsigned char datum ) throw();
+      virtual void read_block_dbg( const unsigned int & address, unsigned char * data, unsigned int len ) throw();
+      virtual void write_block_dbg( const unsigned int & address, const unsigned char * data, unsigned int len ) throw();
       virtual void lock();
       virtual void unlock();
       virtual void trigger_exception(unsigned int exception);
 
+      /// Latch interrupts and queue snoops for the next host thread slice
+      virtual void slice_begin();
+      /// Execute one quantum of the processor on its host thread
+      virtual void slice_run();
+      /// Apply the snoops queued during the slice and let the other
+      /// parallel cores snoop the DMI stores of this one
+      virtual void slice_end();
+
     LEON3 cpu;
     GDBStub<uint32_t> *debugger;
     IntrinsicManager<uint32_t> m_intrinsics;
 
     sr_param<int> g_gdb;
+    /// Run the processor on its own host thread, synchronized with the
+    /// other parallel cores and the platform at quantum boundaries
+    sr_param<bool> g_parallel;
+    /// Quantum of the parallel mode in ns
+    sr_param<uint32_t> g_quantum;
+    /// Write executed instructions and memory accesses to the binary
+    /// trace (TraceWriter), the trace file is opened by the platform
+    sr_param<bool> g_trace;
     sr_param<std::string> g_history;
     sr_param<std::string> g_osemu;
     /// icache enable
@@ -167,6 +187,10 @@ class Leon3 :
     //sr_param<uint32_t> g_hindex;
     sr_param<std::vector<std::string> > g_args;
     sr_param<std::string> g_stdout_filename;
+
+  private:
+    /// All cores running in parallel mode
+    static std::vector<Leon3 *> s_parallel;
 };
 
 #endif //__MMU_CACHE_H__
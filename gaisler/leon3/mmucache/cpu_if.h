@@ -48,6 +48,21 @@ class cpu_if {
         this->write_byte(address, datum, 0x8, 0, 0);
     }
 
+    /// Debug read of a memory block in target byte order.
+    /// The default reads byte by byte, processors override it with larger accesses.
+    virtual void read_block_dbg(const uint32_t &address, uint8_t *data, uint32_t len) {
+        for(uint32_t i = 0; i < len; i++){
+            data[i] = this->read_byte_dbg(address + i);
+        }
+    }
+
+    /// Debug write of a memory block in target byte order
+    virtual void write_block_dbg(const uint32_t &address, const uint8_t *data, uint32_t len) {
+        for(uint32_t i = 0; i < len; i++){
+            this->write_byte_dbg(address + i, data[i]);
+        }
+    }
+
     virtual void lock() = 0;
     virtual void unlock() = 0;
     inline void swapEndianess(uint32_t & datum) const throw() {
@@ -1,8 +1,8 @@
 
 #include "defines.h"
 
-const uint32_t t_cache_line::VALID = 0x00000000;
-const uint32_t t_cache_line::ATAG =  0x00000004;
-const uint32_t t_cache_line::LRR =   0x00000008;
-const uint32_t t_cache_line::LRU =   0x0000000C;
-const uint32_t t_cache_line::LOCK =  0x00000010;
+const uint32_t t_cache_line::VALID;
+const uint32_t t_cache_line::ATAG;
+const uint32_t t_cache_line::LRR;
+const uint32_t t_cache_line::LRU;
+const uint32_t t_cache_line::LOCK;
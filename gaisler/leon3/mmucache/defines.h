@@ -244,11 +244,11 @@ class t_cache_line : public sc_module, public scireg_ns::scireg_region_if {
           return scireg_ns::SCIREG_SUCCESS;
         }
 
-        static const uint32_t VALID ;
-        static const uint32_t ATAG  ;
-        static const uint32_t LRR   ;
-        static const uint32_t LRU   ;
-        static const uint32_t LOCK  ;
+        static const uint32_t VALID = 0x00000000;
+        static const uint32_t ATAG  = 0x00000004;
+        static const uint32_t LRR   = 0x00000008;
+        static const uint32_t LRU   = 0x0000000C;
+        static const uint32_t LOCK  = 0x00000010;
 
   protected:
         sc_core::sc_object *parent;
@@ -257,6 +257,58 @@ class t_cache_line : public sc_module, public scireg_ns::scireg_region_if {
 
 //} t_cache_line;
 
+// scireg view of a packed cache data array (vectorcache flat storage).
+// Unlike t_cache_data no callbacks are executed on simulation accesses.
+class t_cache_flat_view : public scireg_ns::scireg_region_if {
+  public:
+    t_cache_flat_view(const char *name, uint8_t *data, const uint32_t size) :
+      scireg_ns::scireg_region_if(),
+      m_name(name),
+      m_data(data),
+      m_size(size) {}
+
+    /// Get the region_type of this region:
+    virtual scireg_ns::scireg_response scireg_get_region_type(scireg_ns::scireg_region_type& t) const {
+      t = scireg_ns::SCIREG_MEMORY;
+      return scireg_ns::SCIREG_SUCCESS;
+    }
+
+    /// Write a vector of "size" bytes at given offset in this region:
+    virtual scireg_ns::scireg_response scireg_write(const scireg_ns::vector_byte& v, sc_dt::uint64 size, sc_dt::uint64 offset=0) {
+      if (offset + size > m_size) {
+        return scireg_ns::SCIREG_FAILURE;
+      }
+      memcpy(&m_data[offset], &v[0], size);
+      return scireg_ns::SCIREG_SUCCESS;
+    }
+
+    /// Read a vector of "size" bytes at given offset in this region:
+    virtual scireg_ns::scireg_response scireg_read(scireg_ns::vector_byte& v, sc_dt::uint64 size, sc_dt::uint64 offset=0) const {
+      if (offset + size > m_size) {
+        return scireg_ns::SCIREG_FAILURE;
+      }
+      memcpy(&v[0], &m_data[offset], size);
+      return scireg_ns::SCIREG_SUCCESS;
+    }
+
+    virtual sc_dt::uint64 scireg_get_bit_width() const {
+      return m_size * 8;
+    }
+
+    virtual scireg_ns::scireg_response scireg_get_string_attribute(const char *& s, scireg_ns::scireg_string_attribute_type t) const {
+      if (t == scireg_ns::SCIREG_NAME) {
+        s = m_name.c_str();
+        return scireg_ns::SCIREG_SUCCESS;
+      }
+      return scireg_ns::SCIREG_UNSUPPORTED;
+    }
+
+  private:
+    std::string m_name;
+    uint8_t *m_data;
+    uint32_t m_size;
+};
+
 // structure of a tlb entry (page descriptor cache entry)
 // ========================
 // virtual address tag:
@@ -269,18 +321,20 @@ class t_cache_line : public sc_module, public scireg_ns::scireg_region_if {
 // context tag      - ?? bits
 // page table entry - 24bit
 
+// virtual address tag
+typedef unsigned int t_VAT;
+
 // page descriptor cache entry
 typedef struct {
   unsigned int tlb_no;
+  bool valid;
+  t_VAT vpn;
   unsigned int context;
   unsigned int pte;
   uint64_t lru;
   uint64_t page_size;
 } t_PTE_context;
 
-// virtual address tag
-typedef unsigned int t_VAT;
-
 // payload pointer
 typedef tlm::tlm_generic_payload *gp_ptr;
 
@@ -219,6 +219,18 @@ void localram::end_of_simulation() {
 
 }
 
+// Save the scratchpad content
+void localram::checkpoint_save(CheckpointArchive &ar) {
+  ar.put("data", scratchpad->c, m_lrsize);
+}
+
+// Restore the scratchpad content
+void localram::checkpoint_restore(const CheckpointArchive &ar) {
+  if (!ar.get("data", scratchpad->c, m_lrsize)) {
+    v::warn << name() << "Scratchpad size differs from checkpoint, content not restored" << v::endl;
+  }
+}
+
 // Helper for setting clock cycle latency using sc_clock argument
 void localram::clkcng(sc_core::sc_time &clk) {
   clockcycle = clk;
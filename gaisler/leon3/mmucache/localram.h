@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include "core/common/base.h"
 #include "core/common/sr_param.h"
+#include "core/common/checkpoint.h"
 
 #include "gaisler/leon3/mmucache/mem_if.h"
 #include "gaisler/leon3/mmucache/defines.h"
@@ -36,7 +37,7 @@
 // ! Address decoding and checking is done in class mmu_cache !
 
 /// @brief Local Scratchpad RAM
-class localram : public DefaultBase, public mem_if {
+class localram : public DefaultBase, public mem_if, public Checkpointable {
 
  public:
 
@@ -72,6 +73,12 @@ class localram : public DefaultBase, public mem_if {
   /// Hook up for showing statistics
   void end_of_simulation();
 
+  /// Save the scratchpad content
+  void checkpoint_save(CheckpointArchive &ar);
+
+  /// Restore the scratchpad content
+  void checkpoint_restore(const CheckpointArchive &ar);
+
   // Constructor
   // -----------
   /// @brief Constructor of scratchpad RAM implementation (localram)
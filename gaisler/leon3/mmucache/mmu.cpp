@@ -39,8 +39,8 @@ mmu::mmu(ModuleName name, // sysc module name,
 	    m_pseudo_rand(0),
 	    m_pow_mon(pow_mon),
             m_performance_counters("performance_counters"),
-            tihits("instruction_tlb_hits", 8, m_performance_counters),
-            tdhits("data_tlb_hits", 8, m_performance_counters),
+            tihits("instruction_tlb_hits", 32, m_performance_counters),
+            tdhits("data_tlb_hits", 32, m_performance_counters),
             timisses("instruction_tlb_misses", 0ull, m_performance_counters),
             tdmisses("data_tlb_misses", 0ull, m_performance_counters),
             sta_power_norm("power.mmu_cache.mmu.sta_power_norm", 7.19e+7, true), // Normalized static power of controller
@@ -64,11 +64,16 @@ mmu::mmu(ModuleName name, // sysc module name,
             dyn_dtlb_write_energy("dyn_dtlb_write_energy", 0.0, dtlbram), // dtlb write energy
             dyn_dtlb_reads("dyn_dtlb_reads", 0ull, dtlbram), // number of dtlb reads
             dyn_dtlb_writes("dyn_dtlb_writes", 0ull, dtlbram), // number of dtlb writes
-	    clockcycle(10, sc_core::SC_NS) {
+	    clockcycle(10, sc_core::SC_NS),
+            m_verbosity(this->name()) {
 
     // The number of instruction and data tlbs must be in the range of 2-32
     assert((m_itlbnum>=2)&&(m_itlbnum<=32));
     assert((m_dtlbnum>=2)&&(m_dtlbnum<=32));
+    // and a power of two: the log2 goes to the control register, and the
+    // tlb_array spreads the entries over a power-of-two number of sets
+    assert(!(m_itlbnum & (m_itlbnum - 1)));
+    assert(!(m_dtlbnum & (m_dtlbnum - 1)));
 
     m_api = gs::cnf::GCnf_Api::getApiInstance(this);
 
@@ -81,23 +86,23 @@ mmu::mmu(ModuleName name, // sysc module name,
     MMU_FAULT_STATUS_REG = 0;
     MMU_FAULT_ADDRESS_REG = 0;
 
-    // generate associative memory (map) for instruction tlb
-    itlb = new std::map<t_VAT, t_PTE_context>;
+    // generate set-associative memory for instruction tlb
+    itlb = new tlb_array(m_itlbnum, m_tlb_rep);
     itlb_adaptor = new tlb_adaptor("itlb_adaptor", _mmu_cache, this, itlb,
             m_itlbnum);
 
     // are we in split tlb mode?
     if (m_tlb_type == 0x0) {
 
-        // generate another associative memory (map) for data tlb
-        dtlb = new std::map<t_VAT, t_PTE_context>;
+        // generate another set-associative memory for data tlb
+        dtlb = new tlb_array(m_dtlbnum, m_tlb_rep);
         dtlb_adaptor = new tlb_adaptor("dtlb_adaptor", _mmu_cache, this, dtlb,
                 m_dtlbnum);
 
         // update MMU control register (ST)
         MMU_CONTROL_REG |= (1 << 14);
 
-        v::debug << this->name() << "Created split instruction and data TLBs."
+        V_LOG(m_verbosity, v::debug) << this->name() << "Created split instruction and data TLBs."
                 << v::endl;
 
     } else {
@@ -106,7 +111,7 @@ mmu::mmu(ModuleName name, // sysc module name,
         dtlb = itlb;
         dtlb_adaptor = itlb_adaptor;
 
-        v::debug << this->name()
+        V_LOG(m_verbosity, v::debug) << this->name()
                 << "Created combined instruction and data TLBs." << v::endl;
 
     }
@@ -158,7 +163,7 @@ mmu::mmu(ModuleName name, // sysc module name,
     //PM::send_idle(this,"idle",sc_time_stamp(),m_pow_mon);
 
     // Init execution statistic
-    for (uint32_t i=0; i<8; i++) {
+    for (uint32_t i=0; i<32; i++) {
       tihits[i] = 0;
       tdhits[i] = 0;
     }
@@ -230,7 +235,7 @@ signed mmu::get_physical_address( uint64_t * paddr, signed * prot, unsigned * ac
     //unsigned int idx1 = (vpn >> 12);
     //unsigned int idx2 = (vpn << 6) & 0x3e;
     //unsigned int idx3 = vpn & 0x3e;
-    v::debug << this->name() << "VPN: " << hex << vpn << " vtag_width " << hex << m_vtag_width<< endl;
+    V_LOG(m_verbosity, v::debug) << this->name() << "VPN: " << hex << vpn << " vtag_width " << hex << m_vtag_width<< endl;
     unsigned int idx1 = (vpn >> 12) & 0xff;
     unsigned int idx2 = (vpn >> 6) & 0x3f;
     unsigned int idx3 = vpn & 0x3f;
@@ -284,7 +289,7 @@ signed mmu::get_physical_address( uint64_t * paddr, signed * prot, unsigned * ac
     // [1-0] ET - Entry type. (0 - reserved, 1 - PTD, 2 - PTE, 3 - reserved)
 
     // tlb miss processing
-    v::debug << this->name()
+    V_LOG(m_verbosity, v::debug) << this->name()
             << "START TLB MISS PROCESSING FOR VIRTUAL ADDRESS: " << std::hex
             << vaddr << " with indices 1/2/3: " << idx1 << "/" << idx2 << "/" << idx3 << " for context: " << MMU_CONTEXT_REG << v::endl;
 
@@ -452,7 +457,7 @@ data_access_exception
 // look up a tlb (page descriptor cache)
 // and return physical address
 signed mmu::tlb_lookup(unsigned int addr, unsigned asi,
-                             std::map<t_VAT, t_PTE_context> * tlb,
+                             tlb_array * tlb,
                              unsigned int tlb_size, sc_core::sc_time * t,
                              unsigned int * debug, bool is_dbg, bool &cacheable,
                              unsigned is_write /* LOAD / STORE? */, uint64_t * paddr ) {
@@ -470,16 +475,10 @@ signed mmu::tlb_lookup(unsigned int addr, unsigned asi,
 
     
     // Locals for intermediate results
-    t_PTE_context tmp;
+    t_PTE_context * entry;
     *paddr = 0xffffffffffff0000ULL; // has size of 36bits!
     unsigned int pde;
 
-/*
-    // Search virtual address tag in ipdc (associative)
-    v::debug << this->name() << "Access with ADDR: " << std::hex << addr << " VPN: " << std::hex << vpn
-            << " and OFFSET: " << std::hex << offset << v::endl;
-    pdciter = tlb->find(vpn);
-
     // Log tlb reads for power monitoring
     if (m_pow_mon) {
       // All tlbs are read in parallel !
@@ -490,77 +489,67 @@ signed mmu::tlb_lookup(unsigned int addr, unsigned asi,
       }
     }
 
-    // TLB hit
-    if (pdciter != tlb->end()) {
+    // TLB lookup (TD - TLB disable bit 15 of control register)
+    entry = (MMU_CONTROL_REG & (1 << 15))? NULL : tlb->lookup(vpn, MMU_CONTEXT_REG);
 
-      // Read the PDC entry
-      tmp = pdciter->second;
+    // TLB hit
+    if (entry) {
 
-      v::debug << this->name() << "Virtual Address Tag Hit in TLB " << tmp.tlb_no << " for address: "
+        V_LOG(m_verbosity, v::debug) << this->name() << "Virtual Address Tag Hit in TLB " << entry->tlb_no << " for address: "
                 << hex << addr << v::endl;
 
-        // Check the context tag
-        if (tmp.context == MMU_CONTEXT_REG) {
+        // Check the access permissions of the cached PTE (AT, see get_physical_address).
+        // A violation, or the first write to an unmodified page, falls through
+        // to the table walk, which raises the fault or sets the modified bit.
+        unsigned is_instr = ! (asi & 0x2);
+        unsigned access_index = (is_write << 2) | (is_instr << 1) | (asi & 0x1);
 
-            v::debug << this->name() << "CONTEXT hit " << hex << MMU_CONTEXT_REG << v::endl;
+        if (! access_table[access_index][(entry->pte >> 2) & 0x7] &&
+            ! (is_write && ! (entry->pte & (1 << 6)))) {
 
             // Build physical address from PTE and offset, and return
-            //paddr = (((tmp.pte >> 8) << (32 - m_vtag_width)) | (addr & (tmp.page_size -1)));
-            *paddr = ((tmp.pte & ~0xff) << 4 | (addr & (tmp.page_size - 1)));
-            *paddr &= ((0x1ull << 36) - 1);
-            if ((tmp.pte & (1<<7)) == 0) {
-              v::debug << this->name() << "data not cacheable!" << v::endl;
+            *paddr = ((entry->pte & ~0xFF) << 4 | (addr & (entry->page_size - 1)));
+            *paddr &= (((uint64_t)1 << 36) - 1);
+            if ((entry->pte & (1<<7)) == 0) {
+              V_LOG(m_verbosity, v::debug) << this->name() << "data not cacheable!" << v::endl;
               cacheable = false;
             } else {
               cacheable = true;
             }
 
-            // Update debug information
-            TLBHIT_SET(*debug);
-
-            if (tlb == itlb) {
-                tihits[tmp.tlb_no]++;
-            } else {
-                tdhits[tmp.tlb_no]++;
-            }
-
-            // Update LRU history
-            if (m_tlb_rep==0) {
-                lru_update(vpn, tlb, tlb_size);
-            }
-            return 0;
-        } else {
+            // Debug accesses do not change statistics or replacement history
+            if (! is_dbg) {
 
-            v::debug << this->name() << "CONTEXT miss" << v::endl;
+                // Update debug information
+                TLBHIT_SET(*debug);
 
-            // Update debug information
-            TLBMISS_SET(*debug);
+                if (tlb == itlb) {
+                    tihits[entry->tlb_no]++;
+                } else {
+                    tdhits[entry->tlb_no]++;
+                }
 
-            if (tlb == itlb) {
-                timisses++;
-            } else {
-	        tdmisses++;
+                // Update LRU history
+                if (m_tlb_rep==0) {
+                    tlb->touch(entry);
+                }
             }
+            return 0;
         }
-    } else {
+    } else if (! is_dbg) {
 
-        v::debug << this->name() << "Virtual Address Tag miss" << v::endl;
+        V_LOG(m_verbosity, v::debug) << this->name() << "Virtual Address Tag miss" << v::endl;
 
         // Update debug information
         TLBMISS_SET(*debug);
 
-	      if (tlb == itlb) {
-	        timisses++;
-	      } else {
-	        tdmisses++;
-	      }
+        if (tlb == itlb) {
+            timisses++;
+        } else {
+            tdmisses++;
+        }
     }
 
-*/
-
-
-
-    
     uint64_t page_size;
     unsigned access_index;
     signed error_code = get_physical_address( paddr, NULL, &access_index,
@@ -634,36 +623,27 @@ signed mmu::tlb_lookup(unsigned int addr, unsigned asi,
 
     switch (pde & 0x3) {
     case 0x2:
-        v::debug << this->name() << ((error_code >> 8) & 0x3) << "-Level Page Table returned PTE: "
+        V_LOG(m_verbosity, v::debug) << this->name() << ((error_code >> 8) & 0x3) << "-Level Page Table returned PTE: "
                 << std::hex << pde << v::endl;
 
-        // In case of a virtual address tag miss a new PDC entry is created.
-        // For context miss the existing entry will be replaced.
-        if (tlb->size() == tlb_size) {
-            v::debug << this->name() << "TLB full" << std::hex << pde  << v::endl;
+        // In case of a virtual address tag or context miss a new PDC
+        // entry is created. A refill of a known translation is done in place.
+        if (! (MMU_CONTROL_REG & (1 << 15))) {
 
-            // Remove a TLB entry, with respect to replacement strategy
-            tmp.tlb_no = tlb_remove(tlb, tlb_size);
-        } else {
-            v::debug << this->name() << "Create new entry PDC entry - TLB number: " << tlb->size() << v::endl;
-            tmp.tlb_no = tlb->size();
-        }
+            entry = tlb->allocate(vpn, MMU_CONTEXT_REG);
+            entry->pte = pde;
+            entry->page_size = page_size;
+
+            V_LOG(m_verbosity, v::debug) << this->name() << "Create new PDC entry - TLB number: " << entry->tlb_no << v::endl;
 
-        // add to PDC
-        tmp.context = MMU_CONTEXT_REG;
-        tmp.pte = pde;
-        tmp.lru = 0xffffffffffffffff - 1;
-        tmp.page_size = page_size;
-
-        (*tlb)[vpn] = tmp;
-
-        // Log TLB writes for power monitoring
-        if (m_pow_mon) {
-          if (tlb == itlb) {
-            dyn_itlb_writes++;
-          } else {
-            dyn_dtlb_writes++;
-          }
+            // Log TLB writes for power monitoring
+            if (m_pow_mon) {
+              if (tlb == itlb) {
+                dyn_itlb_writes++;
+              } else {
+                dyn_dtlb_writes++;
+              }
+            }
         }
 
         // build physical address from PTE and offset
@@ -671,13 +651,13 @@ signed mmu::tlb_lookup(unsigned int addr, unsigned asi,
         *paddr &= (((uint64_t)1 << 36) - 1);
 
         if ((pde & (1<<7)) == 0) {
-          v::debug << this->name() << "data not cacheable!" << v::endl;
+          V_LOG(m_verbosity, v::debug) << this->name() << "data not cacheable!" << v::endl;
           cacheable = false;
         } else {
           cacheable = true;
         }
 
-        v::debug << this->name() << "Mapping complete - Virtual Addr: "
+        V_LOG(m_verbosity, v::debug) << this->name() << "Mapping complete - Virtual Addr: "
                 << std::hex << addr << " Physical Addr: " << std::hex << paddr
                 << v::endl;
         return 0;
@@ -686,7 +666,7 @@ signed mmu::tlb_lookup(unsigned int addr, unsigned asi,
         if( ((error_code >> 8) & 0x3) == 3 ) // if level 3 goto DEFAULT
             break;
         // can otherwise only happen in level 1 or 2
-        v::debug << this->name() << ((error_code >> 8) & 0x3) << "-Level Page Table returned PTD: "
+        V_LOG(m_verbosity, v::debug) << this->name() << ((error_code >> 8) & 0x3) << "-Level Page Table returned PTD: "
                 << std::hex << pde << v::endl;
         break;
     }
@@ -698,7 +678,7 @@ signed mmu::tlb_lookup(unsigned int addr, unsigned asi,
 unsigned int mmu::read_mcr() {
 
   unsigned int tmp = MMU_CONTROL_REG;
-  v::debug << this->name() << "MMU_CONTROL_REG was read: " << hex << tmp << v::endl;
+  V_LOG(m_verbosity, v::debug) << this->name() << "MMU_CONTROL_REG was read: " << hex << tmp << v::endl;
 
   #ifdef LITTLE_ENDIAN_BO
   swap_Endianess(tmp);
@@ -712,6 +692,7 @@ void mmu::write_mcr(unsigned int * data) {
 
   unsigned int tmp = *data;
   unsigned int tmp2 = MMU_CONTROL_REG;
+  unsigned int prev = tmp2;
 
   tmp2 = tmp2 & ~0x00008003;
 
@@ -722,7 +703,12 @@ void mmu::write_mcr(unsigned int * data) {
   // Only TD [15], NF [1] and E [0] are writable
   MMU_CONTROL_REG = tmp2 | (tmp & 0x00008003);
 
-  v::debug << name() << "Write " << tmp << " (" << *data << ") to MMU_CONTROL_REG: " << hex << v::setw(8) << MMU_CONTROL_REG << v::endl;
+  // Switching the MMU (E) or the TLB (TD) invalidates all PDC entries
+  if ((prev ^ MMU_CONTROL_REG) & 0x00008001) {
+    tlb_flush();
+  }
+
+  V_LOG(m_verbosity, v::debug) << name() << "Write " << tmp << " (" << *data << ") to MMU_CONTROL_REG: " << hex << v::setw(8) << MMU_CONTROL_REG << v::endl;
 }
 
 // Read MMU Context Table Pointer Register
@@ -734,7 +720,7 @@ unsigned int mmu::read_mctpr() {
   swap_Endianess(tmp);
   #endif
   
-  v::debug << name() << "Read from MMU_CONTEXT_TABLE_POINTER_REG: " << hex << v::setw(8) << tmp << v::endl;
+  V_LOG(m_verbosity, v::debug) << name() << "Read from MMU_CONTEXT_TABLE_POINTER_REG: " << hex << v::setw(8) << tmp << v::endl;
 
   return (tmp);
 }
@@ -751,7 +737,11 @@ void mmu::write_mctpr(unsigned int * data) {
   // [1-0] reserved, must read as zero
   MMU_CONTEXT_TABLE_POINTER_REG = (tmp & ~0x3);
 
-  v::debug << name() << "Write to MMU_CONTEXT_TABLE_POINTER_REG: " << hex << v::setw(8) << MMU_CONTEXT_TABLE_POINTER_REG << v::endl;
+  // New page tables: cached translations are stale.
+  // (A context switch needs no flush, the entries are context tagged.)
+  tlb_flush();
+
+  V_LOG(m_verbosity, v::debug) << name() << "Write to MMU_CONTEXT_TABLE_POINTER_REG: " << hex << v::setw(8) << MMU_CONTEXT_TABLE_POINTER_REG << v::endl;
 }
 
 // Read MMU Context Register
@@ -763,7 +753,7 @@ unsigned int mmu::read_mctxr() {
   swap_Endianess(tmp);
   #endif
   
-  v::debug << name() << "Read from MMU_CONTEXT_REG: " << hex << v::setw(8) << MMU_CONTEXT_REG << v::endl;
+  V_LOG(m_verbosity, v::debug) << name() << "Read from MMU_CONTEXT_REG: " << hex << v::setw(8) << MMU_CONTEXT_REG << v::endl;
 
   return (tmp);
 }
@@ -779,7 +769,7 @@ void mmu::write_mctxr(unsigned int * data) {
 
   MMU_CONTEXT_REG = tmp;
 
-  v::debug << name() << "Write to MMU_CONTEXT_REG: " << hex << v::setw(8) << MMU_CONTEXT_REG << v::endl;
+  V_LOG(m_verbosity, v::debug) << name() << "Write to MMU_CONTEXT_REG: " << hex << v::setw(8) << MMU_CONTEXT_REG << v::endl;
 }
 
 // Read MMU Fault Status Register
@@ -791,7 +781,7 @@ unsigned int mmu::read_mfsr() {
   swap_Endianess(tmp);
   #endif
   
-  v::debug << name() << "Read from MMU_FAULT_STATUS_REG: " << hex << v::setw(8) << MMU_FAULT_STATUS_REG << v::endl;
+  V_LOG(m_verbosity, v::debug) << name() << "Read from MMU_FAULT_STATUS_REG: " << hex << v::setw(8) << MMU_FAULT_STATUS_REG << v::endl;
 
   // Page 258 - Table H-8:  Reading the Fault Status Register clears it
   MMU_FAULT_STATUS_REG = 0;
@@ -808,7 +798,7 @@ unsigned int mmu::read_mfar() {
   swap_Endianess(tmp);
   #endif
   
-  v::debug << name() << "Read from MMU_FAULT_ADDRESS_REG: " << hex << v::setw(8) << MMU_FAULT_ADDRESS_REG << v::endl;
+  V_LOG(m_verbosity, v::debug) << name() << "Read from MMU_FAULT_ADDRESS_REG: " << hex << v::setw(8) << MMU_FAULT_ADDRESS_REG << v::endl;
 
   return (tmp);
 }
@@ -841,18 +831,18 @@ void mmu::diag_read_itlb(unsigned int addr, unsigned int * data) {
 
   t_VAT vpn = (addr >> (32 - m_vtag_width));
 
-  v::debug << name() << "Diagnostic read instruction PDC with address: " << hex << addr << " VPN: " << vpn << v::endl;
+  V_LOG(m_verbosity, v::debug) << name() << "Diagnostic read instruction PDC with address: " << hex << addr << " VPN: " << vpn << v::endl;
 
   // diagnostic ITLB lookup (without bus access)
   if ((addr & 0x3) == 0x3) {
 
-    pdciter = itlb->find(vpn);
+    t_PTE_context * entry = itlb->lookup(vpn, MMU_CONTEXT_REG);
 
     // found something ?
-    if (pdciter != itlb->end()) {
+    if (entry) {
 
       // hit
-      tmp = ((pdciter->second).pte);
+      tmp = entry->pte;
 
     } else {
 
@@ -869,99 +859,6 @@ void mmu::diag_read_itlb(unsigned int addr, unsigned int * data) {
   *data = tmp;
 }
 
-// Selects a TLB entry for replacement (LRU or RANDOM replacement).
-// Removes the selected entry from the TLB map
-// and returns the 'number' of the TLB (which is now free).
-unsigned int mmu::tlb_remove(std::map<t_VAT, t_PTE_context> * tlb, unsigned int tlb_size) {
-
-  std::map<t_VAT, t_PTE_context>::iterator selector;
-  std::map<t_VAT, t_PTE_context>::iterator lru_selector;
-
-  unsigned int tlb_select=0;
-  uint64_t min_lru = 0xffffffffffffffff;
-
-  uint32_t count;
-
-  switch(m_tlb_rep) {
-
-    // LRU
-    case 0:
-
-      // LRU replaces the TLB, which hasn't been used for the longest time.
-
-      // Find the TLB with the lowest LRU value
-      for(selector = tlb->begin(); selector != tlb->end(); selector++) {
-
-        if (selector->second.lru < min_lru) {
-          lru_selector = selector;
-          tlb_select = selector->second.tlb_no;
-          min_lru = selector->second.lru;
-        }
-      }
-
-      v::debug << this->name() << "Select TLB (LRU): " << tlb_select << " for replacement. " << v::endl;
-
-      tlb->erase(lru_selector);
-      v::debug << this->name() << "Erased TLB " << tlb_select << v::endl;
-
-      break;
-
-    // Pseudo Random
-    default:
-
-      // Random replacement is implemented through
-      // modulo-N counter that selects the TLB entry
-      // to be removed from the PDC.
-      tlb_select = m_pseudo_rand % (tlb_size + 1);
-
-      v::debug << this->name() << "Select TLB (Random): " << tlb_select << " for replacement. " << v::endl;
-
-      count = 0;
-
-      for(selector = tlb->begin(); selector != tlb->end(); selector++) {
-	        if (count == tlb_select) {
-
-	          tlb->erase(selector);
-	          break;
-
-	        }
-      }
-
-  }
-
-  return tlb_select;
-
-}
-
-// LRU replacement history updater
-void mmu::lru_update(t_VAT vpn, std::map<t_VAT, t_PTE_context> * tlb, unsigned int tlb_size) {
-
-  std::map<t_VAT, t_PTE_context>::iterator selector;
-
-  // The LRU counters of all TLBs, except the selected one (vpn),
-  // are decrement. The counter of the selected TLB is set to the maximum.
-  for (selector = tlb->begin(); selector != tlb->end(); selector++) {
-
-    if (selector->first != vpn) {
-
-      if (selector->second.lru != 0) {
-
-        (selector->second.lru)--;
-
-      }
-
-    } else {
-
-      selector->second.lru = 0xffffffffffffffff - 1;
-
-    }
-
-    v::debug << name() << "TLB " << selector->second.tlb_no << " LRU " << selector->second.lru << v::endl;
-
-  }
-}
-
-
 // Diagnostic write of instruction PDC (ASI 0x5)
 void mmu::diag_write_itlb(unsigned int addr, unsigned int * data) {
 }
@@ -973,18 +870,18 @@ void mmu::diag_read_dctlb(unsigned int addr, unsigned int * data) {
 
   t_VAT vpn = (addr >> (32 - m_vtag_width));
 
-  v::debug << name() << "Diagnostic read data/shared PDC with address: " << hex << addr << " VPN: " << vpn << v::endl;
+  V_LOG(m_verbosity, v::debug) << name() << "Diagnostic read data/shared PDC with address: " << hex << addr << " VPN: " << vpn << v::endl;
 
   // diagnostic ITLB lookup (without bus access)
   if ((addr & 0x3) == 0x3) {
 
-    pdciter = dtlb->find(vpn);
+    t_PTE_context * entry = dtlb->lookup(vpn, MMU_CONTEXT_REG);
 
     // found something ?
-    if (pdciter != dtlb->end()) {
+    if (entry) {
 
       // hit
-      tmp = (pdciter->second).pte;
+      tmp = entry->pte;
 
     } else {
 
@@ -1162,15 +1059,57 @@ void mmu::clkcng(sc_core::sc_time &clk) {
 
 /// TLB flush complete
 void mmu::tlb_flush() {
-  itlb->clear();  
-  dtlb->clear();  
-  v::debug << name() << "TLB flush" << v::endl;
+  itlb->flush();
+  dtlb->flush();
+  V_LOG(m_verbosity, v::debug) << name() << "TLB flush" << v::endl;
 };
 
 /// TLB flush certain entry
 void mmu::tlb_flush(uint32_t vpn) {
-  itlb->clear();  
-  dtlb->clear();  
-  v::debug << name() << "TLB flush" << v::endl;
+  itlb->flush();
+  dtlb->flush();
+  V_LOG(m_verbosity, v::debug) << name() << "TLB flush" << v::endl;
+}
+
+// Save MMU registers and TLB entries
+void mmu::checkpoint_save(CheckpointArchive &ar) {
+  ar.put("control", MMU_CONTROL_REG);
+  ar.put("context_table_pointer", MMU_CONTEXT_TABLE_POINTER_REG);
+  ar.put("context", MMU_CONTEXT_REG);
+  ar.put("fault_status", MMU_FAULT_STATUS_REG);
+  ar.put("fault_address", MMU_FAULT_ADDRESS_REG);
+
+  ar.put("itlb", itlb->entries(), itlb->size() * sizeof(t_PTE_context));
+  ar.put("itlb_stamp", itlb->stamp());
+  if (dtlb != itlb) {
+    ar.put("dtlb", dtlb->entries(), dtlb->size() * sizeof(t_PTE_context));
+    ar.put("dtlb_stamp", dtlb->stamp());
+  }
+}
+
+// Restore MMU registers and TLB entries. TLBs of a different size stay empty.
+void mmu::checkpoint_restore(const CheckpointArchive &ar) {
+  uint64_t stamp = 0;
+
+  ar.get("control", MMU_CONTROL_REG);
+  ar.get("context_table_pointer", MMU_CONTEXT_TABLE_POINTER_REG);
+  ar.get("context", MMU_CONTEXT_REG);
+  ar.get("fault_status", MMU_FAULT_STATUS_REG);
+  ar.get("fault_address", MMU_FAULT_ADDRESS_REG);
+
+  if (!ar.get("itlb", itlb->entries(), itlb->size() * sizeof(t_PTE_context))) {
+    itlb->flush();
+    v::warn << name() << "ITLB size differs from checkpoint, ITLB not restored" << v::endl;
+  } else if (ar.get("itlb_stamp", stamp)) {
+    itlb->set_stamp(stamp);
+  }
+  if (dtlb != itlb) {
+    if (!ar.get("dtlb", dtlb->entries(), dtlb->size() * sizeof(t_PTE_context))) {
+      dtlb->flush();
+      v::warn << name() << "DTLB size differs from checkpoint, DTLB not restored" << v::endl;
+    } else if (ar.get("dtlb_stamp", stamp)) {
+      dtlb->set_stamp(stamp);
+    }
+  }
 }
 /// @}
@@ -18,7 +18,6 @@
 #ifndef __MMU_H__
 #define __MMU_H__
 
-#include <map>
 #include <math.h>
 #include "core/common/base.h"
 #include "core/common/systemc.h"
@@ -26,6 +25,8 @@
 
 #include "gaisler/leon3/mmucache/mmu_if.h"
 #include "gaisler/leon3/mmucache/tlb_adaptor.h"
+#include "gaisler/leon3/mmucache/tlb_array.h"
+#include "core/common/checkpoint.h"
 #include "gaisler/leon3/mmucache/mmu_cache_if.h"
 
 #include "core/common/vendian.h"
@@ -35,7 +36,7 @@
 // ------------------------------------------
 
 /// @brief Memory Management Unit (MMU) for TrapGen LEON3 simulator
-class mmu : public DefaultBase, public mmu_if {
+class mmu : public DefaultBase, public mmu_if, public Checkpointable {
 
  private:
   signed get_physical_address( uint64_t * paddr, signed * prot, unsigned * access_index,
@@ -66,7 +67,7 @@ class mmu : public DefaultBase, public mmu_if {
   // ----------------
   /// Page descriptor cache (PDC) lookup
   signed tlb_lookup(unsigned int addr, unsigned asi,
-                             std::map<t_VAT, t_PTE_context> * tlb,
+                             tlb_array * tlb,
                              unsigned int tlb_size, sc_core::sc_time * t,
                              unsigned int * debug, bool is_dbg, bool &cacheable,
                              unsigned is_write /* LOAD / STORE? */, uint64_t * paddr );
@@ -97,14 +98,6 @@ class mmu : public DefaultBase, public mmu_if {
   /// Diagnostic write of data PDC or shared instruction and data PDC (ASI 0x6)
   void diag_write_dctlb(unsigned int addr, unsigned int * data);
 
-  /// Selects a TLB entry for replacement (LRU or RANDOM replacement).
-  /// Removes the selected entry from the TLB map and returns the 'number'
-  /// of the TLB (which is now free).
-  unsigned int tlb_remove(std::map<t_VAT, t_PTE_context> * tlb, unsigned int tlb_size);
-
-  /// LRU replacement history updater
-  void lru_update(t_VAT vpn, std::map<t_VAT, t_PTE_context> * tlb, unsigned int tlb_size);
-
   /// Return pointer to tlb instruction interface
   tlb_adaptor * get_itlb_if();
   /// Return pointer to tlb data interface
@@ -134,6 +127,12 @@ class mmu : public DefaultBase, public mmu_if {
   /// Displays execution statistics at the end of the simulation
   void end_of_simulation();
 
+  /// Save MMU registers and TLB entries
+  void checkpoint_save(CheckpointArchive &ar);
+
+  /// Restore MMU registers and TLB entries
+  void checkpoint_restore(const CheckpointArchive &ar);
+
   /// Helper functions for definition of clock cycle
   void clkcng(sc_core::sc_time &clk);
 
@@ -152,13 +151,10 @@ class mmu : public DefaultBase, public mmu_if {
 
   // instruction and data tlb pointers
   // (depending on configuration may point to a shared tlb implementation)
-  /// associative memory for instruction TLB (eventually also data tlb in shared mode)
-  std::map<t_VAT, t_PTE_context> * itlb;
-  /// associative memory for data TLB (not used in shared mode)
-  std::map<t_VAT, t_PTE_context> * dtlb;
-
-  /// iterator for PDC lookup
-  std::map<t_VAT, t_PTE_context>::iterator pdciter;
+  /// set-associative memory for instruction TLB (eventually also data tlb in shared mode)
+  tlb_array * itlb;
+  /// set-associative memory for data TLB (not used in shared mode)
+  tlb_array * dtlb;
 
   /// helper for tlb handling
   t_PTE_context * m_current_PTE_context;
@@ -392,6 +388,9 @@ class mmu : public DefaultBase, public mmu_if {
   /// Clock cycle time
   sc_core::sc_time clockcycle;
 
+  /// Runtime log level of the module (see V_LOG)
+  v::Verbosity m_verbosity;
+
 };
 
 #endif // __MMU_H__
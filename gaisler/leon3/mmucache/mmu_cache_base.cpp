@@ -18,6 +18,7 @@
 #include "gaisler/leon3/mmucache/mmu_cache_base.h"
 #include "core/common/sr_report.h"
 #include "core/common/vendian.h"
+#include "core/common/hostquantum.h"
 
 //SC_HAS_PROCESS(mmu_cache_base<>);
 /// Constructor
@@ -61,6 +62,7 @@ mmu_cache_base::mmu_cache_base(
               0,      // irq
               abstractionLayer), // LT or AT
   snoop(&mmu_cache_base::snoopingCallBack,"snoop"),
+  dmi_snoop("dmi_snoop"),
   irq("irq"),
   m_icen(icen),
   m_dcen(dcen),
@@ -89,11 +91,18 @@ mmu_cache_base::mmu_cache_base(
   dyn_read_energy("dyn_read_energy", 0.0, m_power), // Energy per read access
   dyn_write_energy("dyn_write_energy", 0.0, m_power), // Energy per write access
   dyn_reads("dyn_reads", 0ull, m_power), // Read access counter for power computation
-  dyn_writes("dyn_writes", 0ull, m_power) // Write access counter for power computation
+  dyn_writes("dyn_writes", 0ull, m_power), // Write access counter for power computation
+  m_dmi_en("dmi", false), // Direct memory access for line fills and stores (LT only)
+  m_dmi_accesses("dmi_accesses", 0ull, m_counters),
+  m_ltdecoupled("ltdecoupled", false) // Bus accesses at the local time of the CPU (LT only)
   {
 
     wb_pointer = 0;
     globl_count = 0;
+    m_bus_pending = 0;
+    m_defer_snoops = false;
+    m_tracer = NULL;
+    memset(m_dmi_hint, 0, sizeof(m_dmi_hint));
 
     // Parameter checks
     // ----------------
@@ -142,6 +151,9 @@ mmu_cache_base::mmu_cache_base(
 
     SC_THREAD(mem_access);
 
+    // DMI regions granted by the bus may be revoked
+    ahb.register_invalidate_direct_mem_ptr(this, &mmu_cache_base::invalidate_direct_mem_ptr);
+
     // Register power callback functions
     if (m_pow_mon) {
 
@@ -160,6 +172,8 @@ mmu_cache_base::mmu_cache_base(
       ("dlram", dlram)
       ("abstraction_layer", abstractionLayer)
       ("dsnoop", dsnoop)
+      ("dmi", m_dmi_en)
+      ("ltdecoupled", m_ltdecoupled)
       ("Creating mmu_cache_base with this generics");
 }
 
@@ -174,7 +188,8 @@ void mmu_cache_base::dorst() {
 }
 
 void mmu_cache_base::exec_instr(const unsigned int &addr, unsigned char *ptr, unsigned int asi, unsigned int *debug, const unsigned int &flush, sc_core::sc_time& delay, bool is_dbg) {
-  srDebug()("addr", addr)("data", *reinterpret_cast<unsigned int *>(ptr))("asi", asi)("flush", flush)("delay", delay)("is_dbg", is_dbg)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("data", *reinterpret_cast<unsigned int *>(ptr))("asi", asi)("flush", flush)("delay", delay)("is_dbg", is_dbg)(__PRETTY_FUNCTION__);
+  const sc_core::sc_time start = delay;
   // Instruction scratchpad enabled && address points into selected 16MB region
   bool cacheable = true;
   if (m_ilram && (((addr >> 24) & 0xff) == m_ilramstart)) {
@@ -187,14 +202,18 @@ void mmu_cache_base::exec_instr(const unsigned int &addr, unsigned char *ptr, un
     icache->mem_read((unsigned int)addr, asi, ptr, 4, &delay, debug, is_dbg, cacheable, false);
 
   }
+
+  if (m_tracer && !is_dbg) {
+    trace_access(TRACE_IFETCH, addr, ptr, 4, asi, start);
+  }
 }
 
 void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &addr, unsigned char *ptr, unsigned int len, unsigned int asi, unsigned int *debug, unsigned int flush, unsigned int lock, sc_core::sc_time& delay, bool is_dbg, tlm::tlm_response_status &response) {
-  srDebug()("addr", addr)("len", len)("asi", asi)("flush", flush)("lock", lock)("delay", delay)("is_dbg", is_dbg)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("len", len)("asi", asi)("flush", flush)("lock", lock)("delay", delay)("is_dbg", is_dbg)(__PRETTY_FUNCTION__);
   // Flush instruction
   if (flush) {
 
-    srDebug()("Received flush instruction - flushing both caches");
+    V_IF(m_verbosity, v::debug) srDebug()("Received flush instruction - flushing both caches");
 
     // Simultaneous flush of both caches
     icache->flush(&delay, debug, is_dbg);
@@ -206,6 +225,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
   }
 
+  const sc_core::sc_time start = delay;
   bool cacheable = true;
   // ************************************************
   // * TLM_READ_COMMAND
@@ -215,13 +235,13 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     // ************************************************
     // * TLM_READ_COMMAND - MAIN ASI SWITCH
     // ************************************************
-    srDebug()("asi", asi)("addr", addr)("READ");
+    V_IF(m_verbosity, v::debug) srDebug()("asi", asi)("addr", addr)("READ");
 
     switch (asi) {
 
     case 2:
 
-      srDebug()("addr", addr)("System Register read with ASI 0x2");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("System Register read with ASI 0x2");
 
       // Address decoder for system registers
       if (addr == 0) {
@@ -259,7 +279,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 5:
 
-      srDebug()("addr", addr)("Diagnostic read from instruction PDC (ASI 0x5)");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("Diagnostic read from instruction PDC (ASI 0x5)");
 
       // Only possible if mmu enabled
       if (m_mmu_en) {
@@ -283,7 +303,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 6:
 
-      srDebug()("addr", addr)("Diagnostic read from data (or shared) PDC (ASI 0x6)");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("Diagnostic read from data (or shared) PDC (ASI 0x6)");
 
       // Only possible if mmu enabled
       if (m_mmu_en) {
@@ -308,7 +328,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xc:
 
-      srDebug()("addr", addr)("asi", asi)("ASI read instruction cache tags");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI read instruction cache tags");
 
       icache->read_cache_tag((unsigned int)addr, (unsigned int*)ptr, &delay);
       // Set TLM response
@@ -318,7 +338,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xd:
 
-      srDebug()("addr", addr)("asi", asi)("ASI read instruction cache entry");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI read instruction cache entry");
 
       icache->read_cache_entry((unsigned int)addr, (unsigned int*)ptr, &delay);
       // Set TLM response
@@ -328,7 +348,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xe:
 
-      srDebug()("addr", addr)("asi", asi)("ASI read data cache tags");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI read data cache tags");
 
       dcache->read_cache_tag((unsigned int)addr, (unsigned int*)ptr, &delay);
       // Set TLM response
@@ -338,7 +358,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xf:
 
-      srDebug()("addr", addr)("asi", asi)("ASI read data cache entry");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI read data cache entry");
 
       dcache->read_cache_entry((unsigned int)addr, (unsigned int*)ptr, &delay);
       // Set TLM response
@@ -351,13 +371,13 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
       // Only works if MMU present
       if (m_mmu_en == 0x1) {
 
-        srDebug()("addr", addr)("asi", asi)("MMU register read with ASI 0x19");
+        V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("MMU register read with ASI 0x19");
 
         // Address decoder for MMU register access
         if (addr == 0x000) {
 
           // MMU Control Register
-          srDebug()("ASI read MMU Control Register");
+          V_IF(m_verbosity, v::debug) srDebug()("ASI read MMU Control Register");
 
           *(unsigned int *)ptr = m_mmu->read_mcr();
           // Set TLM response
@@ -366,7 +386,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
         } else if (addr == 0x100) {
 
           // Context Pointer Register
-          srDebug()("ASI read MMU Context Pointer Register");
+          V_IF(m_verbosity, v::debug) srDebug()("ASI read MMU Context Pointer Register");
 
           *(unsigned int *)ptr = m_mmu->read_mctpr();
           // Set TLM response
@@ -375,7 +395,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
         } else if (addr == 0x200) {
 
           // Context Register
-          srDebug()("ASI read MMU Context Register");
+          V_IF(m_verbosity, v::debug) srDebug()("ASI read MMU Context Register");
 
           *(unsigned int *)ptr = m_mmu->read_mctxr();
           // Set TLM response
@@ -384,7 +404,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
         } else if (addr == 0x300) {
 
           // Fault Status Register
-          srDebug()("ASI read MMU Fault Status Register");
+          V_IF(m_verbosity, v::debug) srDebug()("ASI read MMU Fault Status Register");
 
           *(unsigned int *)ptr = m_mmu->read_mfsr();
           // Set TLM response
@@ -393,7 +413,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
         } else if (addr == 0x400) {
 
           // Fault Address Register
-          srDebug()("ASI read MMU Fault Address Register");
+          V_IF(m_verbosity, v::debug) srDebug()("ASI read MMU Fault Address Register");
 
           *(unsigned int *)ptr = m_mmu->read_mfar();
           // Set TLM response
@@ -432,7 +452,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     case 0xb:
 //    case 0x1c:
       
-      srDebug()("addr", addr)("asi", asi)("ASI read");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI read");
 
       // Instruction scratchpad enabled && address points into selected 16 MB region
       if (m_ilram && (((addr >> 24) & 0xff) == m_ilramstart)) {
@@ -460,7 +480,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
       break;
     
     case 0x1c:
-        srDebug()("addr", addr)("asi", asi)("ASI read through");
+        V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI read through");
         this->mem_read((unsigned int)addr, asi, ptr, len, &delay, debug, is_dbg, cacheable, lock);
         break;
       
@@ -481,12 +501,12 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     // * TLM_WRITE_COMMAND - MAIN ASI SWITCH
     // ************************************************
     //
-    srDebug()("addr", addr)("asi", asi)("Write Data");
+    V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("Write Data");
     switch (asi) {
 
     case 2:
 
-      srDebug()("addr", addr)("asi", asi)("System Register write");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("System Register write");
 
       // Address decoder for system registers
       if (addr == 0) {
@@ -528,7 +548,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 5:
 
-      srDebug()("addr", addr)("asi", asi)("Diagnostic write to instruction PDC (ASI 0x5)");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("Diagnostic write to instruction PDC (ASI 0x5)");
 
       // Only possible if mmu enabled
       if (m_mmu_en) {
@@ -552,7 +572,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 6:
 
-      srDebug()("addr", addr)("asi", asi)("Diagnostic write to data (or shared) PDC (ASI 0x6)");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("Diagnostic write to data (or shared) PDC (ASI 0x6)");
 
       // Only possible if mmu enabled
       if (m_mmu_en) {
@@ -576,7 +596,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xc:
 
-      srDebug()("addr", addr)("asi", asi)("ASI write instruction cache tags");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write instruction cache tags");
 
       icache->write_cache_tag((unsigned int)addr, (unsigned int*)ptr, &delay);
       // Set TLM response
@@ -586,7 +606,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xd:
 
-      srDebug()("addr", addr)("asi", asi)("ASI write instruction cache entry");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write instruction cache entry");
 
       icache->write_cache_entry((unsigned int)addr, (unsigned int*)ptr, &delay);
 
@@ -597,7 +617,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xe:
 
-      srDebug()("addr", addr)("asi", asi)("ASI write data cache tags");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write data cache tags");
 
       dcache->write_cache_tag((unsigned int)addr, (unsigned int*)ptr, &delay);
       // Set TLM response
@@ -607,7 +627,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
     case 0xf:
 
-      srDebug()("addr", addr)("asi", asi)("ASI write data cache entry");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write data cache entry");
 
       dcache->write_cache_entry((unsigned int)addr, (unsigned int*)ptr, &delay);
       // Set TLM response
@@ -618,7 +638,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     case 0x11: // is this correct?
 
       // All write operations with ASI 0x11 flush the instruction and data cache
-      srDebug()("addr", addr)("asi", asi)("ASI flush instruction and data chache");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI flush instruction and data chache");
 
       icache->flush(&delay, debug, is_dbg);
       dcache->flush(&delay, debug, is_dbg);
@@ -630,7 +650,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     case 0x15:
 
       // All write operations with ASI 0x15 flush the instruction cache
-      srDebug()("addr", addr)("asi", asi)("ASI flush instruction chache");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI flush instruction chache");
 
       icache->flush(&delay, debug, is_dbg);
       // Set TLM response
@@ -641,7 +661,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     case 0x16:
 
       // All write operations with ASI 0x16 flush the data cache
-      srDebug()("addr", addr)("asi", asi)("ASI flush data chache");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI flush data chache");
 
       dcache->flush(&delay, debug, is_dbg);
       // Set TLM response
@@ -652,7 +672,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     case 0x18: // is this correct?
 
       // All write operations with ASI 0x18 flush the TLB
-      srDebug()("addr", addr)("asi", asi)("ASI flush TLB");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI flush TLB");
 
       m_mmu->tlb_flush();
       // Set TLM response
@@ -665,14 +685,14 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
       // Only works if MMU present
       if (m_mmu_en == 0x1) {
 
-        srDebug()("addr", addr)("asi", asi)("MMU register write");
+        V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("MMU register write");
 
         // Address decoder for MMU register access
         if (addr == 0x000) {
 
           // MMU Control Register
-          srDebug()("addr", addr)("asi", asi)("ASI write MMU Control Register");
-          v::debug << name() << "ASI write MMU Control Register" << v::endl;
+          V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write MMU Control Register");
+          V_LOG(m_verbosity, v::debug) << name() << "ASI write MMU Control Register" << v::endl;
 
           m_mmu->write_mcr((unsigned int *)ptr);
           // Set TLM response
@@ -681,7 +701,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
         } else if (addr == 0x100) {
 
           // Context Table Pointer Register
-          srDebug()("addr", addr)("asi", asi)("ASI write MMU Context Table Pointer Register");
+          V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write MMU Context Table Pointer Register");
 
           m_mmu->write_mctpr((unsigned int*)ptr);
           // Set TLM response
@@ -690,7 +710,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
         } else if (addr == 0x200) {
 
           // Context Register
-          srDebug()("addr", addr)("asi", asi)("ASI write MMU Context Register");
+          V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write MMU Context Register");
 
           m_mmu->write_mctxr((unsigned int*)ptr);
           // Set TLM response
@@ -728,7 +748,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
     case 0xb:
 //    case 0x1c:
       
-      srDebug()("addr", addr)("asi", asi)("ASI write");
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write");
 
       // Instruction scratchpad enabled && address points into selected 16 MB region
       if (m_ilram && (((addr >> 24) & 0xff) == m_ilramstart)) {
@@ -756,7 +776,7 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
       break;
     
     case 0x1c:
-        srDebug()("addr", addr)("asi", asi)("ASI write through");
+        V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("asi", asi)("ASI write through");
         this->mem_write((unsigned int)addr, asi, ptr, len, &delay, debug, is_dbg, cacheable, lock);
         break;
 
@@ -776,6 +796,9 @@ void mmu_cache_base::exec_data(const tlm::tlm_command cmd, const unsigned int &a
 
   }
 
+  if (m_tracer && !is_dbg) {
+    trace_access(cmd == tlm::TLM_READ_COMMAND ? TRACE_DREAD : TRACE_DWRITE, addr, ptr, len, asi, start);
+  }
 }
 
 /// Called from AHB master to signal begin response
@@ -791,15 +814,101 @@ void mmu_cache_base::response_callback(tlm::tlm_generic_payload * trans) {
 
 }
 
+/// Bus access of a host thread slice.
+/// The worker is blocked until the SystemC kernel has executed the access.
+/// Stores are completed on the bus before the worker continues, because
+/// mem_access updates the DMI regions the worker looks up.
+class mmu_cache_base::bus_call : public HostQuantum::Call {
+  public:
+    bus_call(mmu_cache_base *cache, bool is_write, unsigned int addr, unsigned int asi, unsigned char *data,
+             unsigned int length, sc_core::sc_time *delay, unsigned int *debug, bool &cacheable, bool is_lock) :
+      cache(cache), is_write(is_write), addr(addr), asi(asi), data(data), length(length), delay(delay),
+      debug(debug), cacheable(cacheable), is_lock(is_lock), result(false) {}
+
+    void serve() {
+      if (is_write) {
+        cache->mem_write(addr, asi, data, length, delay, debug, false, cacheable, is_lock);
+        while (cache->m_bus_pending) {
+          wait(cache->bus_idle);
+        }
+      } else {
+        result = cache->mem_read(addr, asi, data, length, delay, debug, false, cacheable, is_lock);
+      }
+    }
+
+    mmu_cache_base *cache;
+    bool is_write;
+    unsigned int addr;
+    unsigned int asi;
+    unsigned char *data;
+    unsigned int length;
+    sc_core::sc_time *delay;
+    unsigned int *debug;
+    bool &cacheable;
+    bool is_lock;
+    bool result;
+};
+
 /// Function for write access to AHB master socket
 void mmu_cache_base::mem_write(unsigned int addr, unsigned int asi, unsigned char * data,
                           unsigned int length, sc_core::sc_time * delay,
                           unsigned int * debug, bool is_dbg, bool &cacheable, bool is_lock) {
 
+  // Direct memory access: Stores are posted like on the bus,
+  // but only cost the access latency of the memory.
+  // Pending bus transactions have to be completed first to keep the order.
+  if (!is_dbg && !is_lock && m_dmi_en && !m_bus_pending) {
+    t_dmi_region *region = dmi_lookup(addr, length, true);
+    if (region) {
+      memcpy(region->dmi.get_dmi_ptr() + (addr - region->dmi.get_start_address()), data, length);
+      *delay += region->dmi.get_write_latency();
+      m_dmi_accesses++;
+      // The store bypasses the AHBCtrl: the other data caches have to snoop it anyway.
+      // During a host thread slice it is broadcast at the end of the slice.
+      t_snoop store = { m_master_id, addr, length };
+      if (m_defer_snoops) {
+        m_dmi_stores.push_back(store);
+      } else {
+        dmi_snoop.write(store);
+      }
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("length", length)("DMI write");
+      return;
+    }
+  }
+
+  if (!is_dbg && HostQuantum::in_worker()) {
+    bus_call request(this, true, addr, asi, data, length, delay, debug, cacheable, is_lock);
+    HostQuantum::instance().call(request);
+    return;
+  }
+
+  // Temporally decoupled bus: The store is posted at the local time of the CPU.
+  // The bus only records its occupancy, the CPU does not wait for the transfer.
+  if (!is_dbg && m_ltdecoupled && (m_abstractionLayer == amba::amba_LT) && !m_bus_pending) {
+    tlm::tlm_generic_payload * trans = ahb.get_transaction();
+    trans->set_command(tlm::TLM_WRITE_COMMAND);
+    trans->set_address(addr);
+    trans->set_data_length(length);
+    trans->set_data_ptr(data);
+    trans->set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    if (is_lock) {
+      ahb.validate_extension<amba::amba_lock>(*trans);
+    } else {
+      ahb.invalidate_extension<amba::amba_lock>(*trans);
+    }
+    sc_core::sc_time posted = *delay;
+    ahbaccess(trans, posted);
+    if (m_dmi_en && trans->is_response_ok()) {
+      dmi_acquire(trans);
+    }
+    trans->release();
+    return;
+  }
+
   // Allocate new transaction (reference counter = 1)
   tlm::tlm_generic_payload * trans = ahb.get_transaction();
 
-  srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Allocate new transaction (mem_write) Acquire / Ref-Count");
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Allocate new transaction (mem_write) Acquire / Ref-Count");
 
   // Copy payload data
   memcpy(write_buf + wb_pointer, data, length);
@@ -821,12 +930,13 @@ void mmu_cache_base::mem_write(unsigned int addr, unsigned int asi, unsigned cha
       ahb.invalidate_extension<amba::amba_lock>(*trans);
     }
  
-    srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Schedule transaction (WRITE)");
-    srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Acquire / Ref-Count before (bus_in_fifo)");
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Schedule transaction (WRITE)");
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Acquire / Ref-Count before (bus_in_fifo)");
     trans->acquire();
+    m_bus_pending++;
     bus_in_fifo.put(trans);
     wait(SC_ZERO_TIME);
-    srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Done sheduling transaction (WRITE)");
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Done sheduling transaction (WRITE)");
 
   } else {
 
@@ -835,7 +945,7 @@ void mmu_cache_base::mem_write(unsigned int addr, unsigned int asi, unsigned cha
 
   }
 
-  srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Relese Transaction: Ref-Count before calling release (mem_write)");
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Relese Transaction: Ref-Count before calling release (mem_write)");
 
   // Decrement reference counter
   trans->release();
@@ -849,10 +959,62 @@ bool mmu_cache_base::mem_read(unsigned int addr, unsigned int asi, unsigned char
 
   bool cacheable_local = true;
 
+  // Direct memory access: Copy from the memory and annotate the bus cycles
+  // instead of scheduling a transaction and waiting for mem_access.
+  // Pending bus transactions have to be completed first to keep the order.
+  if (!is_dbg && !is_lock && m_dmi_en && !m_bus_pending) {
+    t_dmi_region *region = dmi_lookup(addr, length, false);
+    if (region) {
+      memcpy(data, region->dmi.get_dmi_ptr() + (addr - region->dmi.get_start_address()), length);
+      *delay += region->dmi.get_read_latency() + (1 + ((length - 1) >> 2)) * clock_cycle;
+      m_dmi_accesses++;
+      V_IF(m_verbosity, v::debug) srDebug()("addr", addr)("length", length)("DMI read");
+
+      cacheable = region->cacheable;
+      if ((m_cached != 0))  {
+        cacheable_local = (m_cached & (1 << (addr >> 28))) ? true : false;
+      }
+      return cacheable_local && cacheable;
+    }
+  }
+
+  if (!is_dbg && HostQuantum::in_worker()) {
+    bus_call request(this, false, addr, asi, data, length, delay, debug, cacheable, is_lock);
+    HostQuantum::instance().call(request);
+    return request.result;
+  }
+
+  // Temporally decoupled bus: The read is issued at the local time of the CPU
+  // and the transfer time is added to it. The quantum keeper of the CPU
+  // consumes it, instead of waiting for mem_access.
+  if (!is_dbg && m_ltdecoupled && (m_abstractionLayer == amba::amba_LT) && !m_bus_pending) {
+    tlm::tlm_generic_payload * trans = ahb.get_transaction();
+    trans->set_command(tlm::TLM_READ_COMMAND);
+    trans->set_address(addr);
+    trans->set_data_length(length);
+    trans->set_data_ptr(data);
+    trans->set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    if (is_lock) {
+      ahb.validate_extension<amba::amba_lock>(*trans);
+    } else {
+      ahb.invalidate_extension<amba::amba_lock>(*trans);
+    }
+    ahbaccess(trans, *delay);
+    if (m_dmi_en && trans->is_response_ok()) {
+      dmi_acquire(trans);
+    }
+    cacheable = (ahb.get_extension<amba::amba_cacheable>(*trans)) ? true : false;
+    if ((m_cached != 0))  {
+      cacheable_local = (m_cached & (1 << (addr >> 28))) ? true : false;
+    }
+    trans->release();
+    return cacheable_local && cacheable;
+  }
+
   // Allocate new transaction (reference counter = 1)
   tlm::tlm_generic_payload * trans = ahb.get_transaction();
 
-  srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Allocate new transaction (mem_read) Acquire / Ref-Count");
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Allocate new transaction (mem_read) Acquire / Ref-Count");
 
   // Initialize transaction
   trans->set_command(tlm::TLM_READ_COMMAND);
@@ -869,15 +1031,16 @@ bool mmu_cache_base::mem_read(unsigned int addr, unsigned int asi, unsigned char
       ahb.invalidate_extension<amba::amba_lock>(*trans);
     }
 
-    srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Schedule transaction (READ)");
-    srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Acquire / Ref-Count before (bus_in_fifo)");
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Schedule transaction (READ)");
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Acquire / Ref-Count before (bus_in_fifo)");
     trans->acquire();
+    m_bus_pending++;
     bus_in_fifo.put(trans);
-    srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Done sheduling transaction (READ)");
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Done sheduling transaction (READ)");
 
     // Read misses are blocking the cache !!
     wait(bus_read_completed);
-    srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Done transaction (READ) / bus_read_completed event");
+    V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("fifo_level", bus_in_fifo.used())("Done transaction (READ) / bus_read_completed event");
     // cacheable handling!!!
     cacheable = (ahb.get_extension<amba::amba_cacheable>(*trans)) ? true : false;
 
@@ -893,7 +1056,7 @@ bool mmu_cache_base::mem_read(unsigned int addr, unsigned int asi, unsigned char
 
   }
 
-  srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Release transaction (mem_read) Ref-Count before calling release");
+  V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Release transaction (mem_read) Ref-Count before calling release");
 
   // Decrement reference counter
   trans->release();
@@ -911,18 +1074,28 @@ void mmu_cache_base::mem_access() {
     while(bus_in_fifo.nb_get(trans)) {
 
       if (trans->is_read()) {
-        srDebug()("pointer", reinterpret_cast<size_t>(trans))("addr", trans->get_address())("type", "read")("Transaction issued to AHB");
+        V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("addr", trans->get_address())("type", "read")("Transaction issued to AHB");
       } else {
-        srDebug()("pointer", reinterpret_cast<size_t>(trans))("addr", trans->get_address())("type", "write")("Transaction issued to AHB");
+        V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("addr", trans->get_address())("type", "write")("Transaction issued to AHB");
       }
       ahbaccess(trans);
-      srDebug()("pointer", reinterpret_cast<size_t>(trans))("addr", trans->get_address())("Transaction returned from AHB");
+      V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("addr", trans->get_address())("Transaction returned from AHB");
 
       if (m_abstractionLayer == amba::amba_AT) wait(ahb_response_event);
+
+      // Try to get direct access to the target for the next accesses
+      if (m_dmi_en && trans->is_response_ok()) {
+        dmi_acquire(trans);
+      }
+      m_bus_pending--;
+      if (!m_bus_pending) {
+        bus_idle.notify();
+      }
+
       if (trans->is_read()) bus_read_completed.notify();
 
       // Decrement ref counter
-      srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Release transaction (bus_in_fifo) Ref-Count before calling release");
+      V_IF(m_verbosity, v::debug) srDebug()("pointer", reinterpret_cast<size_t>(trans))("refcount", trans->get_ref_count())("Release transaction (bus_in_fifo) Ref-Count before calling release");
       trans->release();
     }
 
@@ -932,6 +1105,85 @@ void mmu_cache_base::mem_access() {
   }
 }
 
+// Returns the DMI region covering the access or NULL
+mmu_cache_base::t_dmi_region *mmu_cache_base::dmi_lookup(unsigned int addr, unsigned int length, bool is_write) {
+
+  // Consecutive accesses mostly hit the region last used in the same 1 MB area
+  t_dmi_region *region = m_dmi_hint[addr >> 20];
+  if (!region || (addr < region->dmi.get_start_address()) || (addr + length - 1 > region->dmi.get_end_address())) {
+    std::map<uint64_t, t_dmi_region>::iterator it = m_dmi_regions.upper_bound(addr);
+    if (it == m_dmi_regions.begin()) {
+      return NULL;
+    }
+    --it;
+    if (addr + length - 1 > it->second.dmi.get_end_address()) {
+      return NULL;
+    }
+    region = &it->second;
+    m_dmi_hint[addr >> 20] = region;
+  }
+  if (is_write && !region->writable) {
+    return NULL;
+  }
+  return region;
+}
+
+// Requests a DMI region for the target of a completed bus transaction.
+// Only memories grant DMI. The 1 MB areas of other slaves are remembered,
+// so the bus is asked only once for them.
+void mmu_cache_base::dmi_acquire(tlm::tlm_generic_payload *trans) {
+
+  unsigned int addr = trans->get_address();
+  t_dmi_region *region = dmi_lookup(addr, trans->get_data_length(), false);
+
+  // A successful write opens a known region for DMI writes
+  if (region) {
+    if (trans->is_write() && region->dmi.is_write_allowed()) {
+      region->writable = true;
+    }
+    return;
+  }
+
+  if ((m_abstractionLayer != amba::amba_LT) || m_dmi_denied.count(addr >> 20)) {
+    return;
+  }
+
+  t_dmi_region tmp;
+  tlm::tlm_generic_payload gp;
+  gp.set_command(trans->get_command());
+  gp.set_address(addr);
+  gp.set_data_length(trans->get_data_length());
+  tmp.dmi.init();
+
+  if (ahb->get_direct_mem_ptr(gp, tmp.dmi) && tmp.dmi.is_read_allowed()) {
+    tmp.cacheable = (ahb.get_extension<amba::amba_cacheable>(*trans)) ? true : false;
+    tmp.writable = trans->is_write() && tmp.dmi.is_write_allowed();
+    m_dmi_regions.insert(std::make_pair(static_cast<uint64_t>(tmp.dmi.get_start_address()), tmp));
+    V_IF(m_verbosity, v::debug) srDebug()("start", tmp.dmi.get_start_address())("end", tmp.dmi.get_end_address())("cacheable", tmp.cacheable)("Acquired DMI region");
+  } else {
+    m_dmi_denied.insert(addr >> 20);
+  }
+}
+
+// Drops cached DMI regions overlapping the given range
+void mmu_cache_base::invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range) {
+
+  std::map<uint64_t, t_dmi_region>::iterator region = m_dmi_regions.begin();
+  while (region != m_dmi_regions.end()) {
+    if ((region->second.dmi.get_start_address() <= end_range) && (region->second.dmi.get_end_address() >= start_range)) {
+      m_dmi_regions.erase(region++);
+    } else {
+      ++region;
+    }
+  }
+  memset(m_dmi_hint, 0, sizeof(m_dmi_hint));
+
+  // The memory map may have changed
+  m_dmi_denied.clear();
+
+  V_IF(m_verbosity, v::debug) srDebug()("start", start_range)("end", end_range)("Invalidated DMI regions");
+}
+
 // Send an interrupt over the central IRQ interface
 void mmu_cache_base::set_irq(uint32_t tt) {
 
@@ -984,14 +1236,14 @@ void mmu_cache_base::write_ccr(unsigned char * data, unsigned int len,
     // read only masking: 1111 1111 1001 1111 0011 1111 1111 1111
     CACHE_CONTROL_REG = (tmp & 0xff9f3fff);
 
-    srDebug()("CACHE_CONTROL_REG", CACHE_CONTROL_REG)(__PRETTY_FUNCTION__);
+    V_IF(m_verbosity, v::debug) srDebug()("CACHE_CONTROL_REG", CACHE_CONTROL_REG)(__PRETTY_FUNCTION__);
 }
 
 // Read the cache control register from processor interface
 unsigned int mmu_cache_base::read_ccr(bool internal) {
 
   unsigned int tmp = CACHE_CONTROL_REG;
-  srDebug()("CACHE_CONTROL_REG", CACHE_CONTROL_REG)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("CACHE_CONTROL_REG", CACHE_CONTROL_REG)(__PRETTY_FUNCTION__);
 
   if (!internal) {
 
@@ -1007,18 +1259,32 @@ unsigned int mmu_cache_base::read_ccr(bool internal) {
 // Snooping function
 void mmu_cache_base::snoopingCallBack(const t_snoop& snoop, const sc_core::sc_time& delay) {
 
-  srDebug()("master", snoop.master_id)("addr", snoop.address)("length", snoop.length)(__PRETTY_FUNCTION__);
+  V_IF(m_verbosity, v::debug) srDebug()("master", snoop.master_id)("addr", snoop.address)("length", snoop.length)(__PRETTY_FUNCTION__);
   // Make sure we are not snooping ourself ;)
   if (snoop.master_id != m_master_id) {
 
     // If dcache and snooping enabled
     if (m_dcen && m_dsnoop) {
 
+      // The cache belongs to a running host thread slice
+      if (m_defer_snoops) {
+        m_deferred_snoops.push_back(snoop);
+        return;
+      }
       dcache->snoop_invalidate(snoop, delay);
     }
   }
 }
 
+// Invalidate the snoops queued during a host thread slice
+void mmu_cache_base::apply_deferred_snoops() {
+
+  for (std::vector<t_snoop>::iterator snoop = m_deferred_snoops.begin(); snoop != m_deferred_snoops.end(); ++snoop) {
+    dcache->snoop_invalidate(*snoop, SC_ZERO_TIME);
+  }
+  m_deferred_snoops.clear();
+}
+
 
 // Automatically called at the beginning of the simulation
 void mmu_cache_base::start_of_simulation() {
@@ -1080,6 +1346,7 @@ void mmu_cache_base::end_of_simulation() {
     v::report << name() << " * --------------------- " << v::endl;
     v::report << name() << " * Successful Transactions: " << m_right_transactions << v::endl;
     v::report << name() << " * Total Transactions: " << m_total_transactions << v::endl;
+    v::report << name() << " * DMI Accesses: " << m_dmi_accesses << v::endl;
     v::report << name() << " * " << v::endl;
     v::report << name() << " * AHB Master interface reports: " << v::endl;
     print_transport_statistics(name());
@@ -1087,6 +1354,20 @@ void mmu_cache_base::end_of_simulation() {
 
 }
 
+// Save the cache control register, cache and MMU contents are saved by the submodules
+void mmu_cache_base::checkpoint_save(CheckpointArchive &ar) {
+
+  ar.put("ccr", CACHE_CONTROL_REG);
+
+}
+
+// Restore the cache control register
+void mmu_cache_base::checkpoint_restore(const CheckpointArchive &ar) {
+
+  ar.get("ccr", CACHE_CONTROL_REG);
+
+}
+
 sc_core::sc_time mmu_cache_base::get_clock() {
 
   return clock_cycle;
@@ -24,6 +24,10 @@
 //#include <tlm_1/tlm_req_rsp/tlm_channels/tlm_fifo/tlm_fifo.h>
 
 #include <math.h>
+#include <cstring>
+#include <map>
+#include <set>
+#include <vector>
 
 #include "gaisler/leon3/mmucache/icio_payload_extension.h"
 #include "gaisler/leon3/mmucache/dcio_payload_extension.h"
@@ -32,6 +36,8 @@
 #include "core/common/sr_signal.h"
 #include "core/common/ahbmaster.h"
 #include "core/common/clkdevice.h"
+#include "core/common/checkpoint.h"
+#include "core/common/tracewriter.h"
 
 #include "core/common/verbose.h"
 #include "gaisler/leon3/mmucache/cache_if.h"
@@ -49,6 +55,7 @@
 class mmu_cache_base :
   public AHBMaster<>,
   public mmu_cache_if,
+  public Checkpointable,
   public CLKDevice {
 
  public:
@@ -62,6 +69,9 @@ class mmu_cache_base :
   // snooping port
   signal<t_snoop>::in snoop;
 
+  /// Stores done through DMI, the AHBCtrl broadcasts them for snooping
+  signal<t_snoop>::out dmi_snoop;
+
   // Signalkit IRQ output
   signal<std::pair<uint32_t, bool> >::out irq;
 
@@ -139,6 +149,9 @@ class mmu_cache_base :
                         unsigned int length, sc_core::sc_time * t,
                         unsigned int * debug, bool is_dbg, bool &cacheable, bool is_lock);
 
+  /// Drops cached DMI regions overlapping the given range (called by the bus)
+  void invalidate_direct_mem_ptr(sc_dt::uint64 start_range, sc_dt::uint64 end_range);
+
   /// Send an interrupt over the central IRQ interface
   virtual void set_irq(uint32_t tt);
 
@@ -153,6 +166,9 @@ class mmu_cache_base :
   /// Snooping function (For calling dcache->snoop_invalidate)
   void snoopingCallBack(const t_snoop& snoop, const sc_core::sc_time& delay);
 
+  /// Invalidate the snoops queued during a host thread slice
+  void apply_deferred_snoops();
+
   /// Automatically called at the beginning of the simulation
   void start_of_simulation();
 
@@ -171,6 +187,12 @@ class mmu_cache_base :
   /// Called at end of simulation to print execution statistics
   void end_of_simulation();
 
+  /// Save the cache control register
+  void checkpoint_save(CheckpointArchive &ar);
+
+  /// Restore the cache control register
+  void checkpoint_restore(const CheckpointArchive &ar);
+
   /// Reset function
   void dorst();
 
@@ -235,6 +257,21 @@ class mmu_cache_base :
 
   void mem_access();
 
+  /// Direct memory interface region granted by the bus
+  typedef struct {
+    tlm::tlm_dmi dmi;
+    /// AHB cacheability of the region
+    bool cacheable;
+    /// Writes were accepted by the slave (e.g. not a write protected PROM)
+    bool writable;
+  } t_dmi_region;
+
+  /// Returns the DMI region covering addr..addr+length-1 or NULL
+  t_dmi_region *dmi_lookup(unsigned int addr, unsigned int length, bool is_write);
+
+  /// Requests a DMI region for the target of a completed bus transaction
+  void dmi_acquire(tlm::tlm_generic_payload *trans);
+
   unsigned char write_buf[1024];
   unsigned int wb_pointer;
 
@@ -297,7 +334,59 @@ class mmu_cache_base :
   sr_param<uint64_t> dyn_writes;    
 
   uint64_t globl_count;
-  
+
+  /// Use direct memory access for RAM/PROM line fills and stores (LT only)
+  sr_param<bool> m_dmi_en;
+
+  /// Number of accesses served through DMI
+  sr_param<uint64_t> m_dmi_accesses;
+
+  /// Issue bus accesses from the CPU thread at its local time instead of
+  /// through mem_access (LT with a temporally decoupled AHBCtrl)
+  sr_param<bool> m_ltdecoupled;
+
+  /// DMI regions acquired from the bus, by start address
+  std::map<uint64_t, t_dmi_region> m_dmi_regions;
+
+  /// Per 1 MB area: the region of the last DMI access to it (or NULL)
+  t_dmi_region *m_dmi_hint[4096];
+
+  /// 1 MB AHB areas, which refused DMI
+  std::set<uint32_t> m_dmi_denied;
+
+  /// Transactions queued in bus_in_fifo or in flight on the AHB
+  unsigned int m_bus_pending;
+
+  /// Notified when the last pending bus transaction has completed
+  sc_event bus_idle;
+
+  /// Bus access of a host thread slice executed by the SystemC kernel
+  class bus_call;
+
+  /// Snoops are queued while a host thread slice runs (see HostQuantum)
+  bool m_defer_snoops;
+
+  /// Snoops received during a host thread slice
+  std::vector<t_snoop> m_deferred_snoops;
+
+  /// DMI stores of a host thread slice, the other caches have to snoop them
+  std::vector<t_snoop> m_dmi_stores;
+
+  /// Binary trace of instruction fetches and data accesses, NULL disables it
+  TraceWriter::Channel *m_tracer;
+
+  /// Put an access issued at local time start into the binary trace
+  void trace_access(uint8_t kind, unsigned int addr, const unsigned char *ptr, unsigned int len, unsigned int asi,
+                    const sc_core::sc_time &start) {
+    // ptr holds target (big-endian) bytes, the value is built in host order
+    // like the opcode of TRACE_INSTR. Shorter accesses are right-aligned.
+    uint32_t data = 0;
+    for (unsigned int i = 0; i < len && i < 4; i++) {
+      data = (data << 8) | ptr[i];
+    }
+    m_tracer->record(kind, (sc_core::sc_time_stamp() + start).value(), addr, data, len, asi);
+  }
+
 };
 
 /// @}
@@ -18,9 +18,9 @@
 #define __MMU_IF_H__
 
 #include <tlm.h>
-#include <map>
 
 #include "gaisler/leon3/mmucache/defines.h"
+#include "gaisler/leon3/mmucache/tlb_array.h"
 
 class mmu_if {
 
@@ -28,7 +28,7 @@ class mmu_if {
 
         // page descriptor cache (PDC) lookup
         virtual signed tlb_lookup(unsigned int addr, unsigned asi,
-                             std::map<t_VAT, t_PTE_context> * tlb,
+                             tlb_array * tlb,
                              unsigned int tlb_size, sc_core::sc_time * t,
                              unsigned int * debug, bool is_dbg, bool &cacheable,
                              unsigned is_write /* LOAD / STORE? */, uint64_t * paddr ) = 0;
@@ -0,0 +1,91 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup mmu_cache
+/// @{
+/// @file tlb_array.cpp
+/// Storage of the page descriptor cache (TLB). The entries are kept in a
+/// flat set-associative array, which is indexed by virtual page number and
+/// context.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <cassert>
+#include "gaisler/leon3/mmucache/tlb_array.h"
+
+tlb_array::tlb_array(unsigned int entries, unsigned int rep) :
+    m_entries(NULL), m_sets(1), m_ways(entries), m_rep(rep), m_stamp(0), m_pseudo_rand(0) {
+
+    // Up to four ways per set, the remaining entries are
+    // spread over a power-of-two number of sets.
+    if (m_ways > 4) {
+        m_ways = 4;
+        while ((m_sets << 1) * m_ways <= entries) {
+            m_sets <<= 1;
+        }
+    }
+    // Other sizes would silently lose entries
+    assert(m_sets * m_ways == entries);
+
+    m_entries = new t_PTE_context[m_sets * m_ways];
+
+    for (unsigned int i = 0; i < m_sets * m_ways; i++) {
+        m_entries[i].tlb_no = i;
+    }
+
+    flush();
+}
+
+tlb_array::~tlb_array() {
+    delete[] m_entries;
+}
+
+t_PTE_context * tlb_array::allocate(t_VAT vpn, unsigned int context) {
+    t_PTE_context * set = &m_entries[set_of(vpn, context) * m_ways];
+    t_PTE_context * victim = NULL;
+
+    for (unsigned int way = 0; way < m_ways; way++) {
+        // Refill an existing translation in place
+        if (set[way].valid && set[way].vpn == vpn && set[way].context == context) {
+            victim = &set[way];
+            break;
+        }
+        if (!set[way].valid && !victim) {
+            victim = &set[way];
+        }
+    }
+
+    if (!victim) {
+        if (m_rep == 0) {
+            // LRU replaces the entry, which hasn't been used for the longest time.
+            victim = &set[0];
+            for (unsigned int way = 1; way < m_ways; way++) {
+                if (set[way].lru < victim->lru) {
+                    victim = &set[way];
+                }
+            }
+        } else {
+            // Random replacement is implemented through a
+            // modulo-N counter that selects the way to be removed.
+            victim = &set[m_pseudo_rand++ % m_ways];
+        }
+    }
+
+    victim->valid = true;
+    victim->vpn = vpn;
+    victim->context = context;
+    victim->lru = ++m_stamp;
+    return victim;
+}
+
+void tlb_array::flush() {
+    for (unsigned int i = 0; i < m_sets * m_ways; i++) {
+        m_entries[i].valid = false;
+        m_entries[i].lru = 0;
+    }
+}
+/// @}
@@ -0,0 +1,105 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup mmu_cache
+/// @{
+/// @file tlb_array.h
+/// Storage of the page descriptor cache (TLB). The entries are kept in a
+/// flat set-associative array, which is indexed by virtual page number and
+/// context. A lookup touches at most one set instead of searching a map.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef __TLB_ARRAY_H__
+#define __TLB_ARRAY_H__
+
+#include <stdint.h>
+
+#include "gaisler/leon3/mmucache/defines.h"
+
+class tlb_array {
+
+    public:
+
+        /// Constructor
+        /// @param entries Total number of TLB entries (2-32)
+        /// @param rep     Replacement strategy (0 - LRU, else pseudo random)
+        tlb_array(unsigned int entries, unsigned int rep);
+
+        /// Destructor
+        ~tlb_array();
+
+        /// Returns the valid entry translating vpn in context, or NULL on a miss
+        inline t_PTE_context * lookup(t_VAT vpn, unsigned int context) {
+            t_PTE_context * entry = &m_entries[set_of(vpn, context) * m_ways];
+            for (unsigned int way = 0; way < m_ways; way++, entry++) {
+                if (entry->valid && entry->vpn == vpn && entry->context == context) {
+                    return entry;
+                }
+            }
+            return NULL;
+        }
+
+        /// Updates the replacement history after a hit
+        inline void touch(t_PTE_context * entry) {
+            entry->lru = ++m_stamp;
+        }
+
+        /// Returns the entry to be (re)filled for vpn in context.
+        /// This is the matching entry, a free one, or a victim of the set.
+        t_PTE_context * allocate(t_VAT vpn, unsigned int context);
+
+        /// Invalidates all entries
+        void flush();
+
+        /// Number of entries
+        unsigned int size() const {
+            return m_sets * m_ways;
+        }
+
+        /// Entry storage, set after set (used for checkpoints)
+        t_PTE_context * entries() {
+            return m_entries;
+        }
+
+        /// Global use counter (used for checkpoints)
+        uint64_t stamp() const {
+            return m_stamp;
+        }
+
+        /// Set the global use counter (used for checkpoints)
+        void set_stamp(uint64_t stamp) {
+            m_stamp = stamp;
+        }
+
+    private:
+
+        inline unsigned int set_of(t_VAT vpn, unsigned int context) const {
+            return (vpn ^ context) & (m_sets - 1);
+        }
+
+        /// Entry storage, set after set
+        t_PTE_context * m_entries;
+
+        /// Number of sets (power of two)
+        unsigned int m_sets;
+
+        /// Number of ways per set
+        unsigned int m_ways;
+
+        /// Replacement strategy
+        unsigned int m_rep;
+
+        /// Global use counter for LRU replacement
+        uint64_t m_stamp;
+
+        /// Modulo-N counter for pseudo random replacement
+        uint32_t m_pseudo_rand;
+};
+
+#endif  // __TLB_ARRAY_H__
+/// @}
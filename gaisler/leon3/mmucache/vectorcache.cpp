@@ -53,6 +53,7 @@ vectorcache::vectorcache(ModuleName name,
     m_lram(lram),
     m_lramstart(lramstart),
     m_lramsize((unsigned)log2((double)lramsize)),
+    m_flat_storage("flat_storage", false),
     m_performance_counters("performance_counters"),
     rhits("read_hits", sets, m_performance_counters),
     rmisses("read_misses", 0ull, m_performance_counters),
@@ -105,7 +106,19 @@ vectorcache::vectorcache(ModuleName name,
     //cache_mem = new std::vector<t_cache_line>(m_number_of_vectors*sets);
     cache_mem = new std::vector<t_cache_line*>();
     mapped_regions = new std::vector<scireg_ns::scireg_mapped_region*>();
-    for (uint32_t i = 0; i < m_number_of_vectors*sets; i++) {
+    m_tags = NULL;
+    m_data = NULL;
+    m_flat_view = NULL;
+
+    // Flat storage: packed tag and data arrays, no per-line modules
+    if (m_flat_storage) {
+      m_tags = new t_cache_tag[m_number_of_vectors*sets];
+      memset(m_tags, 0, sizeof(t_cache_tag)*m_number_of_vectors*sets);
+      m_data = new uint32_t[m_number_of_vectors*sets*linesize];
+      memset(m_data, 0, sizeof(uint32_t)*m_number_of_vectors*sets*linesize);
+    }
+
+    for (uint32_t i = 0; !m_flat_storage && i < m_number_of_vectors*sets; i++) {
       char *buffer = new char[11];
       snprintf(buffer, 11, "line_%d", i);
 
@@ -132,6 +145,7 @@ vectorcache::vectorcache(ModuleName name,
     v::info << this->name() << " * waylock: " << m_setlock << v::endl;
     v::info << this->name() << " * linesize: " << linesize << v::endl;
     v::info << this->name() << " * repl (0-Direct Mapped, 1-LRU, 2-LRR, 3-Random): " << m_repl << v::endl;
+    v::info << this->name() << " * flat_storage: " << m_flat_storage << v::endl;
     v::info << this->name() << " * ---------------------------------------------------------- " << v::endl;
     v::info << this->name() << " * Size of each cache way " << (unsigned)pow(2, (double)m_setsize) << " kb" << v::endl;
     v::info << this->name() << " * Bytes per line " << m_bytesperline << " (offset bits: " << m_offset_bits << ")" << v::endl;
@@ -201,6 +215,9 @@ vectorcache::~vectorcache() {
   }
   delete cache_mem;
   delete mapped_regions;
+  delete[] m_tags;
+  delete[] m_data;
+  delete m_flat_view;
 
 } // vectorcache::~vectorcache()
 
@@ -267,7 +284,7 @@ bool vectorcache::mem_read(unsigned int address, unsigned int asi, unsigned char
         ("offset", offset)
         ("byt", byt)
         ("read");
-      (*lookup_line(idx, cache_hit))->entry.copy_from(data, len, offset >> 2, byt);
+      line_read(idx, cache_hit, data, len, offset >> 2, byt);
 
 
       // Update flags
@@ -540,20 +557,14 @@ void vectorcache::read_cache_tag(unsigned int address, unsigned int * data,
   unsigned idx = get_idx(address);
   unsigned way = get_tag(address) & 0x3;
 
-  // find the required cache line
-  t_cache_line* line = (*lookup_line(idx, way));
-
   // build bitmask from tag fields
   // (! The atag field starts bit 10. It is not MSB aligned as in the actual tag layout.)
-  uint32_t tmp_valid;
-  line->tag[t_cache_line::VALID].bus_read(tmp_valid);
-
-  tmp = line->tag[t_cache_line::ATAG].bus_read() << 10;
-  tmp |= line->tag[t_cache_line::LRR].bus_read() << 9;
-  tmp |= line->tag[t_cache_line::LOCK].bus_read() << 8;
-  tmp |= tmp_valid;
+  tmp = tag_read(idx, way, t_cache_line::ATAG) << 10;
+  tmp |= tag_read(idx, way, t_cache_line::LRR) << 9;
+  tmp |= tag_read(idx, way, t_cache_line::LOCK) << 8;
+  tmp |= tag_read(idx, way, t_cache_line::VALID);
 
-  srDebug()("tag", line->tag[t_cache_line::ATAG])
+  srDebug()("tag", tag_read(idx, way, t_cache_line::ATAG))
            ("idx", idx)
            ("way", way)
            ("Diagnostic read cache tag");
@@ -592,24 +603,21 @@ void vectorcache::write_cache_tag(unsigned int address, unsigned int * data,
   unsigned idx = get_idx(address);
   unsigned way = get_tag(address) & 0x3;
 
-  // find the required cache line
-  t_cache_line* line = (*lookup_line(idx, way));
-
   // update the tag with write data
   // (! The atag field is expected to start at bit 10. Not MSB aligned as in tag layout.)
-  line->tag[t_cache_line::ATAG].bus_write( *data >> 10);
-  line->tag[t_cache_line::LRR].bus_write((*data & 0x100) >> 9);
+  tag_write(idx, way, t_cache_line::ATAG, *data >> 10);
+  tag_write(idx, way, t_cache_line::LRR, (*data & 0x100) >> 9);
   // lock bit can only be set, if line locking is enabled
   // locking only works in multi-way configurations. the last way must never be locked.
-  line->tag[t_cache_line::LOCK].bus_write(((m_setlock) && (way != m_sets))? ((*data & 0x100) >> 8) : 0);
-  line->tag[t_cache_line::VALID].bus_write((*data & 0xff));
+  tag_write(idx, way, t_cache_line::LOCK, ((m_setlock) && (way != m_sets))? ((*data & 0x100) >> 8) : 0);
+  tag_write(idx, way, t_cache_line::VALID, (*data & 0xff));
 
-  srDebug()("tag", line->tag[t_cache_line::ATAG])
+  srDebug()("tag", tag_read(idx, way, t_cache_line::ATAG))
            ("idx", idx)
            ("way", way)
-           ("lrr", line->tag[t_cache_line::LRR])
-           ("lock", line->tag[t_cache_line::LOCK])
-           ("valid", line->tag[t_cache_line::VALID])
+           ("lrr", tag_read(idx, way, t_cache_line::LRR))
+           ("lock", tag_read(idx, way, t_cache_line::LOCK))
+           ("valid", tag_read(idx, way, t_cache_line::VALID))
            ("Diagnostic write cache tag");
 
   // increment time
@@ -633,10 +641,7 @@ void vectorcache::read_cache_entry(unsigned int address, unsigned int * data,
   unsigned sb = (address << (32 - m_offset_bits) >> (34 - m_offset_bits));
   unsigned way = get_tag(address) & 0x3;
 
-  // find the required cache line
-  t_cache_line* line = (*lookup_line(idx, way));
-
-  *data = line->entry.get_int(sb);
+  line_read(idx, way, reinterpret_cast<unsigned char *>(data), 4, sb, 0);
 
   srDebug()("idx", idx)
            ("subblock", sb)
@@ -665,10 +670,7 @@ void vectorcache::write_cache_entry(unsigned int address, unsigned int * data,
   unsigned sb = (address << (32 - m_offset_bits) >> (34 - m_offset_bits));
   unsigned way = get_tag(address) & 0x3;
 
-  // find the required cache line
-  t_cache_line* line = (*lookup_line(idx, way));
-
-  line->entry.set_int(sb, *data);
+  line_write(idx, way, reinterpret_cast<unsigned char *>(data), 4, sb, 0);
 
   srDebug()("idx", idx)
            ("subblock", sb)
@@ -690,6 +692,13 @@ void vectorcache::flush(sc_core::sc_time *t, unsigned int * debug, bool is_dbg)
   unsigned i_line = 0;
 //  bool cacheable = true;
 
+  // flat storage: invalidate all entries at once
+  if (m_flat_storage) {
+    for (i_line = 0; i_line < m_number_of_vectors*(m_sets+1); i_line++) {
+      m_tags[i_line].valid = 0;
+    }
+  }
+
   // for all cache lines
   for (std::vector<t_cache_line*>::iterator line = cache_mem->begin();
        line < cache_mem->end(); line++, i_line++) {
@@ -748,19 +757,15 @@ void vectorcache::snoop_invalidate(const t_snoop& snoop, const sc_core::sc_time&
       offset = get_offset(address);
       way    = 0;
 
-      for (std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
-           way <= m_sets; line++, way++) {
+      for (; way <= m_sets; way++) {
 
         // Check the cache tag
-        if (((*line)->tag[t_cache_line::ATAG]).bus_read() == tag) {
+        if (tag_read(idx, way, t_cache_line::ATAG) == tag) {
 
-          uint32_t tmp;
           if (!m_new_linefetch_en) {
-            (*line)->tag[t_cache_line::VALID].bus_read(tmp);
-
-            (*line)->tag[t_cache_line::VALID].bus_write(tmp & ~offset2valid(offset));
+            tag_write(idx, way, t_cache_line::VALID, tag_read(idx, way, t_cache_line::VALID) & ~offset2valid(offset));
           } else {
-            (*line)->tag[t_cache_line::VALID].bus_write(0);
+            tag_write(idx, way, t_cache_line::VALID, 0);
           }
         }
       }
@@ -811,7 +816,6 @@ unsigned int vectorcache::offset2valid(unsigned int offset, unsigned int len) {
 /// Selects way to be refilled depending on replacement strategy
 unsigned int vectorcache::replacement_selector(unsigned int idx, unsigned int mode) {
 
-  std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
   unsigned way = 0, way_select = 0;
   uint32_t min_lru;
 
@@ -835,13 +839,11 @@ unsigned int vectorcache::replacement_selector(unsigned int idx, unsigned int mo
       // Find the cache line with the lowest LRU value.
       min_lru = m_max_lru;
 
-      for (; way <= m_sets; line++, way++) {
+      for (; way <= m_sets; way++) {
 
         // The last way will never be locked.
-        uint32_t tmp_lru;
-        (*line)->tag[t_cache_line::LRU].bus_read(tmp_lru);
-        uint32_t tmp_lock;
-        (*line)->tag[t_cache_line::LRU].bus_read(tmp_lock);
+        uint32_t tmp_lru = tag_read(idx, way, t_cache_line::LRU);
+        uint32_t tmp_lock = tag_read(idx, way, t_cache_line::LRU);
         if ((tmp_lru <= min_lru) && (tmp_lock == 0)) {
           min_lru = tmp_lru;
           way_select = way;
@@ -859,9 +861,9 @@ unsigned int vectorcache::replacement_selector(unsigned int idx, unsigned int mo
       // The last way (way 1) will never be locked.
       way_select = 1;
 
-      for (; way <= 2; line++, way++) {
+      for (; way <= 2; way++) {
 
-        if (((*line)->tag[t_cache_line::LRR].bus_read() == 0) && ((*line)->tag[t_cache_line::LOCK].bus_read() == 0)) {
+        if ((tag_read(idx, way, t_cache_line::LRR) == 0) && (tag_read(idx, way, t_cache_line::LOCK) == 0)) {
 
           srDebug()("selected way", way)("LRR Replacement");
           way_select = way;
@@ -883,7 +885,7 @@ unsigned int vectorcache::replacement_selector(unsigned int idx, unsigned int mo
 
       }
       // The last way will never be locked.
-      while (line[way_select]->tag[t_cache_line::LOCK].bus_read() != 0);
+      while (tag_read(idx, way_select, t_cache_line::LOCK) != 0);
 
       srDebug()("selected way", way_select)("Pseudo Random Replacement");
   }
@@ -897,15 +899,13 @@ unsigned int vectorcache::replacement_selector(unsigned int idx, unsigned int mo
 /// Updates the LRR bits for every line replacement
 void vectorcache::lrr_update(unsigned int idx, unsigned int way_select) {
 
-  std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
-
   // LRR may only be used for 2-way associative caches.
-  for (unsigned way = 0; way < 2; line++, way++) {
+  for (unsigned way = 0; way < 2; way++) {
 
     // Switch the lrr bit on for the selected way and off for the remaining.
-    (*line)->tag[t_cache_line::LRR].bus_write((way == way_select)? 1 : 0);
+    tag_write(idx, way, t_cache_line::LRR, (way == way_select)? 1 : 0);
 
-    srDebug()("way", way)("LRR", (*line)->tag[t_cache_line::LRR])("LRR update");
+    srDebug()("way", way)("LRR", tag_read(idx, way, t_cache_line::LRR))("LRR update");
 
   }
 
@@ -916,23 +916,20 @@ void vectorcache::lrr_update(unsigned int idx, unsigned int way_select) {
 /// Updates the LRU counters for every cache hit
 void vectorcache::lru_update(unsigned int idx, unsigned int way_select) {
 
-  std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
-  uint32_t pivot = (*lookup_line(idx, way_select))->tag[t_cache_line::LRU].bus_read();
+  uint32_t pivot = tag_read(idx, way_select, t_cache_line::LRU);
   unsigned lru;
 
-  for (unsigned way = 0; way <= m_sets; line++, way++) {
-    lru = (*line)->tag[t_cache_line::LRU].bus_read();
+  for (unsigned way = 0; way <= m_sets; way++) {
+    lru = tag_read(idx, way, t_cache_line::LRU);
 
     // LRU: Counter for each line of a way
     if (way == way_select) {
-      (*line)->tag[t_cache_line::LRU].bus_write(m_max_lru);
-    } else if ((*line)->tag[t_cache_line::LRU].bus_read() > pivot) {
-      uint32_t tmp_lru;
-      (*line)->tag[t_cache_line::LRU].bus_read(tmp_lru);
-      (*line)->tag[t_cache_line::LRU].bus_write(tmp_lru-1);
+      tag_write(idx, way, t_cache_line::LRU, m_max_lru);
+    } else if (lru > pivot) {
+      tag_write(idx, way, t_cache_line::LRU, lru-1);
     }
 
-    srDebug()("way", way)("old LRU", lru)("new LRU", (*line)->tag[t_cache_line::LRU])("LRU update");
+    srDebug()("way", way)("old LRU", lru)("new LRU", tag_read(idx, way, t_cache_line::LRU))("LRU update");
 
   }
 
@@ -949,37 +946,54 @@ int vectorcache::locate_line(unsigned int const tag,
   unsigned way = 0;
   bool found = false;
 
-  // Lookup all cache ways
-  for (std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
-       way <= m_sets; line++, way++) {
-
-    // Check the cache tag
-    if ((*line)->tag[t_cache_line::ATAG].bus_read() == tag) {
-
-      // Check the valid bit
-      uint32_t tmp_valid;
-      (*line)->tag[t_cache_line::VALID].bus_read(tmp_valid);
-      if ((!m_new_linefetch_en && (tmp_valid & offset2valid(offset, len)) == offset2valid(offset, len))
-      || (m_new_linefetch_en && (tmp_valid & 0x1))) {
-
-        srDebug()("way", way)
-                 ("valid", (*line)->tag[t_cache_line::VALID])
-                 ("valid mask",offset2valid(offset, len))
-                 ("Cache hit in current way");
-        found = true;
-        break;
-      } else {
-
-        srDebug()("way", way)
-                 ("valid", (*line)->tag[t_cache_line::VALID])
-                 ("valid mask",offset2valid(offset, len))
-                 ("Cache hit but invalid data in current way");
+  // Flat storage: compare the packed tags of the set in one sweep
+  if (m_flat_storage) {
 
-      } // Cache hit but invalid
-    } else {
-      srDebug()("way", way)("Cache miss in current way");
+    t_cache_tag *line = flat_tag(idx, 0);
+    for (; way <= m_sets; line++, way++) {
+      if (line->atag == tag) {
+        unsigned mask = m_new_linefetch_en? 0x1 : offset2valid(offset, len);
+        if ((line->valid & mask) == mask) {
+          found = true;
+          break;
+        }
+      }
     }
-  } // loop m_sets
+
+  } else {
+
+    // Lookup all cache ways
+    for (std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
+         way <= m_sets; line++, way++) {
+
+      // Check the cache tag
+      if ((*line)->tag[t_cache_line::ATAG].bus_read() == tag) {
+
+        // Check the valid bit
+        uint32_t tmp_valid;
+        (*line)->tag[t_cache_line::VALID].bus_read(tmp_valid);
+        if ((!m_new_linefetch_en && (tmp_valid & offset2valid(offset, len)) == offset2valid(offset, len))
+        || (m_new_linefetch_en && (tmp_valid & 0x1))) {
+
+          srDebug()("way", way)
+                   ("valid", (*line)->tag[t_cache_line::VALID])
+                   ("valid mask",offset2valid(offset, len))
+                   ("Cache hit in current way");
+          found = true;
+          break;
+        } else {
+
+          srDebug()("way", way)
+                   ("valid", (*line)->tag[t_cache_line::VALID])
+                   ("valid mask",offset2valid(offset, len))
+                   ("Cache hit but invalid data in current way");
+
+        } // Cache hit but invalid
+      } else {
+        srDebug()("way", way)("Cache miss in current way");
+      }
+    } // loop m_sets
+  }
 
   // Increment time
   *delay += clockcycle;
@@ -1007,31 +1021,27 @@ int vectorcache::update_line (unsigned const tag,
                               unsigned int * debug,
                               bool& cacheable, bool is_dbg) {
 
-    t_cache_line* line = (*lookup_line(idx, way));
-
     // Update data in cache
     // This is written generically to serve both aligned reads and non-aligned
     // writes.
-    line->entry.copy_to(data, len, offset >> 2, offset & 0x3);
+    line_write(idx, way, data, len, offset >> 2, offset & 0x3);
 
     // Update tag and flags for line allocate
-    if (line->tag[t_cache_line::ATAG].bus_read() != tag) {
+    if (tag_read(idx, way, t_cache_line::ATAG) != tag) {
 
-      line->tag[t_cache_line::ATAG].bus_write(tag);
+      tag_write(idx, way, t_cache_line::ATAG, tag);
 
       if (m_repl == 2) lrr_update(idx, way);
 
-      line->tag[t_cache_line::VALID].bus_write(0);
+      tag_write(idx, way, t_cache_line::VALID, 0);
 
     }
 
     // Update flags for line allocate or update
     if (!m_new_linefetch_en) {
-      uint32_t tmp_valid;
-      line->tag[t_cache_line::VALID].bus_read(tmp_valid);
-      line->tag[t_cache_line::VALID].bus_write(tmp_valid | offset2valid(offset, len));
+      tag_write(idx, way, t_cache_line::VALID, tag_read(idx, way, t_cache_line::VALID) | offset2valid(offset, len));
     } else {
-      line->tag[t_cache_line::VALID].bus_write(0x1);
+      tag_write(idx, way, t_cache_line::VALID, 0x1);
     }
     if (m_repl == 1) lru_update(idx, way);
 
@@ -1074,11 +1084,9 @@ int vectorcache::allocate_line (unsigned const tag,
   bool found = false;
 
   // Easiest option for replacement is using invalid cache lines.
-  for (std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
-       way <= m_sets; line++, way++) {
+  for (; way <= m_sets; way++) {
 
-    uint32_t tmp_valid;
-    (*line)->tag[t_cache_line::VALID].bus_read(tmp_valid);
+    uint32_t tmp_valid = tag_read(idx, way, t_cache_line::VALID);
     if ((!m_new_linefetch_en && (tmp_valid & offset2valid(offset, len)) == 0 /* == offset2valid(offset, len) instead of 0? */)
     || (m_new_linefetch_en && (tmp_valid & 0x1) == 0)) {
 
@@ -1098,6 +1106,24 @@ int vectorcache::allocate_line (unsigned const tag,
   return update_line(tag, idx, offset, way, len, data, delay, debug, cacheable, is_dbg);
 } // vectorcache::allocate_line()
 
+/// ----------------------------------------------------------------------------
+
+/// Registers the scireg view of the packed cache data.
+/// Created on first introspection, so flat caches stay cheap to construct.
+void vectorcache::create_flat_view() const {
+
+  uint32_t bytes = m_number_of_vectors * (m_sets + 1) * m_bytesperline;
+
+  m_flat_view = new t_cache_flat_view("lines", reinterpret_cast<uint8_t *>(m_data), bytes);
+
+  scireg_ns::scireg_mapped_region *mapped_region = new scireg_ns::scireg_mapped_region();
+  mapped_region->region = m_flat_view;
+  mapped_region->offset = 0;
+  mapped_region->name = "lines";
+  mapped_regions->push_back(mapped_region);
+
+} // vectorcache::create_flat_view()
+
 /// @} Internal Methods
 /// ****************************************************************************
 /// @name Diagnostic Methods
@@ -1114,13 +1140,12 @@ void vectorcache::dbg_out(unsigned int idx) {
 
   unsigned way = 0;
 
-  for (std::vector<t_cache_line*>::iterator line = lookup_line(idx, 0);
-       way <= m_sets; line++, way++) {
+  for (; way <= m_sets; way++) {
 
     // display the tag
-    srDebug()("tag", (*line)->tag[t_cache_line::ATAG])
+    srDebug()("tag", tag_read(idx, way, t_cache_line::ATAG))
              ("way", way)
-             ("valid", (*line)->tag[t_cache_line::VALID])
+             ("valid", tag_read(idx, way, t_cache_line::VALID))
              ("Diagnostic cache line display (big-endian)");
 
     // display all entries
@@ -1129,7 +1154,9 @@ void vectorcache::dbg_out(unsigned int idx) {
       std::cout << "Entry: " << j << " - ";
 
       for (unsigned k = 0; k < 4; k++) {
-        std::cout << hex << std::setw(2) << (unsigned)(*line)->entry.get_char(j, k);
+        unsigned char tmp;
+        line_read(idx, way, &tmp, 1, j, k);
+        std::cout << hex << std::setw(2) << (unsigned)tmp;
       }
 
       std::cout << " " << std::endl;
@@ -1197,6 +1224,60 @@ void vectorcache::end_of_simulation() {
 
 } // vectorcache::end_of_simulation()
 
+/// Save tags and data of all cache lines (works for flat and register storage)
+void vectorcache::checkpoint_save(CheckpointArchive &ar) {
+
+  static const uint32_t fields[5] = {t_cache_line::VALID, t_cache_line::ATAG,
+    t_cache_line::LRR, t_cache_line::LRU, t_cache_line::LOCK};
+  uint32_t lines = m_number_of_vectors * (m_sets + 1);
+  std::vector<uint32_t> tags(lines * 5);
+  std::vector<uint8_t> data(lines * m_bytesperline);
+
+  for (uint32_t idx = 0; idx < m_number_of_vectors; idx++) {
+    for (uint32_t way = 0; way <= m_sets; way++) {
+      uint32_t line = idx * (m_sets + 1) + way;
+      for (uint32_t f = 0; f < 5; f++) {
+        tags[line * 5 + f] = tag_read(idx, way, fields[f]);
+      }
+      line_read(idx, way, &data[line * m_bytesperline], m_bytesperline, 0, 0);
+    }
+  }
+
+  ar.put("tags", &tags[0], tags.size() * sizeof(uint32_t));
+  ar.put("data", &data[0], data.size());
+  ar.put("pseudo_rand", m_pseudo_rand);
+
+} // vectorcache::checkpoint_save()
+
+/// Restore tags and data of all cache lines. A cache of a different geometry is left empty.
+void vectorcache::checkpoint_restore(const CheckpointArchive &ar) {
+
+  static const uint32_t fields[5] = {t_cache_line::VALID, t_cache_line::ATAG,
+    t_cache_line::LRR, t_cache_line::LRU, t_cache_line::LOCK};
+  uint32_t lines = m_number_of_vectors * (m_sets + 1);
+  std::vector<uint32_t> tags(lines * 5);
+  std::vector<uint8_t> data(lines * m_bytesperline);
+
+  if (!ar.get("tags", &tags[0], tags.size() * sizeof(uint32_t)) ||
+      !ar.get("data", &data[0], data.size())) {
+    v::warn << name() << "Cache geometry differs from checkpoint, cache contents not restored" << v::endl;
+    return;
+  }
+
+  for (uint32_t idx = 0; idx < m_number_of_vectors; idx++) {
+    for (uint32_t way = 0; way <= m_sets; way++) {
+      uint32_t line = idx * (m_sets + 1) + way;
+      for (uint32_t f = 0; f < 5; f++) {
+        tag_write(idx, way, fields[f], tags[line * 5 + f]);
+      }
+      line_write(idx, way, &data[line * m_bytesperline], m_bytesperline, 0, 0);
+    }
+  }
+
+  ar.get("pseudo_rand", m_pseudo_rand);
+
+} // vectorcache::checkpoint_restore()
+
 /// @name Diagnostic Methods
 /// ****************************************************************************
 ///@} mmu_cache
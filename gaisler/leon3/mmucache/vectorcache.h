@@ -19,12 +19,14 @@
 
 #include <vector>
 #include <stdio.h>
+#include <string.h>
 #include <string>
 #include <sstream>
 #include "core/common/base.h"
 #include "core/common/systemc.h"
 #include "core/common/sr_param.h"
 #include "core/common/scireg.h"
+#include "core/common/checkpoint.h"
 
 #include "math.h"
 #include "core/common/verbose.h"
@@ -37,7 +39,7 @@
 
 // implementation of cache memory and controller
 /// @brief virtual cache model, contain common functionality of instruction and data cache
-class vectorcache : public DefaultBase, public cache_if, public scireg_ns::scireg_region_if
+class vectorcache : public DefaultBase, public cache_if, public scireg_ns::scireg_region_if, public Checkpointable
 {
 
   /// --------------------------------------------------------------------------
@@ -96,6 +98,9 @@ public:
   virtual scireg_ns::scireg_response scireg_get_child_regions(
       std::vector<scireg_ns::scireg_mapped_region>& mapped_regions,
       sc_dt::uint64 size=sc_dt::uint64(-1), sc_dt::uint64 offset=0) const {
+   if (m_flat_storage && !m_flat_view) {
+     create_flat_view();
+   }
    for (std::vector<scireg_ns::scireg_mapped_region*>::const_iterator i = this->mapped_regions->begin();
        i != this->mapped_regions->end(); ++i) {
      mapped_regions.push_back(**i);
@@ -133,8 +138,65 @@ protected:
   /// Reads a cache line from a given cache way.
   /// Returns an iterator to found line (more useful than pointer for looping through ways of a given index).
   /// Returns null for incorrect parameters.
+  /// Only available for register storage (flat_storage = false).
   inline std::vector<t_cache_line*>::iterator lookup_line(unsigned idx, unsigned way) {return (cache_mem->begin())+(idx*(m_sets+1)+way);}
 
+  /// Returns the packed tag of a cache line (flat storage)
+  inline t_cache_tag *flat_tag(unsigned idx, unsigned way)
+    {return &m_tags[idx*(m_sets+1)+way];}
+  /// Returns the packed data of a cache line (flat storage)
+  inline uint8_t *flat_data(unsigned idx, unsigned way)
+    {return reinterpret_cast<uint8_t*>(&m_data[(idx*(m_sets+1)+way)*m_wordsperline]);}
+
+  /// Reads a tag field (t_cache_line::VALID, ATAG, LRR, LRU or LOCK) of a cache line
+  inline uint32_t tag_read(unsigned idx, unsigned way, uint32_t field) {
+    if (m_flat_storage) {
+      t_cache_tag *tag = flat_tag(idx, way);
+      switch (field) {
+        case t_cache_line::VALID: return tag->valid;
+        case t_cache_line::ATAG:  return tag->atag;
+        case t_cache_line::LRR:   return tag->lrr;
+        case t_cache_line::LRU:   return tag->lru;
+        default:                  return tag->lock;
+      }
+    }
+    return (*lookup_line(idx, way))->tag[field].bus_read();
+  }
+
+  /// Writes a tag field (t_cache_line::VALID, ATAG, LRR, LRU or LOCK) of a cache line
+  inline void tag_write(unsigned idx, unsigned way, uint32_t field, uint32_t value) {
+    if (m_flat_storage) {
+      t_cache_tag *tag = flat_tag(idx, way);
+      switch (field) {
+        case t_cache_line::VALID: tag->valid = value; break;
+        case t_cache_line::ATAG:  tag->atag = value; break;
+        case t_cache_line::LRR:   tag->lrr = value; break;
+        case t_cache_line::LRU:   tag->lru = value; break;
+        default:                  tag->lock = value;
+      }
+      return;
+    }
+    (*lookup_line(idx, way))->tag[field].bus_write(value);
+  }
+
+  /// Copies len bytes from a cache line (starting at word index, byte position) to dst
+  inline void line_read(unsigned idx, unsigned way, unsigned char *dst, unsigned len, unsigned index, unsigned position) {
+    if (m_flat_storage) {
+      memcpy(dst, flat_data(idx, way) + (index << 2) + position, len);
+    } else {
+      (*lookup_line(idx, way))->entry.copy_from(dst, len, index, position);
+    }
+  }
+
+  /// Copies len bytes from src into a cache line (starting at word index, byte position)
+  inline void line_write(unsigned idx, unsigned way, const unsigned char *src, unsigned len, unsigned index, unsigned position) {
+    if (m_flat_storage) {
+      memcpy(flat_data(idx, way) + (index << 2) + position, src, len);
+    } else {
+      (*lookup_line(idx, way))->entry.copy_to(src, len, index, position);
+    }
+  }
+
   /// Searches for a cache tag in all cache ways. Updates power information for reading tags.
   /// Returns found way if tag matches and data is valid, otherwise -1.
   int locate_line(unsigned const tag, unsigned const idx, unsigned const offset, unsigned const len,
@@ -147,6 +209,9 @@ protected:
                   unsigned char* const data,
                   sc_core::sc_time * delay, unsigned* debug, bool& cacheable, bool is_dbg);
 
+  /// Registers the scireg view of the packed cache data (flat storage)
+  void create_flat_view() const;
+
   /// Allocates a cache line in either an invalid way or a way found be replacement selection.
   /// Updates timing and power information.
   /// Returns the allocated way, otherwise -1.
@@ -203,6 +268,11 @@ protected:
 public:
   void end_of_simulation();
 
+  /// Save tags and data of all cache lines
+  void checkpoint_save(CheckpointArchive &ar);
+  /// Restore tags and data of all cache lines
+  void checkpoint_restore(const CheckpointArchive &ar);
+
   /// @} Constructors and Destructors
   /// --------------------------------------------------------------------------
   /// @name Data
@@ -233,11 +303,21 @@ protected:
   /// [31]    Cache locking (CL) - Set if cache locking is implemented
   unsigned int CACHE_CONFIG_REG;
 
-  /// The actual cache memory
+  /// The actual cache memory (register storage)
   std::vector<t_cache_line*> *cache_mem;
 
   /// The children scireg_reagion_ifs
-  std::vector<scireg_ns::scireg_mapped_region*> *mapped_regions;
+  /// (register storage: one per line, flat storage: created on demand)
+  mutable std::vector<scireg_ns::scireg_mapped_region*> *mapped_regions;
+
+  /// Packed cache tags, way after way for each index (flat storage)
+  t_cache_tag *m_tags;
+
+  /// Packed cache data, m_wordsperline words per line (flat storage)
+  uint32_t *m_data;
+
+  /// scireg view of the packed cache data (flat storage, created on demand)
+  mutable t_cache_flat_view *m_flat_view;
 
   /// Indicates whether the cache can be put in burst mode or not
   unsigned int m_burst_en;
@@ -291,6 +371,11 @@ protected:
   /// Size of localram
   unsigned int m_lramsize;
 
+  /// Keep tags and data in packed arrays instead of one register bank
+  /// per cache line. Lines are then only visible through an on-demand
+  /// scireg view of the whole data array.
+  sr_param<bool> m_flat_storage;
+
   /// @} Parameters
   /// --------------------------------------------------------------------------
   /// @name Statistics
@@ -510,6 +510,28 @@ void Mctrl::dorst() {
   }
 }
 
+// Save the configuration registers and the power mode
+void Mctrl::checkpoint_save(CheckpointArchive &ar) {
+  ar.put("mcfg1", r[MCFG1].read());
+  ar.put("mcfg2", r[MCFG2].read());
+  ar.put("mcfg3", r[MCFG3].read());
+  ar.put("mcfg4", r[MCFG4].read());
+  ar.put("pmode", m_pmode);
+}
+
+// Restore the configuration registers and the power mode
+void Mctrl::checkpoint_restore(const CheckpointArchive &ar) {
+  uint32_t mcfg = 0;
+  if (ar.get("mcfg1", mcfg)) r[MCFG1] = mcfg;
+  if (ar.get("mcfg2", mcfg)) r[MCFG2] = mcfg;
+  if (ar.get("mcfg3", mcfg)) r[MCFG3] = mcfg;
+  if (ar.get("mcfg4", mcfg)) r[MCFG4] = mcfg;
+  ar.get("pmode", m_pmode);
+  m_power_down_start = sc_time_stamp();
+  m_self_refresh_start = sc_time_stamp();
+  m_deep_power_down_start = sc_time_stamp();
+}
+
 // Interface to functional part of the model
 uint32_t Mctrl::exec_func(tlm_generic_payload &gp, sc_time &delay, bool debug) {  // NOLINT(runtime/references)
   uint32_t word_delay = 0;
@@ -33,6 +33,7 @@
 #include "core/common/verbose.h"
 #include "core/common/apbslave.h"
 #include "core/common/sr_signal.h"
+#include "core/common/checkpoint.h"
 
 /// @addtogroup mctrl MCtrl
 /// @{
@@ -40,7 +41,8 @@
 /// @brief This class is an TLM 2.0 Model of the Aeroflex Gaisler GRLIB mctrl.
 /// Further informations to the original VHDL Modle are available in the GRLIB IP Core User's Manual Section 66.
 class Mctrl : public AHBSlave<APBSlave>,
-              public CLKDevice {
+              public CLKDevice,
+              public Checkpointable {
   public:
     SC_HAS_PROCESS(Mctrl);
     SR_HAS_SIGNALS(Mctrl);
@@ -143,6 +145,15 @@ class Mctrl : public AHBSlave<APBSlave>,
     /// @param delay A possible delay. Which means the reset might be performed in the future (Not used for resets!).
     void dorst();
 
+    /// Save the configuration registers and the power mode.
+    void checkpoint_save(CheckpointArchive &ar);
+
+    /// Restore the configuration registers and the power mode.
+    ///
+    /// The registers are written without executing SDRAM commands,
+    /// time spent in the restored power mode is counted from now on.
+    void checkpoint_restore(const CheckpointArchive &ar);
+
     // Register Callbacks
     /// Performing an SDRAM Command
     ///
@@ -19,6 +19,7 @@
 
 #include "gaisler/memory/arraystorage.h"
 #include "gaisler/memory/mapstorage.h"
+#include "gaisler/memory/pagedstorage.h"
 #include "gaisler/memory/storage.h"
 #include "core/common/scireg.h"
 #include "core/common/sr_report.h"
@@ -42,23 +42,29 @@ uint8_t MapStorage::read(const uint32_t &addr) const {
   return 0;
 }
 
+// Removes all bytes in [start, end). vmap may be a hash map, so the range
+// is selected by address and not by iterator order.
 void MapStorage::erase(const uint32_t &start, const uint32_t &end) {
-  // Find or insert start address
-  map_mem::iterator start_iter = data.find(start);
-  if (start_iter == data.end()) {
-    data.insert(std::make_pair(start, 0));
-    start_iter = data.find(start);
+  if (end <= start) {
+    return;
   }
 
-  // Find or insert end address
-  map_mem::iterator end_iter = data.find(end);
-  if (end_iter == data.end()) {
-    data.insert(std::make_pair(end, 0));
-    end_iter = data.find(end);
+  if (end - start < data.size()) {
+    // Small range: look up every address
+    for (uint32_t addr = start; addr < end; ++addr) {
+      data.erase(addr);
+    }
+  } else {
+    // Large range: visit every stored byte once
+    map_mem::iterator iter = data.begin();
+    while (iter != data.end()) {
+      if (iter->first >= start && iter->first < end) {
+        data.erase(iter++);
+      } else {
+        ++iter;
+      }
+    }
   }
-
-  // Erase section
-  data.erase(start_iter, end_iter);
 }
 
 void MapStorage::read_block(const uint32_t &addr, uint8_t *ptr, const uint32_t &len) const {
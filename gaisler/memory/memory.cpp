@@ -18,6 +18,10 @@
 #include "gaisler/memory/memory.h"
 
 #include <tlm.h>
+#include <algorithm>
+#include <vector>
+
+#include "core/common/trapgen/elfloader/elfSegmentLoader.hpp"
 
 using namespace sc_core;
 using namespace std;
@@ -76,6 +80,106 @@ Memory::~Memory() {
 
 void Memory::before_end_of_elaboration() {
   set_storage(g_storage_type, get_size());
+  if (!g_elf_file.getValue().empty()) {
+    load_elf(g_elf_file);
+  }
+}
+
+// Load an ELF file segment by segment
+void Memory::load_elf(const std::string &filename) {
+  trap::ELFSegmentLoader loader(filename);
+  const std::vector<trap::ELFSegmentLoader::Segment> &segments = loader.getSegments();
+  uint32_t size = get_size();
+
+  if (!size) {
+    srWarn()
+      ("elf_file", filename)
+      ("Memory has no size, ELF file not loaded");
+    return;
+  }
+
+  for (std::vector<trap::ELFSegmentLoader::Segment>::const_iterator seg = segments.begin(); seg != segments.end(); ++seg) {
+    uint32_t addr = seg->address % size;
+    if (static_cast<uint64_t>(addr) + seg->memSize > size) {
+      srWarn()
+        ("elf_file", filename)
+        ("addr", seg->address)
+        ("size", seg->memSize)
+        ("Segment does not fit into memory, skipped");
+      continue;
+    }
+
+    // Whole segment as one block, zero-initialized part (.bss) erased
+    write_block_dbg(addr, seg->data, seg->fileSize);
+    if (seg->memSize > seg->fileSize) {
+      erase_dbg(addr + seg->fileSize, addr + seg->memSize);
+    }
+  }
+
+  srInfo()
+    ("elf_file", filename)
+    ("segments", segments.size())
+    ("entry", loader.getEntryPoint())
+    ("Loaded ELF file");
+}
+
+// Save the storage content. Only blocks with non-zero bytes are stored,
+// which keeps checkpoints of large, mostly empty memories small.
+void Memory::checkpoint_save(CheckpointArchive &ar) {
+  static const uint32_t block = 4096;
+  uint32_t size = get_size();
+  std::vector<uint32_t> offsets;
+  std::vector<uint8_t> data;
+  std::vector<uint8_t> buffer(block);
+
+  for (uint64_t offset = 0; offset < size; offset += block) {
+    uint32_t len = std::min<uint64_t>(block, size - offset);
+    read_block_dbg(offset, &buffer[0], len);
+    for (uint32_t i = 0; i < len; ++i) {
+      if (buffer[i]) {
+        offsets.push_back(offset);
+        data.insert(data.end(), buffer.begin(), buffer.begin() + len);
+        break;
+      }
+    }
+  }
+
+  ar.put("size", size);
+  ar.put("offsets", offsets.empty() ? NULL : &offsets[0], offsets.size() * sizeof(uint32_t));
+  ar.put("data", data.empty() ? NULL : &data[0], data.size());
+}
+
+// Restore the storage content saved by checkpoint_save
+void Memory::checkpoint_restore(const CheckpointArchive &ar) {
+  static const uint32_t block = 4096;
+  uint32_t size = get_size();
+  uint32_t saved_size = 0;
+
+  if (!ar.get("size", saved_size) || saved_size != size) {
+    srWarn()
+      ("size", size)
+      ("saved_size", saved_size)
+      ("Memory size differs from checkpoint, content not restored");
+    return;
+  }
+
+  std::vector<uint8_t> offsets;
+  std::vector<uint8_t> data;
+  if (!ar.get("offsets", offsets) || !ar.get("data", data)) {
+    return;
+  }
+
+  erase_dbg(0, size);
+  const uint32_t *offset = reinterpret_cast<const uint32_t *>(offsets.empty() ? NULL : &offsets[0]);
+  uint64_t pos = 0;
+  for (uint32_t i = 0; i < offsets.size() / sizeof(uint32_t); ++i) {
+    uint32_t len = std::min<uint64_t>(block, size - offset[i]);
+    if (pos + len > data.size()) {
+      break;
+    }
+    write_block_dbg(offset[i], &data[pos], len);
+    pos += len;
+  }
 }
 
 // Automatically called at start of simulation
@@ -204,10 +308,13 @@ unsigned int Memory::transport_dbg(tlm::tlm_generic_payload &gp) {
 
 bool Memory::get_direct_mem_ptr(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data) {
   // access to ROM adress space
+  uint32_t start = 0;
+  uint32_t end = 0;
+  uint8_t *ptr = m_storage->get_dmi_range(trans.get_address(), start, end);
   dmi_data.allow_read_write();
-  dmi_data.set_dmi_ptr(m_storage->get_dmi_ptr());
-  dmi_data.set_start_address(0);
-  dmi_data.set_end_address(get_bsize() * ((get_banks()<5)? get_banks() : 8));
+  dmi_data.set_dmi_ptr(ptr);
+  dmi_data.set_start_address(start);
+  dmi_data.set_end_address(end);
   dmi_data.set_read_latency(SC_ZERO_TIME);
   dmi_data.set_write_latency(SC_ZERO_TIME);
   return m_storage->allow_dmi_rw();
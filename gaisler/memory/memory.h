@@ -29,10 +29,11 @@
 #include "core/common/sr_report.h"
 #include "core/common/clkdevice.h"
 #include "gaisler/memory/ext_erase.h"
+#include "core/common/checkpoint.h"
 
 /// @brief This class models a generic memory. Depending on the configuration
 /// it can be used as ROM, IO, SRAM or SDRAM, in conjunction with the SoCRocket MCTRL.
-class Memory : public MemoryPower {
+class Memory : public MemoryPower, public Checkpointable {
   public:
     GC_HAS_CALLBACKS();
 
@@ -84,6 +85,17 @@ class Memory : public MemoryPower {
       return this->name();
     }
 
+    /// Loads the loadable segments of an ELF file into the storage.
+    /// Segment addresses are taken modulo the memory size,
+    /// like the memory relative addresses coming from the Mctrl.
+    void load_elf(const std::string &filename);
+
+    /// Saves all non-zero 4 kB blocks of the storage
+    void checkpoint_save(CheckpointArchive &ar);
+
+    /// Clears the storage and writes back the saved blocks
+    void checkpoint_restore(const CheckpointArchive &ar);
+
     sr_param<uint64_t> m_writes;
     sr_param<uint64_t> m_reads;
     sr_param<std::string> g_storage_type;
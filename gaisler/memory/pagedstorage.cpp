@@ -0,0 +1,161 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup memory
+/// @{
+/// @file pagedstorage.cpp
+/// source file defining the implementation of the pagedstorage model.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "gaisler/memory/pagedstorage.h"
+#include "core/common/sr_report.h"
+
+SR_HAS_MEMORYSTORAGE(PagedStorage);
+
+PagedStorage::PagedStorage(sc_core::sc_module_name mn) : Storage(mn),
+  g_page_size("page_size", 4096),
+  m_page_bits(12),
+  m_chunk_bits(20),
+  m_size(0) {
+}
+
+PagedStorage::~PagedStorage() {
+  for (size_t i = 0; i < m_chunks.size(); i++) {
+    free(m_chunks[i]);
+  }
+}
+
+void PagedStorage::set_size(const uint32_t &size) {
+  for (size_t i = 0; i < m_chunks.size(); i++) {
+    free(m_chunks[i]);
+  }
+
+  // Page size is rounded down to a power of two (at most 2 GB)
+  m_page_bits = 0;
+  while ((m_page_bits < 31) && ((2u << m_page_bits) <= g_page_size)) {
+    m_page_bits++;
+  }
+  if ((1u << m_page_bits) != g_page_size) {
+    srWarn()
+      ("page_size", g_page_size)
+      ("used", 1u << m_page_bits)
+      ("Page size is not a power of two");
+  }
+
+  // DMI is granted per chunk, so a large working set needs only a few regions
+  m_chunk_bits = std::max(m_page_bits, 20u);
+
+  m_size = size;
+  m_pages.assign((m_size + (1u << m_page_bits) - 1) >> m_page_bits, static_cast<uint8_t *>(NULL));
+  m_chunks.assign((m_size + (1ull << m_chunk_bits) - 1) >> m_chunk_bits, static_cast<uint8_t *>(NULL));
+  srDebug()
+    ("size", m_size)
+    ("page_size", 1u << m_page_bits)
+    ("pages", m_pages.size())
+    ("set_size");
+}
+
+uint64_t PagedStorage::get_size() const {
+  return m_size;
+}
+
+uint8_t *PagedStorage::chunk(const uint32_t &addr) {
+  uint8_t *&entry = m_chunks[addr >> m_chunk_bits];
+  if (!entry) {
+    // calloc leaves the zero pages to the host, they get backed on first write
+    uint64_t base = static_cast<uint64_t>(addr >> m_chunk_bits) << m_chunk_bits;
+    entry = static_cast<uint8_t *>(calloc(std::min(static_cast<uint64_t>(1) << m_chunk_bits, m_size - base), 1));
+    if (!entry) {
+      srError()
+        ("addr", addr)
+        ("Out of host memory");
+      throw std::bad_alloc();
+    }
+  }
+  return entry;
+}
+
+uint8_t *PagedStorage::page(const uint32_t &addr) {
+  uint8_t *&entry = m_pages[addr >> m_page_bits];
+  if (!entry) {
+    entry = chunk(addr) + (addr & ((1ull << m_chunk_bits) - 1) & ~((1u << m_page_bits) - 1));
+  }
+  return entry;
+}
+
+void PagedStorage::write(const uint32_t &addr, const uint8_t &byte) {
+  page(addr)[addr & ((1u << m_page_bits) - 1)] = byte;
+}
+
+uint8_t PagedStorage::read(const uint32_t &addr) const {
+  const uint8_t *entry = m_pages[addr >> m_page_bits];
+  if (entry) {
+    return entry[addr & ((1u << m_page_bits) - 1)];
+  }
+  return 0;
+}
+
+void PagedStorage::erase(const uint32_t &start, const uint32_t &end) {
+  // Pages are cleared, not freed, to keep handed out DMI pointers valid
+  uint32_t addr = start;
+  while (addr < end) {
+    uint32_t offset = addr & ((1u << m_page_bits) - 1);
+    uint32_t len = std::min((1u << m_page_bits) - offset, end - addr);
+    uint8_t *entry = m_pages[addr >> m_page_bits];
+    if (entry) {
+      memset(entry + offset, 0, len);
+    }
+    addr += len;
+  }
+}
+
+void PagedStorage::write_block(const uint32_t &addr, const uint8_t *ptr, const uint32_t &len) {
+  uint32_t done = 0;
+  while (done < len) {
+    uint32_t offset = (addr + done) & ((1u << m_page_bits) - 1);
+    uint32_t chunk = std::min((1u << m_page_bits) - offset, len - done);
+    memcpy(page(addr + done) + offset, ptr + done, chunk);
+    done += chunk;
+  }
+}
+
+void PagedStorage::read_block(const uint32_t &addr, uint8_t *ptr, const uint32_t &len) const {
+  uint32_t done = 0;
+  while (done < len) {
+    uint32_t offset = (addr + done) & ((1u << m_page_bits) - 1);
+    uint32_t chunk = std::min((1u << m_page_bits) - offset, len - done);
+    const uint8_t *entry = m_pages[(addr + done) >> m_page_bits];
+    if (entry) {
+      memcpy(ptr + done, entry + offset, chunk);
+    } else {
+      memset(ptr + done, 0, chunk);
+    }
+    done += chunk;
+  }
+}
+
+uint8_t *PagedStorage::get_dmi_range(const uint32_t &addr, uint32_t &start, uint32_t &end) {
+  // The whole chunk is handed out, so all of its pages have to be present
+  uint64_t base = static_cast<uint64_t>(addr >> m_chunk_bits) << m_chunk_bits;
+  uint64_t last = std::min(base + (static_cast<uint64_t>(1) << m_chunk_bits), m_size) - 1;
+  for (uint64_t a = base; a <= last; a += (1u << m_page_bits)) {
+    page(static_cast<uint32_t>(a));
+  }
+  start = static_cast<uint32_t>(base);
+  end = static_cast<uint32_t>(last);
+  return chunk(addr);
+}
+
+bool PagedStorage::allow_dmi_rw() {
+  return true;
+}
+/// @}
@@ -0,0 +1,75 @@
+// vim : set fileencoding=utf-8 expandtab noai ts=4 sw=4 :
+/// @addtogroup memory Memory
+/// @{
+/// @file pagedstorage.h
+/// Adressable storage implememtation based on a page table. Pages are
+/// allocated on first write. Supposed to be used by large, sparsely
+/// populated memories.
+///
+/// @date 2026
+/// @copyright All rights reserved.
+///            Any reproduction, use, distribution or disclosure of this
+///            program, without the express, prior written consent of the
+///            authors is strictly prohibited.
+/// @author agent
+///
+
+#ifndef MODELS_MEMORY_PAGEDSTORAGE_H_
+#define MODELS_MEMORY_PAGEDSTORAGE_H_
+
+#include <vector>
+
+#include "core/common/sr_param.h"
+#include "gaisler/memory/storage.h"
+
+class PagedStorage : public Storage {
+  public:
+    explicit PagedStorage(sc_core::sc_module_name mn);
+
+    ~PagedStorage();
+
+    void set_size(const uint32_t &size);
+
+    uint64_t get_size() const;
+
+    void write(const uint32_t &addr, const uint8_t &byte);
+
+    uint8_t read(const uint32_t &addr) const;
+
+    void write_block(const uint32_t &addr, const uint8_t *ptr, const uint32_t &len);
+
+    void read_block(const uint32_t &addr, uint8_t *ptr, const uint32_t &len) const;
+
+    void erase(const uint32_t &start, const uint32_t &end);
+
+    uint8_t *get_dmi_range(const uint32_t &addr, uint32_t &start, uint32_t &end);
+
+    bool allow_dmi_rw();
+  private:
+    /// Returns the page holding addr. The page is allocated if needed.
+    uint8_t *page(const uint32_t &addr);
+
+    /// Returns the chunk holding addr. The chunk is reserved if needed.
+    uint8_t *chunk(const uint32_t &addr);
+
+    /// Page size in bytes (power of two)
+    sr_param<uint32_t> g_page_size;
+
+    /// log2 of the page size
+    uint32_t m_page_bits;
+
+    /// log2 of the chunk size (at least 1 MB)
+    uint32_t m_chunk_bits;
+
+    /// Page table, NULL for pages never written
+    std::vector<uint8_t *> m_pages;
+
+    /// Host memory reserved per chunk, the pages are carved out of it.
+    /// Untouched parts are not backed by the host until they are written.
+    std::vector<uint8_t *> m_chunks;
+  protected:
+    uint64_t m_size;
+};
+
+#endif  // MODELS_MEMORY_PAGEDSTORAGE_H_
+/// @}
@@ -55,6 +55,14 @@ class Storage : public sc_core::sc_object {
 
     virtual uint8_t *get_dmi_ptr() { return NULL; }
 
+    /// Returns the DMI pointer to the block holding addr.
+    /// start and end are set to the storage addresses covered by the pointer.
+    virtual uint8_t *get_dmi_range(const uint32_t &addr, uint32_t &start, uint32_t &end) {
+      start = 0;
+      end = get_size() - 1;
+      return get_dmi_ptr();
+    }
+
     virtual bool allow_dmi_rw() { return false; }
 
   protected: